@@ -0,0 +1,13 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include "recursion.hpp"
+
+/*
+   Micro-benchmarks for the algorithms. Each one prints the best time of several repetitions and the throughput (operations per microsecond).
+   Build with optimizations (-O2/-O3, or Release in Visual Studio) for meaningful numbers.
+*/
+
+void bench_StackAlgorithms();   //!< fact_stack() and TOH_stack() with LinkedStack (one node per push) vs. DArrayStack (contiguous array).
+
+#endif
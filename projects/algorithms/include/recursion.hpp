@@ -14,12 +14,12 @@ using namespace dss;
 
 long fact_iteration(unsigned n);   //!< O(n). Factorial algorithm solved using iteration.
 long fact_recursive(unsigned n);   //!< O(n). Factorial algorithm solved using recursion.
-long fact_stack(unsigned n, LinkedStack<unsigned>& stack);   //!< O(n). Factorial algorithm solved using a stack.
+long fact_stack(unsigned n, Stack<unsigned>& stack);   //!< O(n). Factorial algorithm solved using a stack (any Stack implementation).
 
 class Pole;
 class TOHobj;
 void TOH_recursive(unsigned n, Pole& start, Pole& goal, Pole& temp);   //!< O(?). Towers of Hanoi algorithm solved using recursion.
-void TOH_stack(unsigned n, Pole& start, Pole& goal, Pole& temp, LinkedStack<TOHobj*>& stack);   //!< O(?). Towers of Hanoi algorithm solved using a stack.
+void TOH_stack(unsigned n, Pole& start, Pole& goal, Pole& temp, Stack<TOHobj*>& stack);   //!< O(?). Towers of Hanoi algorithm solved using a stack (any Stack implementation).
 
 void test_fact();   //!< Test for factorial algorithm.
 void test_TOH();   //!< Test for TOH algorithm.
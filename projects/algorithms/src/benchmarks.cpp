@@ -0,0 +1,72 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "benchmarks.hpp"
+
+
+// -- Helpers --------------------------------------
+
+volatile size_t benchSink;   // Results are written here so the compiler cannot discard the benchmarked work.
+
+/// Run a function several times and return the best time (milliseconds).
+template <typename F>
+double bestTime(F function, unsigned repetitions = 5)
+{
+    double best = 0;
+    for (unsigned i = 0; i < repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+
+    return best;
+}
+
+/// Print one benchmark result: name, time and throughput.
+void printResult(const std::string& name, size_t operations, double ms)
+{
+    std::cout << "    " << std::left << std::setw(40) << name << std::right
+        << std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms"
+        << std::setw(12) << std::setprecision(1) << (ms > 0 ? operations / (ms * 1000) : 0) << " ops/us" << std::endl;
+}
+
+/// Run fact_stack() "rounds" times with the same stack. Each round pushes and pops n - 1 values (n is kept small, so the result fits in a long).
+template <typename S>
+void benchFact(const std::string& name, unsigned n, size_t rounds)
+{
+    S stack;
+    printResult(name + " fact_stack", (n - 1) * rounds, bestTime([&]() {
+        long sum = 0;
+        for (size_t i = 0; i < rounds; i++) sum += fact_stack(n, stack);
+        benchSink = (size_t)sum;
+    }));
+}
+
+/// Solve the Towers of Hanoi with "disks" disks using TOH_stack(). Each move pushes and pops 3 tasks (2^disks - 1 moves).
+template <typename S>
+void benchTOH(const std::string& name, unsigned disks)
+{
+    S stack;
+    printResult(name + " TOH_stack", ((size_t(1) << disks) - 1) * 3, bestTime([&]() {
+        Pole start(disks), goal, temp;
+        TOH_stack(disks, start, goal, temp, stack);
+        benchSink = goal.length();
+    }));
+}
+
+
+// -- Benchmarks --------------------------------------
+
+void bench_StackAlgorithms()
+{
+    std::cout << __func__ << ":" << std::endl;
+
+    benchFact<LinkedStack<unsigned>>("LinkedStack", 12, 100000);
+    benchFact<DArrayStack<unsigned>>("DArrayStack", 12, 100000);
+    benchTOH<LinkedStack<TOHobj*>>("LinkedStack", 18);
+    benchTOH<DArrayStack<TOHobj*>>("DArrayStack", 18);
+}
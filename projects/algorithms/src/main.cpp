@@ -1,9 +1,15 @@
 #include <iostream>
+#include <string>
 
 #include "recursion.hpp"
+#include "benchmarks.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
+	bool benchmarks = false;   // Benchmarks take a while: run them only with --bench
+	for (int i = 1; i < argc; i++)
+		if (std::string(argv[i]) == "--bench") benchmarks = true;
+
 	try
 	{
 		std::cout << "Tests: Algorithms" << std::endl;
@@ -11,6 +17,12 @@ int main()
 		std::cout << "  - Recursion" << std::endl;
 		test_fact();
 		test_TOH();
+
+		if (benchmarks)
+		{
+			std::cout << "Benchmarks: Algorithms" << std::endl;
+			bench_StackAlgorithms();
+		}
 	}
 	catch (std::exception& e) {
 		std::cout << "\nError: " << e.what() << std::endl;
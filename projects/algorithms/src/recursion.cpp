@@ -26,7 +26,7 @@ long fact_recursive(unsigned n)
     return n * fact_recursive(n - 1);
 }
 
-long fact_stack(unsigned n, LinkedStack<unsigned>& stack)
+long fact_stack(unsigned n, Stack<unsigned>& stack)
 {
     while (n > 1) stack.push(n--);
     long result = 1;
@@ -81,7 +81,7 @@ TOHobj::TOHobj(unsigned n, Pole& start, Pole& goal, Pole& temp)
 TOHobj::TOHobj(Pole& start, Pole& goal)
     : operation(DOMOVE), count(), start(start), goal(goal), temp(goal) { }
 
-void TOH_stack(unsigned n, Pole& start, Pole& goal, Pole& temp, LinkedStack<TOHobj*>& stack)
+void TOH_stack(unsigned n, Pole& start, Pole& goal, Pole& temp, Stack<TOHobj*>& stack)
 {
     stack.push(new TOHobj(n, start, goal, temp));
     TOHobj* toh;
@@ -128,6 +128,10 @@ void test_fact()
     LinkedStack<unsigned> stack2;
     if (fact_stack(10, stack2) != 3628800) throw std::exception("Incorrect result");
 
+    std::cout << ++count << " " << std::flush;
+    DArrayStack<unsigned> stack3;
+    if (fact_stack(10, stack3) != 3628800) throw std::exception("Incorrect result");
+
     std::cout << std::endl;
 }
 
@@ -158,6 +162,12 @@ void test_TOH()
     TOH_stack(10, start4, goal4, temp4, stack4);
     verifyTOH(10, start4, temp4, goal4);
 
+    std::cout << ++count << " " << std::flush;
+    Pole start5(10), goal5, temp5;
+    DArrayStack<TOHobj*> stack5;
+    TOH_stack(10, start5, goal5, temp5, stack5);
+    verifyTOH(10, start5, temp5, goal5);
+
     std::cout << std::endl;
 }
 
@@ -0,0 +1,32 @@
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include "lists.hpp"
+
+/*
+   Micro-benchmarks for the data structures. Each one prints the best time of several repetitions and the throughput (operations per microsecond).
+   Build with optimizations (-O2/-O3, or Release in Visual Studio) for meaningful numbers.
+*/
+
+namespace dss
+{
+	void bench_DynamicArray();   //!< Append throughput: DynamicArray vs. the former growth path (default-construct + copy-assign) vs. std::vector.
+	void bench_GrowthPolicies();   //!< DynamicArray growth policies: time, reallocations, bytes copied and wasted capacity for appends and for a workload oscillating around a capacity boundary.
+	void bench_Iteration();   //!< Traversal of an array: virtual cursor API vs. contiguous iterators (range-for, <algorithm>).
+	void bench_Find();   //!< Linear search through the virtual List<T> interface vs. the statically dispatched find(L&) on the concrete (final) list types, and the vectorized search of arrays of a million int8_t/int/int64_t/double (cursor loop vs. std::find() vs. find()).
+	void bench_NodeAllocators();   //!< Linked containers with HeapAllocator (one new/delete per node, the former behaviour) vs. SlabArena: append/clear, traversal, push/pop, enqueue/dequeue (with and without freelist).
+	void bench_UnrolledList();   //!< UnrolledLinkedList (several node sizes) vs. SinglyLinkedList, DoubleLinkedList and XorLinkedList: append, traversal, and insert/remove at the middle.
+	void bench_SmallArray();   //!< Short-lived arrays (construct, append, copy, traverse, destroy): DynamicArray (heap only) vs. SmallArray (inline buffer for 16 elements) vs. std::vector.
+	void bench_PositionIndex();   //!< Linked lists with and without the positional index (indexable skip list): random operator[], moveToPos() and insert/remove, and the cost of keeping the index on append.
+	void bench_Moves();   //!< Move vs. copy: transfer of a container with a million ints (move constructor vs. copy constructor), and push/pop of long strings into stacks (push(T&&) vs. push(const T&)).
+	void bench_Relink();   //!< Linked lists rebuilt from sorted shards and split again: element by element (append) vs. relinking nodes (spliceAt(), mergeSorted(), splitAt()).
+	void bench_Queues();   //!< Queues with a steady backlog and with a burst of a million ints: SArrayQueue (fixed capacity, modulo) vs. DArrayQueue (growable, mask) vs. LinkedQueue vs. std::deque, and DArrayQueue batches (enqueueN()/dequeueN()).
+	void bench_SPSCQueue();   //!< A producer and a consumer thread: a million ints transferred through a mutex-guarded SArrayQueue vs. SPSCQueue (one by one, and in batches of 64), and round-trip latency through a pair of queues.
+	void bench_MPMCQueue();   //!< Worker pools of 1 to 64 threads, each one enqueuing and dequeuing ints on a shared queue (a million pairs in total): mutex-guarded SArrayQueue vs. MPMCQueue, to see how each one scales with the number of threads.
+	void bench_Dictionaries();   //!< Insert and find (present and absent keys) with 1k, 10k and 1M random int keys: StaticArrayDictionary and SoAArrayDictionary (linear search, only up to 10k) vs. SortedStaticArrayDictionary (binary search; bulk load and batched inserts) vs. FrozenDictionary (Eytzinger layout) vs. HashDictionary (Robin Hood hashing) vs. std::unordered_map.
+	void bench_DictionaryLayouts();   //!< Insert and find with 1k and 4k int keys and large elements (std::string, 60-byte record): StaticArrayDictionary (array of KVpairs) vs. SoAArrayDictionary (keys and elements in separate arrays).
+	void bench_ConcurrentReads();   //!< Lookups on one dictionary with 1M int keys from 1, 2, 4 and 8 threads: const HashDictionary and FrozenDictionary (no lock) vs. RWLockedDictionary (shared_mutex) vs. a plain mutex, with only reads and with 5% writes.
+	void bench_Sort();   //!< Sorting a million ints (random, sorted, reversed, many duplicates): DynamicArray::sort() and parallelSort() vs. std::sort(), and the linked lists' merge sort vs. std::list::sort().
+}
+
+#endif
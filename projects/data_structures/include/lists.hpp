@@ -4,30 +4,75 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <vector>
+#include <new>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <memory>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <string_view>
+#include <mutex>
+#include <shared_mutex>
+#include <map>
+
+#if defined(__AVX2__)
+	#define DSS_AVX2   // 256-bit vectors (compile with -mavx2 or /arch:AVX2)
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define DSS_SSE2   // 128-bit vectors (always available on x86-64)
+	#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
 
 namespace dss   // Data Structures namespace
 {
 	// Main declarations ----------------------------------------
 
 	template <typename T> class List;
+	template <typename T> class ArrayStorage;
 	template <typename T> class StaticArray;
 	template <typename K, typename E> class SortedStaticArray;
-	template <typename T> class DynamicArray;
-	template <typename T> class SinglyLinkedList;
-	template <typename T> class DoubleLinkedList;
-	template <typename T> class XorLinkedList;
+	class DoublingGrowth;
+	template <typename T, typename Growth = DoublingGrowth, size_t N = 0> class DynamicArray;
+	template <typename N> class SlabArena;
+	template <typename N> class HeapAllocator;
+	template <typename N, template <typename> class Alloc> class NodePool;
+	template <typename N> class PositionIndex;
+	template <typename T, template <typename> class Alloc = SlabArena> class SinglyLinkedList;
+	template <typename T, template <typename> class Alloc = SlabArena> class DoubleLinkedList;
+	template <typename T, template <typename> class Alloc = SlabArena> class XorLinkedList;
+	template <typename T, size_t N = 32> class UnrolledLinkedList;
 
 	template <typename T> class Stack;
 	template <typename T> class SArrayStack;
-	template <typename T> class LinkedStack;
+	template <typename T, typename Growth = DoublingGrowth> class DArrayStack;
+	template <typename T> class DoubleSArrayStack;
+	enum class Side { LEFT, RIGHT };   // Stacks of a DoubleSArrayStack
+	template <typename T, template <typename> class Alloc = SlabArena> class LinkedStack;
 
 	template <typename T> class Queue;
 	template <typename T> class SArrayQueue;
-	template <typename T> class LinkedQueue;
+	template <typename T> class DArrayQueue;
+	template <typename T, template <typename> class Alloc = SlabArena> class LinkedQueue;
+	template <typename T> class SPSCQueue;
+	template <typename T> class MPMCQueue;
 
 	template <typename K, typename E> class Dictionary;
 	template <typename K, typename E> class StaticArrayDictionary;
+	template <typename K, typename E> class SoAArrayDictionary;
+	template <typename K, typename E, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>> class HashDictionary;
 	template <typename K, typename E> class SortedStaticArrayDictionary;
+	template <typename K, typename E> class FrozenDictionary;
+	template <typename K, typename E, typename D = HashDictionary<K, E>> class RWLockedDictionary;
+	template <typename K, typename E> class KVpair;
 		
 	template <typename T>
 	size_t find(List<T>* list, const T& item);
@@ -35,20 +80,69 @@ namespace dss   // Data Structures namespace
 	template <typename T>
 	void printList(List<T>* list);
 
+	template <typename L>
+	size_t find(L& list, const typename L::value_type& item);
+
+	template <typename T>
+	size_t findContiguous(const T* first, size_t size, const T& item);
+
+	template <typename L>
+	void printList(L& list);
+
 	template <typename T>
 	void swap(T& a, T& b);
 
+	template <typename K, typename E>
+	void swap(KVpair<K,E>& a, KVpair<K,E>& b) noexcept;
+
+	inline size_t ceilPowerOfTwo(size_t n);
+
+	constexpr size_t cacheLineSize = 64;   // Bytes. Data written by different threads is kept in different cache lines (avoids false sharing).
+
+	template <typename L, typename Compare = std::less<typename L::value_type>>
+	void sort(L& list, Compare cmp = Compare());
+
+	template <typename T, typename Compare>
+	void insertionSort(T* first, T* last, Compare& cmp);
+
+	template <typename T, typename Compare>
+	void heapSort(T* first, T* last, Compare& cmp);
+
+	template <typename T, typename Compare>
+	void introsort(T* first, T* last, Compare& cmp);
+
+	template <typename T, typename Compare>
+	void parallelIntrosort(T* first, T* last, Compare& cmp, unsigned threads);
+
+	template <typename N, typename Compare, typename Next, typename SetNext>
+	N* mergeSortChain(N* first, Compare& cmp, Next next, SetNext setNext);
+
 	template<template<typename> class T> void test_List();
+	template<template<typename> class T> void test_DynamicArray();
+	template<template<typename> class T> void test_LinkedList();
 	template<template<typename, typename> class T> void test_SortedList();
 	template<template<typename> class T> void test_Stack();
+	template<template<typename> class T> void test_DArrayStack();
+	template<template<typename> class T> void test_LinkedStack();
+	template<template<typename> class T> void test_DoubleSArrayStack();
 	template<template<typename> class T> void test_Queue();
+	template<template<typename> class T> void test_DArrayQueue();
+	template<template<typename> class T> void test_LinkedQueue();
+	template<template<typename> class T> void test_SPSCQueue();
+	template<template<typename> class T> void test_MPMCQueue();
 	template<template<typename, typename> class T> void test_Dictionary();
+	template<template<typename, typename> class T> void test_HashDictionary();
+	template<template<typename, typename> class T> void test_SortedDictionary();
+	template<template<typename, typename> class T> void test_FrozenDictionary();
+	template<template<typename, typename> class T> void test_RWLockedDictionary();
 
 	template<typename T> using SA = StaticArray<T>;
 	template<typename T> using DA = DynamicArray<T>;
+	template<typename T, size_t N = 16, typename Growth = DoublingGrowth> using SmallArray = DynamicArray<T, Growth, N>;   // Dynamic array with inline storage for N elements
 	template<typename T> using SLL = SinglyLinkedList<T>;
 	template<typename T> using DLL = DoubleLinkedList<T>;
 	template<typename T> using XLL = XorLinkedList<T>;
+	template<typename T> using ULL = UnrolledLinkedList<T>;
 
 
 	// Classes ----------------------------------------
@@ -69,8 +163,14 @@ namespace dss   // Data Structures namespace
 
 		virtual	void clear() = 0;
 		virtual	void insert(const T& item) = 0;
+		virtual	void insert(T&& item) = 0;
 		virtual	void append(const T& item) = 0;
+		virtual	void append(T&& item) = 0;
 		virtual	T remove() = 0;
+		virtual	void insertRange(const T* first, const T* last) = 0;
+		virtual	void appendRange(const T* first, const T* last) = 0;
+		virtual	void removeRange(size_t pos, size_t count) = 0;
+		virtual	void assign(const T* first, const T* last) = 0;
 		
 		virtual	size_t length() const = 0;
 		virtual	size_t currPos() const = 0;
@@ -82,11 +182,24 @@ namespace dss   // Data Structures namespace
 		virtual	void prev() = 0;
 		virtual	void next() = 0;
 
+		virtual	void sort(const std::function<bool(const T&, const T&)>& cmp) = 0;
+
 		//virtual List& operator=(const List& obj) = 0;   // Copy-assignment (cannot be virtual)
 		virtual T& operator[](size_t i) const = 0;   // Subscript
 	};
 
-	/// Static array-based list class. It stores a dynamic number of elements (size) of type T in an internal array of static capacity (capacity).  
+	/// Raw arrays of T: uninitialized storage aligned for T, and destruction and relocation of the elements in it. Used by the array-based containers.
+	template <typename T>
+	class ArrayStorage
+	{
+	public:
+		static T* allocate(size_t capacity);   // Uninitialized storage
+		static void deallocate(T* storage);
+		static void destroy(T* first, T* last);   // O(n) if T has destructor
+		static void relocate(T* src, size_t count, T* dest);   // O(n). Move elements to uninitialized storage (memcpy if T is trivially copyable).
+	};
+
+	/// Static array-based list class. It stores a dynamic number of elements (size) of type T in an internal array of static capacity (capacity). The array is raw aligned storage: only the first "size" slots hold constructed elements.
 	template <typename T>
 	class StaticArray : public List<T>
 	{
@@ -97,51 +210,317 @@ namespace dss   // Data Structures namespace
 		size_t curr;   // Range: [0, n]
 
 		void copyFrom(const StaticArray& obj);   // O(n)
+		void takeArray(StaticArray& obj) noexcept;   // O(1), or O(n) if obj can't hand over its array
+		virtual void releaseStorage() noexcept;   // O(n) if T has destructor. Destroy the elements and free the array (derived classes may keep elements elsewhere)
+		virtual bool handsOverArray() const noexcept;   // Whether the array is heap memory that another StaticArray can take
+
+		void openGap(size_t pos, size_t count);   // O(n). Shift [pos, size) "count" slots to the right, leaving an uninitialized gap.
+		void closeGap(size_t pos, size_t count);   // O(n). Shift [pos + count, size) "count" slots to the left, filling an uninitialized gap.
+		void fillGap(size_t pos, const T* first, const T* last);   // O(k). Copy-construct [first, last) into the gap at pos, or close the gap if a copy throws.
+		bool overlaps(const T* first, const T* last) const;
 
 	public:
-		StaticArray(size_t capacity = 1);   // O(n) if T has constructor
+		typedef	T* iterator;   // Contiguous iterator: usable with <algorithm> and range-for without virtual calls.
+		typedef	const T* const_iterator;
+
+		StaticArray(size_t capacity = 1);
 		StaticArray(const std::initializer_list<T>& il);   // O(n)
 		StaticArray(const StaticArray& obj);   // O(n)
+		StaticArray(StaticArray&& obj) noexcept;
 		virtual ~StaticArray() override;   // O(n) if T has destructor
 
 		StaticArray& operator=(const StaticArray& obj);   // O(n)
+		StaticArray& operator=(StaticArray&& obj) noexcept;   // O(n) if T has destructor
 		T& operator[](size_t i) const override;
 
 		virtual void clear() override;
 		virtual void insert(const T& item) override;   // O(n)
+		virtual void insert(T&& item) override;   // O(n)
 		virtual void append(const T& item) override;
+		virtual void append(T&& item) override;
 		virtual T remove() override;   // O(n)
+		virtual void insertRange(const T* first, const T* last) override;   // O(n + k)
+		virtual void appendRange(const T* first, const T* last) override;   // O(k)
+		virtual void removeRange(size_t pos, size_t count) override;   // O(n)
+		virtual void assign(const T* first, const T* last) override;   // O(n + k)
+
+		size_t length() const override final;
+		size_t currPos() const override final;
+		const T& getValue() const override final;
+		size_t getCapacity() const;
+
+		T* data();
+		const T* data() const;
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
+		const_iterator cbegin() const;
+		const_iterator cend() const;
+
+		void moveToStart() override final;
+		void moveToEnd() override final;
+		void moveToPos(size_t pos) override final;
+		void prev() override final;
+		void next() override final;
+
+		template <typename Compare = std::less<T>> void sort(Compare cmp = Compare());   // O(n log n)
+		void sort(const std::function<bool(const T&, const T&)>& cmp) override;   // O(n log n)
+		template <typename Compare = std::less<T>> void parallelSort(Compare cmp = Compare(), unsigned threads = 0);   // O(n log n / threads) for large arrays
+	};
 
-		size_t length() const override;
-		size_t currPos() const override;
-		const T& getValue() const override;
+	/// Growth policy for DynamicArray: capacity is doubled each time the array gets full. Used by default.
+	class DoublingGrowth
+	{
+	public:
+		static size_t grow(size_t capacity, size_t) { return capacity ? capacity * 2 : 1; }
+	};
 
-		void moveToStart() override;
-		void moveToEnd() override;
-		void moveToPos(size_t pos) override;
-		void prev() override;
-		void next() override;
+	/// Growth policy for DynamicArray: capacity grows by a factor of 1.5. It wastes less memory than doubling (at most 1/3 of the array), and freed blocks can be reused by later growths.
+	class HalfGrowth
+	{
+	public:
+		static size_t grow(size_t capacity, size_t) { return capacity + capacity / 2 + 1; }
 	};
 
-	/// Dynamic array-based list class. It stores a dynamic number of elements (size) of type T in an internal array of dynamic capacity (capacity).  
-	template<typename T>
-	class DynamicArray : public StaticArray<T>
+	/// Growth policy for DynamicArray: doubling for small arrays, and growth by 1/8 rounded up to whole memory pages once the array exceeds "largeSize" bytes. Waste on large arrays is limited to 1/8 of the array plus one page, while growth remains geometric (amortized O(1) append).
+	class PageGrowth
+	{
+	public:
+		static const size_t pageSize = 4096;
+		static const size_t largeSize = 64 * 1024;
+
+		static size_t grow(size_t capacity, size_t elementSize)
+		{
+			if (capacity * elementSize < largeSize)
+				return capacity ? capacity * 2 : 1;
+
+			size_t bytes = (capacity + capacity / 8) * elementSize;
+			bytes = (bytes + pageSize - 1) / pageSize * pageSize;
+			return std::max(capacity + 1, bytes / elementSize);   // Elements bigger than a page may not fill the rounding: grow by one at least
+		}
+	};
+
+	/// Inline storage for N elements of type T (uninitialized). Used by DynamicArray for small buffer optimization. Empty if N == 0.
+	template <typename T, size_t N>
+	class InlineStorage
+	{
+		alignas(T) unsigned char buffer[N * sizeof(T)];
+
+	protected:
+		T* inlineData() { return reinterpret_cast<T*>(buffer); }
+		const T* inlineData() const { return reinterpret_cast<const T*>(buffer); }
+	};
+
+	template <typename T>
+	class InlineStorage<T, 0>
 	{
-		inline void increaseCapacity();   // O(n)
+	protected:
+		T* inlineData() { return nullptr; }
+		const T* inlineData() const { return nullptr; }
+	};
+
+	/// Dynamic array-based list class. It stores a dynamic number of elements (size) of type T in an internal array of dynamic capacity (capacity). The growth policy (Growth) decides the new capacity when the array gets full, and the shrink threshold decides when the array gets smaller. The first N elements are stored inside the object (small buffer optimization): the array only goes to the heap when it needs more capacity than that (N == 0: always in the heap).
+	template<typename T, typename Growth, size_t N>
+	class DynamicArray final : private InlineStorage<T, N>, public StaticArray<T>
+	{
+		using StaticArray<T>::array;
+		using StaticArray<T>::capacity;
+		using StaticArray<T>::size;
+		using StaticArray<T>::curr;
+		using StaticArray<T>::openGap;
+		using StaticArray<T>::fillGap;
+		using StaticArray<T>::overlaps;
+		using InlineStorage<T, N>::inlineData;
+
+		static const bool nothrowMove = N == 0 || std::is_nothrow_move_constructible<T>::value;   // Moving the array may need to relocate the inline buffer
+
+		float shrinkThreshold;   // Shrink when size <= capacity * shrinkThreshold (0: only when empty; negative: never).
+		size_t minCapacity;   // Capacity asked for in the constructor or reserve(). Automatic shrinking doesn't go below it (shrink_to_fit() resets it).
+		size_t reallocCount;   // Number of reallocations
+		size_t copiedBytes;   // Bytes relocated by reallocations
+
+		T* getStorage(size_t& newCapacity);   // Inline buffer if newCapacity <= N (then, newCapacity becomes N), or heap memory otherwise
+		void freeStorage(T* storage);   // Nothing to do for the inline buffer
+		void releaseStorage() noexcept override;   // O(n) if T has destructor. The inline buffer isn't freed (StaticArray assignments reach it through this)
+		bool handsOverArray() const noexcept override;   // False while the elements are in the inline buffer
+		void construct(const T* first, const T* last);   // O(n). Get storage and copy [first, last) into it (for constructors).
+		void moveFrom(DynamicArray& obj) noexcept(nothrowMove);   // O(1), or O(n) if obj uses the inline buffer
 		inline void decreaseCapacity();   // O(n)
+		void reallocate(size_t newCapacity);   // O(n)
+		template <typename... Args> T& emplaceAt(size_t pos, Args&&... args);   // O(n)
+		template <typename... Args> T& emplaceGrow(size_t pos, Args&&... args);   // O(n)
+		void insertAt(size_t pos, const T* first, const T* last);   // O(n + k)
 
 	public:
-		DynamicArray(size_t size = 0);   // O(n) if T has constructor
+		static const size_t inlineCapacity = N;   // Elements that fit in the inline buffer
+
+		DynamicArray(size_t size = 0);   // Reserve room for "size" elements
 		DynamicArray(const std::initializer_list<T>& il);   // O(n)
 		DynamicArray(const DynamicArray& obj);   // O(n)
+		DynamicArray(DynamicArray&& obj) noexcept(nothrowMove);   // O(1), or O(n) if obj uses the inline buffer
 		~DynamicArray() override;   // O(n) if T has destructor
 
 		DynamicArray& operator=(const DynamicArray& obj);   // O(n)
+		DynamicArray& operator=(DynamicArray&& obj) noexcept(nothrowMove);   // O(n) if T has destructor
 
 		void clear() override;   // O(n) if T has destructor
 		void insert(const T& item) override;   // O(n)
+		void insert(T&& item) override;   // O(n)
 		void append(const T& item) override;   // O(n)
+		void append(T&& item) override;   // O(n)
 		T remove() override;   // O(n)
+		void insertRange(const T* first, const T* last) override;   // O(n + k)
+		void appendRange(const T* first, const T* last) override;   // O(n + k)
+		void removeRange(size_t pos, size_t count) override;   // O(n)
+		void assign(const T* first, const T* last) override;   // O(n + k)
+
+		template <typename... Args> T& emplace(Args&&... args);   // O(n)
+		template <typename... Args> T& emplace_back(Args&&... args);   // O(n)
+		void reserve(size_t newCapacity);   // O(n). Capacity won't shrink below newCapacity, except with shrink_to_fit().
+		void shrink_to_fit();   // O(n)
+
+		void setShrinkThreshold(float threshold);
+		size_t reallocations() const;
+		size_t bytesCopied() const;
+		void resetCounters();
+	};
+
+	/// Node allocator for linked structures: slab arena. Nodes are carved out of contiguous chunks (so consecutive nodes tend to be neighbours in memory), freed slots are recycled, and all nodes are released at once with reset() (chunks are kept) or release() (chunks are returned to the system). Node constructors/destructors are not called by the allocator. Chunks can be shared with other arenas (share()), so nodes can be relinked from one structure to another without copying them.
+	template <typename N>
+	class SlabArena
+	{
+		union Slot
+		{
+			Slot* next;   // Next free slot (only while the slot is free)
+			alignas(N) unsigned char storage[sizeof(N)];
+		};
+
+		std::vector<std::pair<std::shared_ptr<Slot>, size_t>> chunks;   // Chunk (owned by all the arenas sharing it) and number of slots. Chunks after "current" are unused.
+		size_t current;   // Chunk in use
+		Slot* bump;   // Next never-used slot in the current chunk
+		Slot* bumpEnd;   // One-past-the-end of the current chunk
+		Slot* freeSlots;   // Recycled slots
+		size_t firstChunk;   // Slots in the first chunk. Next chunks double it, up to maxChunkBytes.
+		bool shared;   // Some chunks may be shared with other arenas
+
+		static const size_t maxChunkBytes = 65536;
+
+		void nextChunk();
+
+	public:
+		static const bool bulkRelease = true;   // reset() releases all nodes in O(chunks)
+
+		SlabArena(size_t firstChunk = 16);
+		SlabArena(const SlabArena& obj) = delete;
+		SlabArena(SlabArena&& obj) noexcept;
+		~SlabArena();
+
+		SlabArena& operator=(const SlabArena& obj) = delete;
+		SlabArena& operator=(SlabArena&& obj) noexcept;   // O(chunks)
+
+		N* allocate();   // O(1). Uninitialized storage for one node.
+		void deallocate(N* node);   // O(1)
+		void reset();   // O(1), or O(chunks) after share(). All slots become free. Chunks are kept for reuse (except shared ones).
+		void release();   // O(chunks). Return all chunks to the system.
+		void share(SlabArena& obj);   // O(chunks log chunks). Take shared ownership of the chunks used by obj.
+		size_t capacity() const;   // O(chunks). Number of slots in all chunks.
+	};
+
+	/// Node allocator for linked structures: each node is allocated and freed individually on the heap (new/delete). Kept as a baseline for SlabArena.
+	template <typename N>
+	class HeapAllocator
+	{
+	public:
+		static const bool bulkRelease = false;   // Each node must be deallocated
+
+		N* allocate() { return std::allocator<N>().allocate(1); }
+		void deallocate(N* node) { std::allocator<N>().deallocate(node, 1); }
+		void reset() { }
+		void release() { }
+		void share(HeapAllocator&) { }   // Nodes don't depend on the allocator, so nothing is shared
+		size_t capacity() const { return 0; }
+	};
+
+	/// Node pool: a node allocator (Alloc) plus a freelist that recycles the storage of destroyed nodes, up to a maximum number of nodes (cap). Storage beyond the cap is given back to the allocator. The cap only limits the pool's own freelist: with HeapAllocator that storage returns to the system, but SlabArena keeps it in its own free list (its chunks are returned only by release()), so retained memory is bounded by the peak number of nodes, not by the cap. It offers the same interface as the allocators.
+	template <typename N, template <typename> class Alloc>
+	class NodePool
+	{
+		struct FreeSlot { FreeSlot* next; };   // Created in the storage of a destroyed node
+
+		Alloc<N> allocator;
+		FreeSlot* freelist;   // Storage of destroyed nodes, ready for reuse
+		size_t freeCount;   // Nodes in the freelist
+		size_t freelistCap;   // Max. nodes in the freelist
+
+		static_assert(sizeof(N) >= sizeof(FreeSlot) && alignof(N) >= alignof(FreeSlot), "Node too small for the freelist");
+
+	public:
+		static const bool bulkRelease = Alloc<N>::bulkRelease;
+
+		NodePool(size_t freelistCap = 1024);
+		NodePool(const NodePool& obj) = delete;
+		NodePool(NodePool&& obj) noexcept;
+		~NodePool();   // O(n) if Alloc has no bulk release
+
+		NodePool& operator=(const NodePool& obj) = delete;
+		NodePool& operator=(NodePool&& obj) noexcept;   // O(n) if Alloc has no bulk release
+
+		N* allocate();
+		void deallocate(N* node);
+		void reset();   // All nodes become free (they must have been destroyed). The freelist is kept if Alloc has no bulk release.
+		void release();   // O(n) if Alloc has no bulk release. Give all storage back to the allocator, and the allocator's memory to the system.
+		void reserve(size_t count);   // O(count). Put nodes in the freelist until it has "count" nodes (the cap is ignored).
+		void shrink();   // O(n). Give the freelist back to the allocator.
+
+		void setFreelistCap(size_t cap);   // O(n) if the freelist has more nodes than the new cap. It doesn't limit the memory kept by Alloc
+		size_t getFreelistCap() const;
+		size_t freeNodes() const;
+	};
+
+	/// Positional index for linked lists: indexable skip list that maps each position to its node (N*). Each entry has a tower of links, and each link stores how many positions it skips (width), so the node in any position is found in O(log n) expected time.
+	template <typename N>
+	class PositionIndex
+	{
+		struct Entry;
+
+		struct Link
+		{
+			Entry* next;
+			size_t width;   // Positions skipped by this link. For the last link of a level, distance to the end.
+		};
+
+		struct Entry
+		{
+			N* node;
+			size_t height;
+			Link* links() { return reinterpret_cast<Link*>(this + 1); }   // The links are stored just after the entry
+		};
+
+		static const size_t maxHeight = 32;
+
+		Entry* header;   // Entry before position 0 (maxHeight links)
+		size_t height;   // Height of the tallest tower
+		size_t count;   // Number of entries
+		uint32_t seed;   // Random number generator state (xorshift)
+
+		static Entry* newEntry(N* node, size_t height);
+		static void deleteEntry(Entry* entry);
+		size_t randomHeight();   // Geometric distribution (p = 1/4)
+		Entry* predecessors(size_t pos, Entry** update, size_t* rank) const;   // O(log n). Entries before position "pos" in each level, and their ranks.
+
+	public:
+		PositionIndex();
+		PositionIndex(const PositionIndex& obj) = delete;
+		~PositionIndex();   // O(n)
+
+		PositionIndex& operator=(const PositionIndex& obj) = delete;
+
+		N* at(size_t pos) const;   // O(log n)
+		void insert(size_t pos, N* node);   // O(log n)
+		void erase(size_t pos);   // O(log n)
+		void clear();   // O(n)
+		size_t size() const;
 	};
 
 	/// Base class: Node. It stores the item (element) and the methods to retrieve it and modify it.
@@ -154,6 +533,7 @@ namespace dss   // Data Structures namespace
 
 		 Node();
 		 Node(T content);
+		 template <typename... Args> Node(std::in_place_t, Args&&... args);   // Construct the element in place
 		 Node(const Node& obj);
 		virtual ~Node();
 
@@ -169,6 +549,7 @@ namespace dss   // Data Structures namespace
 	public:
 		 SNode(const T &content, SNode *nextNode = nullptr);
 		 SNode(SNode* nextNode = nullptr);
+		 template <typename... Args> SNode(std::in_place_t, SNode* nextNode, Args&&... args);
 		 SNode(const SNode &obj);
 		 ~SNode();
 
@@ -186,6 +567,7 @@ namespace dss   // Data Structures namespace
 	public:
 		DNode(const T& content, DNode* prevNode = nullptr, DNode* nextNode = nullptr);
 		DNode(DNode* prevNode = nullptr, DNode* nextNode = nullptr);
+		template <typename... Args> DNode(std::in_place_t, DNode* prevNode, DNode* nextNode, Args&&... args);
 		DNode(const DNode& obj);
 		~DNode();
 		
@@ -208,6 +590,7 @@ namespace dss   // Data Structures namespace
 	public:
 		XorNode(const T& content, XorNode* prevNode = nullptr, XorNode* nextNode = nullptr);
 		XorNode(XorNode* prevNode = nullptr, XorNode* nextNode = nullptr);
+		template <typename... Args> XorNode(std::in_place_t, XorNode* prevNode, XorNode* nextNode, Args&&... args);
 		XorNode(const XorNode& obj);
 		~XorNode();
 
@@ -219,123 +602,279 @@ namespace dss   // Data Structures namespace
 		inline XorNode* prev(XorNode* next);
 	};
 
-	/// Singly linked list class that stores a set of linked nodes, each one containing some item of type T (content).
-	template <typename T>
-	class SinglyLinkedList : public List<T>
+	/// Singly linked list class that stores a set of linked nodes, each one containing some item of type T (content). Nodes are obtained from a node allocator (Alloc).
+	template <typename T, template <typename> class Alloc>
+	class SinglyLinkedList final : public List<T>
 	{
-		SNode<T>* head;   // Header node: Additional first node whose value is ignored.
+		SNode<T> header;   // Header node: Additional first node whose value is ignored. It's part of the list object, so moving a list doesn't allocate.
+		SNode<T>* head;   // Header node (&header)
 		SNode<T>* tail;   // Last node
 		SNode<T>* curr;   // Node preceding the current node. Used to select a node.
+		size_t pos;   // Position of the current node (kept up to date by every operation that moves curr)
 		size_t count;   // Number of nodes
-		SNode<T>* freelist;   // Object pool for unused nodes. Avoids calling "new SNode" too much.
+		Alloc<SNode<T>> allocator;   // Storage for all nodes, except header node
+		PositionIndex<SNode<T>>* index;   // Optional positional index (nullptr if disabled)
 
-		SNode<T>* newNode(const T& content, SNode<T>* nextNode);
+		template <typename... Args> SNode<T>* newNode(SNode<T>* nextNode, Args&&... args);
 		void deleteNode(SNode<T>* node);
+		void destroyNodes();   // O(n), or O(1) if T is trivially destructible and Alloc has bulk release
+		void indexNode(size_t pos, SNode<T>* node);   // O(log n). Add a new node to the index (if enabled). If it fails, the node is deleted.
 		void copyFrom(const SinglyLinkedList& obj);   // O(n)
+		void moveFrom(SinglyLinkedList& obj) noexcept;   // O(1)
+		void indexRange(size_t k);   // O(k log n). Add the k nodes after curr to the index (if enabled).
 
 	public:
 		SinglyLinkedList(size_t unusedArg = 0);
 		SinglyLinkedList(const std::initializer_list<T>& il);   // O(n)
 		SinglyLinkedList(const SinglyLinkedList& obj);   // O(n)
+		SinglyLinkedList(SinglyLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value);   // O(1)
 		~SinglyLinkedList() override;   // O(n)
 
 		SinglyLinkedList& operator=(const SinglyLinkedList& obj);   // O(n)
-		T& operator[](size_t i) const override;   // O(n)
+		SinglyLinkedList& operator=(SinglyLinkedList&& obj) noexcept;   // O(n) if T has destructor, otherwise O(1)
+		T& operator[](size_t i) const override;   // O(n), or O(log n) with index
 
 		void clear() override;
-		void insert(const T& content) override;
-		void append(const T& content) override;
-		T remove() override;
+		void insert(const T& content) override;   // O(1), or O(log n) with index
+		void insert(T&& content) override;   // O(1), or O(log n) with index
+		void append(const T& content) override;   // O(1), or O(log n) with index
+		void append(T&& content) override;   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace(Args&&... args);   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace_back(Args&&... args);   // O(1), or O(log n) with index
+		T remove() override;   // O(1), or O(log n) with index
+		void insertRange(const T* first, const T* last) override;   // O(k)
+		void appendRange(const T* first, const T* last) override;   // O(k)
+		void removeRange(size_t pos, size_t count) override;   // O(pos + k)
+		void assign(const T* first, const T* last) override;   // O(n + k)
 
 		size_t length() const override;
-		size_t currPos() const override;   // O(n)
+		size_t currPos() const override;
 		const T& getValue() const override;
 
 		void moveToStart() override;
 		void moveToEnd() override;
-		void moveToPos(size_t pos) override;   // O(n)
-		void prev() override;   // O(n)
+		void moveToPos(size_t pos) override;   // O(n), or O(log n) with index
+		void prev() override;   // O(n), or O(log n) with index
 		void next() override;
+
+		void spliceAt(size_t pos, SinglyLinkedList& obj);   // O(1) + moveToPos(), or O(k log n) with index
+		SinglyLinkedList splitAt(size_t pos);   // O(1) + moveToPos(), or O(k log n) with index
+		template <typename Compare = std::less<T>> void mergeSorted(SinglyLinkedList& obj, Compare cmp = Compare());   // O(n + k), or O((n + k) log (n + k)) with index
+		template <typename Compare = std::less<T>> void sort(Compare cmp = Compare());   // O(n log n)
+		void sort(const std::function<bool(const T&, const T&)>& cmp) override;   // O(n log n)
+
+		void enableIndex(bool enable);   // O(n log n) when enabled
+		bool indexed() const;
 	};
 
-	/// Double linked list class that stores a set of linked nodes, each one containing some item of type T (content).
-	template <typename T>
-	class DoubleLinkedList : public List<T>
+	/// Double linked list class that stores a set of linked nodes, each one containing some item of type T (content). Nodes are obtained from a node allocator (Alloc).
+	template <typename T, template <typename> class Alloc>
+	class DoubleLinkedList final : public List<T>
 	{
-		DNode<T>* head;   // Header node: Additional first node whose value is ignored.
-		DNode<T>* tail;   // Tailer node: Additional last node whose value is ignored.
+		DNode<T> header, trailer;   // Header and tailer nodes: Additional first and last nodes whose values are ignored. They are part of the list object, so moving a list doesn't allocate.
+		DNode<T>* head;   // Header node (&header)
+		DNode<T>* tail;   // Tailer node (&trailer)
 		DNode<T>* curr;   // Node preceding the current node. Used to select a node.
+		size_t pos;   // Position of the current node (kept up to date by every operation that moves curr)
 		size_t count;   // Number of nodes
-		DNode<T>* freelist;   // Object pool for unused nodes. Avoids calling "new SNode" too much.
+		Alloc<DNode<T>> allocator;   // Storage for all nodes, except header and tailer nodes
+		PositionIndex<DNode<T>>* index;   // Optional positional index (nullptr if disabled)
 
-		DNode<T>* newNode(const T& content, DNode<T>* prevNode, DNode<T>* nextNode);
+		template <typename... Args> DNode<T>* newNode(DNode<T>* prevNode, DNode<T>* nextNode, Args&&... args);
 		void deleteNode(DNode<T>* node);
+		void destroyNodes();   // O(n), or O(1) if T is trivially destructible and Alloc has bulk release
+		void indexNode(size_t pos, DNode<T>* node);   // O(log n). Add a new node to the index (if enabled). If it fails, the node is deleted.
 		void copyFrom(const DoubleLinkedList& obj);   // O(n)
+		void moveFrom(DoubleLinkedList& obj) noexcept;   // O(1)
+		void indexRange(size_t k);   // O(k log n). Add the k nodes after curr to the index (if enabled).
 
 	public:
 		DoubleLinkedList(size_t unusedArg = 0);
 		DoubleLinkedList(const std::initializer_list<T>& il);   // O(n)
 		DoubleLinkedList(const DoubleLinkedList& obj);   // O(n)
+		DoubleLinkedList(DoubleLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value);   // O(1)
 		~DoubleLinkedList() override;   // O(n)
 
 		DoubleLinkedList& operator=(const DoubleLinkedList& obj);   // O(n)
-		T& operator[](size_t i) const override;   // O(n)
+		DoubleLinkedList& operator=(DoubleLinkedList&& obj) noexcept;   // O(n) if T has destructor, otherwise O(1)
+		T& operator[](size_t i) const override;   // O(n), or O(log n) with index
 
 		void clear() override;
-		void insert(const T& content) override;
-		void append(const T& content) override;
-		T remove() override;
+		void insert(const T& content) override;   // O(1), or O(log n) with index
+		void insert(T&& content) override;   // O(1), or O(log n) with index
+		void append(const T& content) override;   // O(1), or O(log n) with index
+		void append(T&& content) override;   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace(Args&&... args);   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace_back(Args&&... args);   // O(1), or O(log n) with index
+		T remove() override;   // O(1), or O(log n) with index
+		void insertRange(const T* first, const T* last) override;   // O(k)
+		void appendRange(const T* first, const T* last) override;   // O(k)
+		void removeRange(size_t pos, size_t count) override;   // O(pos + k)
+		void assign(const T* first, const T* last) override;   // O(n + k)
 
 		size_t length() const override;
-		size_t currPos() const override;   // O(n)
+		size_t currPos() const override;
 		const T& getValue() const override; 
 
 		void moveToStart() override;
 		void moveToEnd() override;
-		void moveToPos(size_t pos) override;   // O(n)
+		void moveToPos(size_t pos) override;   // O(n), or O(log n) with index
 		void prev() override;
 		void next() override;
+
+		void spliceAt(size_t pos, DoubleLinkedList& obj);   // O(1) + moveToPos(), or O(k log n) with index
+		DoubleLinkedList splitAt(size_t pos);   // O(1) + moveToPos(), or O(k log n) with index
+		template <typename Compare = std::less<T>> void mergeSorted(DoubleLinkedList& obj, Compare cmp = Compare());   // O(n + k), or O((n + k) log (n + k)) with index
+		template <typename Compare = std::less<T>> void sort(Compare cmp = Compare());   // O(n log n)
+		void sort(const std::function<bool(const T&, const T&)>& cmp) override;   // O(n log n)
+
+		void enableIndex(bool enable);   // O(n log n) when enabled
+		bool indexed() const;
 	};
 
-	/// Double linked list class, but memory optimized (space/time tradeoff) since it uses DNodeXor nodes (only store one pointer).
-	template <typename T>
-	class XorLinkedList : public List<T>
+	/// Double linked list class, but memory optimized (space/time tradeoff) since it uses DNodeXor nodes (only store one pointer). Nodes are obtained from a node allocator (Alloc).
+	template <typename T, template <typename> class Alloc>
+	class XorLinkedList final : public List<T>
 	{
-		XorNode<T>* head;   // Header node: Additional first node whose value is ignored.
-		XorNode<T>* tail;   // Tailer node: Additional last node whose value is ignored.
+		XorNode<T> header, trailer;   // Header and tailer nodes: Additional first and last nodes whose values are ignored. They are part of the list object, so moving a list doesn't allocate.
+		XorNode<T>* head;   // Header node (&header)
+		XorNode<T>* tail;   // Tailer node (&trailer)
 		XorNode<T>* curr;   // Node preceding the current node. Used to select a node.
 		XorNode<T>* currPrev;   // Node preceding curr node (allows access curr.next in O(1) time).
+		size_t pos;   // Position of the current node (kept up to date by every operation that moves curr)
 		size_t count;   // Number of nodes
-		XorNode<T>* freelist;   // Object pool for unused nodes. Avoids calling "new SNode" too much.
+		Alloc<XorNode<T>> allocator;   // Storage for all nodes, except header and tailer nodes
+		PositionIndex<XorNode<T>>* index;   // Optional positional index (nullptr if disabled)
 
-		XorNode<T>* newNode(const T& content, XorNode<T>* prevNode, XorNode<T>* nextNode);
+		template <typename... Args> XorNode<T>* newNode(XorNode<T>* prevNode, XorNode<T>* nextNode, Args&&... args);
 		void deleteNode(XorNode<T>* node);
-		void deleteList(XorNode<T>* node, XorNode<T>* prevNode);   // O(n)
+		void destroyNodes();   // O(n), or O(1) if T is trivially destructible and Alloc has bulk release
+		void indexNode(size_t pos, XorNode<T>* node);   // O(log n). Add a new node to the index (if enabled). If it fails, the node is deleted.
 		void copyFrom(const XorLinkedList& obj);   // O(n)
+		void moveFrom(XorLinkedList& obj) noexcept;   // O(1)
+		void indexRange(size_t k);   // O(k log n). Add the k nodes after curr to the index (if enabled).
 
 	public:
 		XorLinkedList(size_t unusedArg = 0);
 		XorLinkedList(const std::initializer_list<T>& il);   // O(n)
 		XorLinkedList(const XorLinkedList& obj);   // O(n)
+		XorLinkedList(XorLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value);   // O(1)
 		~XorLinkedList() override;   // O(n)
 
 		XorLinkedList& operator=(const XorLinkedList& obj);   // O(n)
-		T& operator[](size_t i) const override;   // O(n)
+		XorLinkedList& operator=(XorLinkedList&& obj) noexcept;   // O(n) if T has destructor, otherwise O(1)
+		T& operator[](size_t i) const override;   // O(n), or O(log n) with index
 
 		void clear() override;
-		void insert(const T& content) override;
-		void append(const T& content) override;
-		T remove() override;
+		void insert(const T& content) override;   // O(1), or O(log n) with index
+		void insert(T&& content) override;   // O(1), or O(log n) with index
+		void append(const T& content) override;   // O(1), or O(log n) with index
+		void append(T&& content) override;   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace(Args&&... args);   // O(1), or O(log n) with index
+		template <typename... Args> T& emplace_back(Args&&... args);   // O(1), or O(log n) with index
+		T remove() override;   // O(1), or O(log n) with index
+		void insertRange(const T* first, const T* last) override;   // O(k)
+		void appendRange(const T* first, const T* last) override;   // O(k)
+		void removeRange(size_t pos, size_t count) override;   // O(pos + k)
+		void assign(const T* first, const T* last) override;   // O(n + k)
+
+		size_t length() const override;
+		size_t currPos() const override;
+		const T& getValue() const override;
+
+		void moveToStart() override;
+		void moveToEnd() override;
+		void moveToPos(size_t pos) override;   // O(n), or O(log n) with index
+		void prev() override;
+		void next() override;
+
+		void spliceAt(size_t pos, XorLinkedList& obj);   // O(1) + moveToPos(), or O(k log n) with index
+		XorLinkedList splitAt(size_t pos);   // O(1) + moveToPos(), or O(k log n) with index
+		template <typename Compare = std::less<T>> void mergeSorted(XorLinkedList& obj, Compare cmp = Compare());   // O(n + k), or O((n + k) log (n + k)) with index
+		template <typename Compare = std::less<T>> void sort(Compare cmp = Compare());   // O(n log n)
+		void sort(const std::function<bool(const T&, const T&)>& cmp) override;   // O(n log n)
+
+		void enableIndex(bool enable);   // O(n log n) when enabled
+		bool indexed() const;
+	};
+
+	/// Node type for an unrolled linked list. Contains up to N items of type T in a contiguous block (only the first "count" are constructed), and pointers to the previous and next nodes.
+	template <typename T, size_t N>
+	class UNode
+	{
+		alignas(T) unsigned char storage[N * sizeof(T)];
+
+	public:
+		UNode(UNode* prevNode = nullptr, UNode* nextNode = nullptr);
+		UNode(const UNode& obj) = delete;
+		~UNode();   // O(N) if T has destructor
+
+		UNode& operator=(const UNode& obj) = delete;
+
+		UNode* prev;
+		UNode* next;
+		size_t count;   // Number of items
+
+		T* elements();
+		const T* elements() const;
+	};
+
+	/// Unrolled linked list class. It stores a set of linked nodes, each one containing up to N items of type T in a contiguous block, which reduces the memory overhead per item and the cache misses when walking the list. Full nodes are split in two on insertion, and nodes less than half full are merged with the next one on removal.
+	template <typename T, size_t N>
+	class UnrolledLinkedList final : public List<T>
+	{
+		static_assert(N >= 2, "UnrolledLinkedList needs at least 2 items per node");
+
+		UNode<T, N>* head;   // First node. nullptr until the first item is stored; from then on, there is always at least one node.
+		UNode<T, N>* tail;   // Last node
+		UNode<T, N>* curr;   // Node containing the current item
+		size_t index;   // Index of the current item in curr (index == curr->count only at one-past-the-end)
+		size_t pos;   // Position of the current item in the list
+		size_t count;   // Number of items
+
+		void split(UNode<T, N>* node);   // O(N). Move the upper half of a node to a new node after it.
+		void merge(UNode<T, N>* node);   // O(N). Move all items of the next node into this one, and delete the next node.
+		void unlink(UNode<T, N>* node);   // Delete a node (not the only one).
+		void normalize();   // Move the cursor to the start of the next node if it's one-past-the-end of a non-tail node.
+		bool overlaps(const T* first, const T* last) const;   // O(n/N)
+		void copyFrom(const UnrolledLinkedList& obj);   // O(n)
+
+	public:
+		UnrolledLinkedList(size_t unusedArg = 0);
+		UnrolledLinkedList(const std::initializer_list<T>& il);   // O(n)
+		UnrolledLinkedList(const UnrolledLinkedList& obj);   // O(n)
+		UnrolledLinkedList(UnrolledLinkedList&& obj) noexcept;
+		~UnrolledLinkedList() override;   // O(n)
+
+		UnrolledLinkedList& operator=(const UnrolledLinkedList& obj);   // O(n)
+		UnrolledLinkedList& operator=(UnrolledLinkedList&& obj) noexcept;
+		T& operator[](size_t i) const override;   // O(n/N)
+
+		void clear() override;   // O(n) if T has destructor, otherwise O(n/N)
+		void insert(const T& item) override;   // O(N)
+		void insert(T&& item) override;   // O(N)
+		void append(const T& item) override;
+		void append(T&& item) override;
+		template <typename... Args> T& emplace(Args&&... args);   // O(N)
+		template <typename... Args> T& emplace_back(Args&&... args);
+		T remove() override;   // O(N)
+		void insertRange(const T* first, const T* last) override;   // O(k N)
+		void appendRange(const T* first, const T* last) override;   // O(k)
+		void removeRange(size_t pos, size_t count) override;   // O(pos/N + k N)
+		void assign(const T* first, const T* last) override;   // O(n + k)
 
 		size_t length() const override;
-		size_t currPos() const override;   // O(n)
+		size_t currPos() const override;
 		const T& getValue() const override;
 
 		void moveToStart() override;
 		void moveToEnd() override;
-		void moveToPos(size_t pos) override;   // O(n)
+		void moveToPos(size_t pos) override;   // O(n/N)
 		void prev() override;
 		void next() override;
+
+		template <typename Compare = std::less<T>> void sort(Compare cmp = Compare());   // O(n log n). Uses O(n) extra memory.
+		void sort(const std::function<bool(const T&, const T&)>& cmp) override;   // O(n log n). Uses O(n) extra memory.
 	};
 
 	/// Abstract class: Stack.
@@ -349,6 +888,7 @@ namespace dss   // Data Structures namespace
 
 		virtual void clear() = 0;
 		virtual void push(const T& newElement) = 0;
+		virtual void push(T&& newElement) = 0;
 		virtual T pop() = 0;
 		virtual const T& topValue() const = 0;
 		virtual size_t length() const = 0;
@@ -368,39 +908,151 @@ namespace dss   // Data Structures namespace
 	public:
 		SArrayStack(size_t size = 1);   // O(n) if T has constructor
 		SArrayStack(const SArrayStack& obj);   // O(n) if T has constructor
+		SArrayStack(SArrayStack&& obj) noexcept;
 		~SArrayStack() override;   // O(n) if T has destructor
 
 		SArrayStack& operator=(const SArrayStack& obj);
+		SArrayStack& operator=(SArrayStack&& obj) noexcept;   // O(n) if T has destructor
 
 		void clear() override;
 		void push(const T& newElement) override;
+		void push(T&& newElement) override;
+		template <typename... Args> T& emplace(Args&&... args);
 		T pop() override;
 		const T& topValue() const override;
 		size_t length() const override;
 	};
 
-	/// Linked stack.
+	/// Dynamic-array stack. Elements are stored contiguously (top at the end), so pushes are amortized O(1) and no node is allocated per element. Capacity grows according to a growth policy (Growth, see DynamicArray), and halves when the stack gets sparse (shrink threshold), but not below minCapacity, so small stacks that are filled and emptied repeatedly don't reallocate. The array is raw aligned storage: only the first "top" slots hold constructed elements.
+	template <typename T, typename Growth>
+	class DArrayStack : public Stack<T>
+	{
+	private:
+		T* array;
+		size_t capacity;
+		size_t top;   // Number of elements (array index of first free position)
+		float shrinkThreshold;   // Shrink when top <= capacity * shrinkThreshold (negative disables shrinking)
+		size_t reservedCapacity;   // Capacity asked for in the constructor or reserve(). Shrinking doesn't go below it (shrink_to_fit() resets it).
+
+		static const size_t minCapacity = 16;   // Capacity is not reduced below this, except by shrink_to_fit()
+
+		void reallocate(size_t newCapacity);   // O(n)
+		void shrink() noexcept;   // O(n). Best effort: the array is kept if the new one can't be allocated
+		template <typename... Args> T& emplaceGrow(Args&&... args);   // O(n)
+
+	public:
+		DArrayStack(size_t capacity = 0);   // Reserve room for "capacity" elements
+		DArrayStack(const DArrayStack& obj);   // O(n)
+		DArrayStack(DArrayStack&& obj) noexcept;
+		~DArrayStack() override;   // O(n) if T has destructor
+
+		DArrayStack& operator=(const DArrayStack& obj);   // O(n)
+		DArrayStack& operator=(DArrayStack&& obj) noexcept;   // O(n) if T has destructor
+
+		void clear() override;   // O(n) if T has destructor
+		void push(const T& newElement) override;   // O(1) amortized
+		void push(T&& newElement) override;   // O(1) amortized
+		template <typename... Args> T& emplace(Args&&... args);   // O(1) amortized
+		T pop() override;   // O(1) amortized
+		const T& topValue() const override;
+		size_t length() const override;
+
+		void pushN(const T* first, size_t count);   // O(k) amortized
+		size_t popN(T* dest, size_t count);   // O(k) amortized
+		void reserve(size_t newCapacity);   // O(n). Capacity won't shrink below newCapacity, except with shrink_to_fit().
+		void shrink_to_fit();   // O(n)
+		void setShrinkThreshold(float threshold);
+		size_t getCapacity() const;
+	};
+
+	/// Two stacks sharing one static array. The left stack grows from the start of the array and the right one from the end, both toward the middle, so a push fails only when the combined capacity is exhausted (a pair of stacks needs one buffer sized for their combined peak, instead of two buffers sized for their individual peaks). Each stack is used through the methods taking a Side, or as an independent Stack<T> through stack(Side). The array is raw aligned storage: only slots holding elements are constructed.
 	template <typename T>
+	class DoubleSArrayStack
+	{
+	public:
+		/// One of the two stacks, seen as a Stack<T>. It forwards to its owner (and is not copyable).
+		class End : public Stack<T>
+		{
+		private:
+			DoubleSArrayStack* owner;
+			Side side;
+
+		public:
+			End(DoubleSArrayStack* owner, Side side);
+			End(const End& obj) = delete;
+			End& operator=(const End& obj) = delete;
+
+			void clear() override;
+			void push(const T& newElement) override;
+			void push(T&& newElement) override;
+			T pop() override;
+			const T& topValue() const override;
+			size_t length() const override;
+		};
+
+	private:
+		T* array;
+		size_t capacity;   // Max. combined size (n)
+		size_t leftTop;   // Array index of the left stack's first free position. Range [0, rightTop]
+		size_t rightTop;   // Array index of the right stack's top element (n if empty). Range [leftTop, n]
+		End leftEnd, rightEnd;
+
+		void copyFrom(const DoubleSArrayStack& obj);   // O(n)
+
+	public:
+		DoubleSArrayStack(size_t size = 1);
+		DoubleSArrayStack(const DoubleSArrayStack& obj);   // O(n)
+		DoubleSArrayStack(DoubleSArrayStack&& obj) noexcept;
+		~DoubleSArrayStack();   // O(n) if T has destructor
+
+		DoubleSArrayStack& operator=(const DoubleSArrayStack& obj);   // O(n)
+		DoubleSArrayStack& operator=(DoubleSArrayStack&& obj) noexcept;   // O(n) if T has destructor
+
+		void clear();   // O(n) if T has destructor
+		void clear(Side side);   // O(n) if T has destructor
+		void push(Side side, const T& newElement);
+		void push(Side side, T&& newElement);
+		template <typename... Args> T& emplace(Side side, Args&&... args);
+		T pop(Side side);
+		const T& topValue(Side side) const;
+		size_t length(Side side) const;
+		size_t length() const;   // Combined length
+		size_t getCapacity() const;   // Combined capacity
+		Stack<T>& stack(Side side);
+	};
+
+	/// Linked stack. Nodes are obtained from a node allocator (Alloc).
+	template <typename T, template <typename> class Alloc>
 	class LinkedStack : public Stack<T>
 	{
 	private:
 		SNode<T>* top;   // Pointer to first element
 		size_t size;   // Number of elements
+		NodePool<SNode<T>, Alloc> allocator;   // Storage for all nodes, with a freelist of recycled nodes
 
 		void copyFrom(const LinkedStack& obj);
 
 	public:
 		LinkedStack(size_t unusedArg = 0);
 		LinkedStack(const LinkedStack& obj);   // O(n) if T has constructor
+		LinkedStack(LinkedStack&& obj) noexcept;
 		~LinkedStack() override;   // O(n) if T has destructor
 
 		LinkedStack& operator=(const LinkedStack& obj);
+		LinkedStack& operator=(LinkedStack&& obj) noexcept;   // O(n) if T has destructor
 
 		void clear() override;   // O(n)
 		void push(const T& newElement) override;
+		void push(T&& newElement) override;
+		template <typename... Args> T& emplace(Args&&... args);
 		T pop() override;
 		const T& topValue() const override;
 		size_t length() const override;
+
+		void reserve(size_t count);   // O(count)
+		void shrink();   // O(n)
+		void setFreelistCap(size_t cap);
+		size_t freeNodes() const;
 	};
 
 	/// Abstract class: Queue.
@@ -414,6 +1066,7 @@ namespace dss   // Data Structures namespace
 
 		virtual void clear() = 0;
 		virtual void enqueue(const T& newElement) = 0;
+		virtual void enqueue(T&& newElement) = 0;
 		virtual T dequeue() = 0;
 		virtual const T& frontValue() const = 0;
 		virtual size_t length() const = 0;
@@ -436,40 +1089,189 @@ namespace dss   // Data Structures namespace
 		public:
 			SArrayQueue(size_t size = 1);
 			SArrayQueue(const SArrayQueue& obj);   // O(n) if T has constructor
+			SArrayQueue(SArrayQueue&& obj) noexcept;
 			~SArrayQueue() override;   // O(n) if T has destructor
 
 			SArrayQueue& operator=(const SArrayQueue& obj);
+			SArrayQueue& operator=(SArrayQueue&& obj) noexcept;   // O(n) if T has destructor
 			
 			void clear() override;
 			void enqueue(const T& newElement) override;
+			void enqueue(T&& newElement) override;
+			template <typename... Args> T& emplace(Args&&... args);
 			T dequeue() override;
 			const T& frontValue() const override;
 			size_t length() const override;
 	};
 
-	/// Linked queue.
+	/// Dynamic-array queue (growable ring buffer). Capacity is a power of two, so positions wrap with a mask instead of a modulo, and every slot is usable. When it gets full, capacity doubles and the elements are moved once, unwrapped, to the start of the new buffer. When it gets 1/4 full, capacity halves, so memory stays proportional to the length after a burst. The buffer is raw aligned storage: only the "size" slots after front hold constructed elements.
 	template <typename T>
+	class DArrayQueue : public Queue<T>
+	{
+		T* array;
+		size_t capacity;   // 0 or a power of two
+		size_t front;   // Position of the front element. Range: [0, capacity)
+		size_t size;   // Number of elements
+		size_t reservedCapacity;   // Capacity asked for in the constructor or reserve() (a power of two, or 0). It isn't halved below it (shrink_to_fit() resets it).
+
+		static const size_t minCapacity = 16;   // Capacity is not halved below this
+
+		size_t mask() const;   // capacity - 1
+		void reallocate(size_t newCapacity);   // O(n). Move the elements to the start of a new buffer.
+		void unwrap(T* dest);   // O(n). Relocate the elements to dest (front goes to dest[0]).
+		void shrink() noexcept;   // O(n). Halve capacity if the queue is 1/4 full. Best effort: the buffer is kept if the new one can't be allocated
+		template <typename... Args> T& emplaceGrow(Args&&... args);   // O(n)
+
+	public:
+		DArrayQueue(size_t capacity = 0);   // Capacity is rounded up to a power of two
+		DArrayQueue(const DArrayQueue& obj);   // O(n)
+		DArrayQueue(DArrayQueue&& obj) noexcept;
+		~DArrayQueue() override;   // O(n) if T has destructor
+
+		DArrayQueue& operator=(const DArrayQueue& obj);   // O(n)
+		DArrayQueue& operator=(DArrayQueue&& obj) noexcept;   // O(n) if T has destructor
+
+		void clear() override;   // O(n) if T has destructor
+		void enqueue(const T& newElement) override;   // O(1) amortized
+		void enqueue(T&& newElement) override;   // O(1) amortized
+		template <typename... Args> T& emplace(Args&&... args);   // O(1) amortized
+		T dequeue() override;   // O(1) amortized
+		const T& frontValue() const override;
+		size_t length() const override;
+
+		void enqueueN(const T* first, size_t count);   // O(k) amortized
+		size_t dequeueN(T* dest, size_t count);   // O(k) amortized
+		void reserve(size_t newCapacity);   // O(n). Capacity won't be halved below newCapacity, except with shrink_to_fit().
+		void shrink_to_fit();   // O(n)
+		size_t getCapacity() const;
+	};
+
+	/// Linked queue. Nodes are obtained from a node allocator (Alloc).
+	template <typename T, template <typename> class Alloc>
 	class LinkedQueue : public Queue<T>
 	{
 	private:
-		SNode<T>* front;
-		SNode<T>* rear;
+		SNode<T> header;   // Header node: Additional first node whose value is ignored. It's part of the queue object, so moving a queue doesn't allocate.
+		SNode<T>* front;   // Header node (&header)
+		SNode<T>* rear;   // Last node
 		size_t size;
+		NodePool<SNode<T>, Alloc> allocator;   // Storage for all nodes (except header node), with a freelist of recycled nodes
 
 		void copyFrom(const LinkedQueue& obj);
+		void moveFrom(LinkedQueue& obj) noexcept;
 
 	public:
 		LinkedQueue(size_t unusedArg = 0);
 		LinkedQueue(const LinkedQueue& obj);   // O(n) if T has constructor
+		LinkedQueue(LinkedQueue&& obj) noexcept(std::is_nothrow_default_constructible<T>::value);
 		~LinkedQueue() override;   // O(n) if T has destructor
 
 		LinkedQueue& operator=(const LinkedQueue& obj);
+		LinkedQueue& operator=(LinkedQueue&& obj) noexcept;   // O(n) if T has destructor
 
 		void clear();   // O(n)
 		void enqueue(const T& newElement);
+		void enqueue(T&& newElement);
+		template <typename... Args> T& emplace(Args&&... args);
 		T dequeue();
 		const T& frontValue() const;
 		virtual size_t length() const;
+
+		void reserve(size_t count);   // O(count)
+		void shrink();   // O(n)
+		void setFreelistCap(size_t cap);
+		size_t freeNodes() const;
+	};
+
+	/// Lock-free single-producer/single-consumer bounded queue (ring buffer). One thread may enqueue while another one dequeues, without locks: the producer only writes "tail" and the consumer only writes "head" (acquire/release atomics), and each index is in its own cache line, together with the thread's cached copy of the other index (so the other cache line is read only when the queue looks full or empty). Capacity is fixed (a power of two). Slots are raw aligned storage: only slots holding elements are constructed. It isn't a Queue<T> (frontValue() and clear() can't be made safe while the other thread works). Not copyable.
+	template <typename T>
+	class SPSCQueue
+	{
+		T* array;
+		size_t capacity;   // Power of two
+		size_t mask;   // capacity - 1
+
+		alignas(cacheLineSize) std::atomic<size_t> head;   // Number of elements dequeued (written by the consumer). Front slot: head & mask
+		size_t cachedTail;   // Consumer's copy of tail
+
+		alignas(cacheLineSize) std::atomic<size_t> tail;   // Number of elements enqueued (written by the producer). First free slot: tail & mask
+		size_t cachedHead;   // Producer's copy of head
+
+		char padding[cacheLineSize - sizeof(size_t) - sizeof(std::atomic<size_t>)];   // Nothing else shares the producer's cache line
+
+		size_t freeSlots(size_t t, size_t wanted);   // Producer
+		size_t usedSlots(size_t h, size_t wanted);   // Consumer
+
+	public:
+		SPSCQueue(size_t capacity = 1024);   // Capacity is rounded up to a power of two
+		SPSCQueue(const SPSCQueue& obj) = delete;
+		SPSCQueue& operator=(const SPSCQueue& obj) = delete;
+		~SPSCQueue();   // O(n) if T has destructor
+
+		// Producer thread
+		bool try_enqueue(const T& newElement);
+		bool try_enqueue(T&& newElement);
+		template <typename... Args> bool try_emplace(Args&&... args);
+		void enqueue(const T& newElement);   // Waits while full
+		void enqueue(T&& newElement);   // Waits while full
+		size_t enqueueN(const T* first, size_t count);   // O(k). Doesn't wait.
+
+		// Consumer thread
+		bool try_dequeue(T& dest);
+		T dequeue();   // Waits while empty
+		size_t dequeueN(T* dest, size_t count);   // O(k). Doesn't wait.
+
+		// Any thread
+		size_t length() const;   // Approximate if the other thread is working
+		bool empty() const;
+		size_t getCapacity() const;
+	};
+
+	/// Lock-free multi-producer/multi-consumer bounded queue (D. Vyukov's array queue). Any number of threads may enqueue and dequeue at once. Each cell has a sequence number that tells whether it's free for the enqueue at position "pos" (sequence == pos) or holds the element for the dequeue at "pos" (sequence == pos + 1). Threads claim positions with a CAS on enqueuePos/dequeuePos (each in its own cache line), and publish the cell by updating its sequence (release). Capacity is fixed (a power of two, at least 2). T's move constructor must not throw: once a position is claimed, the cell must be filled (elements whose construction may throw are built before claiming).
+	template <typename T>
+	class MPMCQueue : public Queue<T>
+	{
+		static_assert(std::is_nothrow_move_constructible<T>::value, "MPMCQueue requires a noexcept move constructor");
+
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			T* item() { return reinterpret_cast<T*>(storage); }
+		};
+
+		Cell* cells;
+		size_t capacity;   // Power of two
+		size_t mask;   // capacity - 1
+
+		alignas(cacheLineSize) std::atomic<size_t> enqueuePos;   // Next position to enqueue
+		alignas(cacheLineSize) std::atomic<size_t> dequeuePos;   // Next position to dequeue
+		char padding[cacheLineSize - sizeof(std::atomic<size_t>)];
+
+		Cell* claimEnqueue();   // Claim the cell of the next enqueue (nullptr if full)
+		Cell* claimDequeue(size_t& pos);   // Claim the cell of the next dequeue (nullptr if empty)
+		void release(Cell* cell, size_t pos);   // Free the cell after dequeuing position pos
+
+	public:
+		MPMCQueue(size_t capacity = 1024);   // Capacity is rounded up to a power of two
+		MPMCQueue(const MPMCQueue& obj) = delete;
+		MPMCQueue& operator=(const MPMCQueue& obj) = delete;
+		~MPMCQueue() override;   // O(n) if T has destructor
+
+		bool try_enqueue(const T& newElement);
+		bool try_enqueue(T&& newElement);
+		template <typename... Args> bool try_emplace(Args&&... args);
+		bool try_dequeue(T& dest);
+
+		void clear() override;   // O(n). Dequeues (and discards) until the queue looks empty.
+		void enqueue(const T& newElement) override;   // Waits while full
+		void enqueue(T&& newElement) override;   // Waits while full
+		T dequeue() override;   // Waits while empty
+		const T& frontValue() const override;   // Not supported (throws std::logic_error)
+		size_t length() const override;   // Approximate while other threads work
+		bool empty() const;
+		size_t getCapacity() const;
 	};
 	
 	// <<< should k be passed as reference?
@@ -490,7 +1292,8 @@ namespace dss   // Data Structures namespace
 		virtual E remove(const K& k) = 0;
 		virtual E removeAny() = 0;
 		virtual const E* find(const K& k) const = 0;
-		virtual int length() = 0;
+		virtual int length() const = 0;
+		virtual void forEach(const std::function<void(const K&, const E&)>& visit) const = 0;   // Visit every pair (in no particular order)
 	};
 
 	/// Key-value pair container.
@@ -501,8 +1304,10 @@ namespace dss   // Data Structures namespace
 		KVpair();
 		KVpair(K key, E element);
 		KVpair(const KVpair& obj);
+		KVpair(KVpair&& obj) = default;
 
 		KVpair<K,E>& operator=(const KVpair& obj);
+		KVpair<K,E>& operator=(KVpair&& obj) = default;
 
 		K key;
 		E element;
@@ -513,53 +1318,164 @@ namespace dss   // Data Structures namespace
 	class StaticArrayDictionary : public Dictionary<K, E>
 	{
 	private:
-		StaticArray<KVpair<K,E>>* list;
+		StaticArray<KVpair<K,E>> list;
+
+		size_t indexOf(const K& k) const;   // O(n). Position of a key (length() if not found). Doesn't use the list cursor.
 
 	public:
 		StaticArrayDictionary(int size = 1);
 		StaticArrayDictionary(const StaticArrayDictionary& obj);
+		StaticArrayDictionary(StaticArrayDictionary&& obj) noexcept;
 		~StaticArrayDictionary();
 
 		StaticArrayDictionary& operator=(const StaticArrayDictionary& obj);
-		E& operator[](K k) const override;
+		StaticArrayDictionary& operator=(StaticArrayDictionary&& obj) noexcept;
+		E& operator[](K k) const override;   // O(n)
 
 		void clear();
 		void insert(const K& k, const E& e);
 		E remove(const K& k);
 		E removeAny();
-		const E* find(const K& k) const;
-		int length();
+		const E* find(const K& k) const;   // O(n)
+		int length() const;
+		void forEach(const std::function<void(const K&, const E&)>& visit) const override;   // O(n)
 	};
 
-	/// Sorted static array for key-value pairs. It inherits from protected StaticArray, so we can hide insert and append, redefine insert, and expose all remaining methods.
+	/// Unsorted array dictionary with structure-of-arrays layout: keys in one array, and elements in a parallel array (same position). A search only scans key bytes (a StaticArrayDictionary scans whole KVpairs, so large elements waste most of each cache line), and integer or floating-point keys are compared with SIMD (findContiguous()). Lookups don't use the list cursors, so concurrent readers are safe. Same behavior as StaticArrayDictionary (insertion order, removeAny() removes the last pair).
 	template <typename K, typename E>
-	class SortedStaticArray : protected StaticArray<KVpair<K,E>>
+	class SoAArrayDictionary : public Dictionary<K, E>
 	{
+	private:
+		StaticArray<K> keys;
+		StaticArray<E> elements;   // elements[i] belongs to keys[i]
+
+		size_t indexOf(const K& k) const;   // O(n). Position of a key (length() if not found)
+
 	public:
-		SortedStaticArray(size_t capacity = 1);
-		SortedStaticArray(const std::initializer_list<KVpair<K,E>>& il);
-		SortedStaticArray(const SortedStaticArray& obj);
-		~SortedStaticArray() override;
+		SoAArrayDictionary(int size = 1);
+		SoAArrayDictionary(const SoAArrayDictionary& obj);   // O(n)
+		SoAArrayDictionary(SoAArrayDictionary&& obj) noexcept;
+		~SoAArrayDictionary() override;   // O(n) if K or E have destructor
+
+		SoAArrayDictionary& operator=(const SoAArrayDictionary& obj);   // O(n)
+		SoAArrayDictionary& operator=(SoAArrayDictionary&& obj) noexcept;
+		E& operator[](K k) const override;   // O(n)
+
+		void clear() override;   // O(n) if K or E have destructor
+		void insert(const K& k, const E& e) override;   // O(n)
+		E remove(const K& k) override;   // O(n)
+		E removeAny() override;
+		const E* find(const K& k) const override;   // O(n)
+		int length() const override;
+		void forEach(const std::function<void(const K&, const E&)>& visit) const override;   // O(n). In insertion order
+	};
+
+	/// Hash table dictionary (open addressing, Robin Hood hashing). Pairs are stored in one array; a parallel array holds each slot's probe distance (1 + distance from the key's home slot; 0 = empty). On insertion, a key that is farther from its home takes the slot of a key that is closer to its own, so probe sequences stay short and a lookup stops as soon as it finds a key closer to home than the one searched. Removal shifts the following keys back one slot (no tombstones). The table doubles when the number of keys exceeds capacity * maxLoadFactor. Hash values are mixed (Fibonacci hashing), so identity hashes (std::hash<int>) don't cluster. If Hash and Eq define is_transparent, find() and contains() accept any key type they support (e.g., const char* or std::string_view for std::string keys).
+	template <typename K, typename E, typename Hash, typename Eq>
+	class HashDictionary : public Dictionary<K, E>
+	{
+	private:
+		KVpair<K,E>* slots;   // Raw storage: only slots with distance != 0 hold a pair
+		uint16_t* distances;   // Probe distance + 1 of each slot (0 = empty)
+		size_t capacity;   // 0 or a power of two
+		size_t size;
+		unsigned shift;   // 64 - log2(capacity). Home slot = mixed hash >> shift
+		float maxLoadFactor;
+		Hash hasher;
+		Eq equal;
+
+		static const size_t minCapacity = 8;
+		static const size_t npos = (size_t)-1;
+		static const uint16_t maxDistance = UINT16_MAX - 1;   // Larger distances would overflow (probe counters included)
+
+		template <typename Q> size_t home(const Q& key, unsigned shift) const;   // Home slot of a key in a table with that shift
+		template <typename Q> size_t findIndex(const Q& key) const;   // Slot of a key (npos if not found)
+		void insertNew(KVpair<K,E>&& pair);   // Insert a key that isn't in the table (there must be room). Throws std::length_error before changing the table if a distance would exceed maxDistance
+		void removeAt(size_t index);   // Destroy the pair at index and shift the next ones back
+		void rehash(size_t newCapacity);   // O(capacity + newCapacity). Move the pairs to a new table. Strong guarantee
+		void destroyAll();   // O(capacity)
+		void copyFrom(const HashDictionary& obj);   // O(capacity)
 
-		SortedStaticArray& operator=(const SortedStaticArray& obj);
-		E& operator[](size_t i) const override;
+	public:
+		HashDictionary(int size = 0);   // Reserve room for "size" keys
+		HashDictionary(const HashDictionary& obj);   // O(capacity)
+		HashDictionary(HashDictionary&& obj) noexcept;
+		~HashDictionary() override;   // O(capacity)
+
+		HashDictionary& operator=(const HashDictionary& obj);   // O(capacity)
+		HashDictionary& operator=(HashDictionary&& obj) noexcept;
+		E& operator[](K k) const override;   // O(1) expected
+
+		void clear() override;   // O(capacity)
+		void insert(const K& k, const E& e) override;   // O(1) amortized expected. Throws std::length_error if a probe sequence would get too long (degenerate hash)
+		E remove(const K& k) override;   // O(1) expected
+		E removeAny() override;   // O(capacity) worst case
+		const E* find(const K& k) const override;   // O(1) expected
+		template <typename Q, typename H = Hash, typename EqQ = Eq, typename = typename H::is_transparent, typename = typename EqQ::is_transparent>
+		const E* find(const Q& key) const;   // Heterogeneous lookup. O(1) expected
+		template <typename Q>
+		bool contains(const Q& key) const;   // O(1) expected
+		int length() const override;
+		void forEach(const std::function<void(const K&, const E&)>& visit) const override;   // O(capacity)
+
+		void reserve(size_t count);   // O(n). Make room for "count" keys without rehashing
+		void setMaxLoadFactor(float loadFactor);   // O(n) if it makes the table rehash
+		float getMaxLoadFactor() const;
+		size_t getCapacity() const;
+	};
 
-		void insert(KVpair<K,E>& it);   // Redefined
+	/// Sorted static array for key-value pairs (ascending keys; pairs with equal keys keep their insertion order). It inherits from protected StaticArray, so we can hide insert and append (they could break the order), redefine insert, and expose all remaining methods. Searches are branchless binary searches over the contiguous array: no virtual calls, no cursor moves, and no unpredictable branches.
+	template <typename K, typename E>
+	class SortedStaticArray : protected StaticArray<KVpair<K,E>>
+	{
+		friend class SortedStaticArrayDictionary<K, E>;
+		friend class FrozenDictionary<K, E>;   // Moves the sorted pairs out
 
-		StaticArray<KVpair<K,E>>::clear;
-		//StaticArray<KVpair<K,E>>::insert;   // Made inaccessible
-		//StaticArray<KVpair<K,E>>::append;   // Made inaccessible
-		StaticArray<KVpair<K,E>>::remove;
+	public:
+		typedef const KVpair<K,E>* const_iterator;
 
-		StaticArray<KVpair<K,E>>::length;
-		StaticArray<KVpair<K,E>>::currPos;
-		StaticArray<KVpair<K,E>>::getValue;
-		
-		StaticArray<KVpair<K,E>>::moveToStart;
-		StaticArray<KVpair<K,E>>::moveToEnd;
-		StaticArray<KVpair<K,E>>::moveToPos;
-		StaticArray<KVpair<K,E>>::prev;
-		StaticArray<KVpair<K,E>>::next;
+		SortedStaticArray(size_t capacity = 1);
+		SortedStaticArray(const std::initializer_list<KVpair<K,E>>& il);   // O(n log n)
+		SortedStaticArray(const KVpair<K,E>* first, const KVpair<K,E>* last, size_t capacity = 0);   // O(n log n). Bulk load, then sort once.
+		SortedStaticArray(const SortedStaticArray& obj);   // O(n)
+		SortedStaticArray(SortedStaticArray&& obj) noexcept;
+		~SortedStaticArray() override;   // O(n) if K or E have destructor
+
+		SortedStaticArray& operator=(const SortedStaticArray& obj);   // O(n)
+		SortedStaticArray& operator=(SortedStaticArray&& obj) noexcept;   // O(n) if K or E have destructor
+		const KVpair<K,E>& at(size_t i) const;
+
+		void insert(const KVpair<K,E>& item) override;   // O(n). Redefined: inserts in order.
+		void insert(KVpair<K,E>&& item) override;   // O(n)
+		void insertRange(const KVpair<K,E>* first, const KVpair<K,E>* last);   // O(n + k log k). Sort the batch and merge it in one pass.
+		size_t removeDuplicateKeys();   // O(n)
+
+		size_t lower_bound(const K& k) const;   // O(log n)
+		size_t upper_bound(const K& k) const;   // O(log n)
+		size_t find(const K& k) const;   // O(log n)
+		std::pair<size_t, size_t> range(const K& low, const K& high) const;   // O(log n)
+
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		static bool keyLess(const KVpair<K,E>& a, const KVpair<K,E>& b);
+
+		using StaticArray<KVpair<K,E>>::clear;
+		//using StaticArray<KVpair<K,E>>::insert;   // Made inaccessible
+		//using StaticArray<KVpair<K,E>>::append;   // Made inaccessible
+		using StaticArray<KVpair<K,E>>::remove;
+		using StaticArray<KVpair<K,E>>::removeRange;
+
+		using StaticArray<KVpair<K,E>>::length;
+		using StaticArray<KVpair<K,E>>::currPos;
+		using StaticArray<KVpair<K,E>>::getValue;
+		using StaticArray<KVpair<K,E>>::getCapacity;
+
+		using StaticArray<KVpair<K,E>>::moveToStart;
+		using StaticArray<KVpair<K,E>>::moveToEnd;
+		using StaticArray<KVpair<K,E>>::moveToPos;
+		using StaticArray<KVpair<K,E>>::prev;
+		using StaticArray<KVpair<K,E>>::next;
 	};
 
 	/// Abstract class: Comparator. Used for comparing keys.
@@ -587,51 +1503,224 @@ namespace dss   // Data Structures namespace
 		static bool gt(char* x, char* y) { return strcmp(x, y) >  0; }
 	};
 
-	/// Sorted static array dictionary.
+	/// Sorted static array dictionary. Pairs are kept sorted by key in a contiguous array (SortedStaticArray), so lookups are branchless binary searches and ordered/range queries are cheap. Single insertions and removals shift the array (O(n)); build it with the bulk-load constructor (one sort) and add batches with insertRange() (one merge). Suited to read-mostly data.
 	template <typename K, typename E>
-	class SortedStaticArrayDictionary : public Dictionary<K, E> {
+	class SortedStaticArrayDictionary : public Dictionary<K, E>
+	{
 	private:
-		SortedStaticArray<K, E>* list;
+		SortedStaticArray<K, E> list;
+
+		E* findElement(const K& k) const;
+
 	public:
+		typedef const KVpair<K,E>* const_iterator;
+
 		SortedStaticArrayDictionary(int size = 1);
-		SortedStaticArrayDictionary(const SortedStaticArrayDictionary& obj);
+		SortedStaticArrayDictionary(const KVpair<K,E>* first, const KVpair<K,E>* last, int size = 0);   // O(n log n). Bulk load. For repeated keys, the last pair wins.
+		SortedStaticArrayDictionary(const SortedStaticArrayDictionary& obj);   // O(n)
+		SortedStaticArrayDictionary(SortedStaticArrayDictionary&& obj) noexcept;
 		~SortedStaticArrayDictionary();
 
-		SortedStaticArrayDictionary& operator=(const SortedStaticArrayDictionary& obj);
-		E& operator[](size_t i) const override;
+		SortedStaticArrayDictionary& operator=(const SortedStaticArrayDictionary& obj);   // O(n)
+		SortedStaticArrayDictionary& operator=(SortedStaticArrayDictionary&& obj) noexcept;
+		E& operator[](K k) const override;   // O(log n)
 
-		void clear();
-		void insert(const K& k, const E& e);
-		E remove(const K& k);
-		E removeAny();
-		E find(const K& k) const;
-		int size();
+		void clear() override;
+		void insert(const K& k, const E& e) override;   // O(n)
+		void insertRange(const KVpair<K,E>* first, const KVpair<K,E>* last);   // O(n + k log n). For repeated keys, the last pair wins.
+		E remove(const K& k) override;   // O(n)
+		E removeAny() override;   // O(1). Removes the largest key.
+		const E* find(const K& k) const override;   // O(log n)
+		int length() const override;
+		void forEach(const std::function<void(const K&, const E&)>& visit) const override;   // O(n). In key order
+
+		const_iterator lower_bound(const K& k) const;   // O(log n)
+		const_iterator upper_bound(const K& k) const;   // O(log n)
+		std::pair<const_iterator, const_iterator> range(const K& low, const K& high) const;   // O(log n). Pairs with keys in [low, high]
+		const_iterator begin() const;
+		const_iterator end() const;
+	};
+
+	/// Frozen (read-only) dictionary, for data that is built once and queried many times. Pairs are stored in Eytzinger order: the sorted pairs laid out as a complete binary search tree in breadth-first order (the root is at 1, and the children of node i are at 2i and 2i+1). A search walks down from the root with one branchless comparison per level. The top levels are contiguous, so they stay in cache, and the nodes a few levels below the current one are contiguous too (for 8-byte pairs, the 8 descendants 3 levels below share one cache line), so they are prefetched while the search goes on. In a sorted array, the last levels of every binary search are cache misses that can't be anticipated. The element is next to the key, so finding it costs no extra miss. Iteration (in key order) moves from each node to its in-order successor. Keys cannot be inserted or removed (those methods throw std::logic_error), but elements can be modified through operator[]. Best for large dictionaries (bigger than the caches): for small ones, a sorted array is as fast or faster.
+	template <typename K, typename E>
+	class FrozenDictionary : public Dictionary<K, E>
+	{
+	private:
+		KVpair<K,E>* pairs;   // Raw storage. Eytzinger order, 1-based (slot 0 unused). Cache line aligned
+		size_t size;
+
+		static const size_t prefetchStride = (cacheLineSize / sizeof(KVpair<K,E>) > 2 ? cacheLineSize / sizeof(KVpair<K,E>) : 2);   // The descendants of node i that are log2(prefetchStride) levels below start at i * prefetchStride
+
+		void build(SortedStaticArray<K, E>& sorted);   // O(n). Move the sorted pairs into Eytzinger order
+		size_t assignRanks(std::vector<size_t>& ranks, size_t rank, size_t node) const;   // O(n). In-order traversal of the tree, taking the sorted positions in order
+		void copyFrom(const FrozenDictionary& obj);   // O(n)
+		void destroyAll();   // O(n) if K or E have destructor
+		size_t lowerBoundNode(const K& k) const;   // O(log n). Node of the first key not less than k (0 if none)
+		size_t upperBoundNode(const K& k) const;   // O(log n). Node of the first key greater than k (0 if none)
+
+		static KVpair<K,E>* allocate(size_t count);
+		static void deallocate(KVpair<K,E>* storage);
+
+	public:
+		/// Forward iterator over the pairs in key order (read only).
+		class const_iterator
+		{
+			const KVpair<K,E>* pairs;
+			size_t size;
+			size_t node;   // 0 = end
+
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef KVpair<K,E> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const KVpair<K,E>* pointer;
+			typedef const KVpair<K,E>& reference;
+
+			const_iterator(const KVpair<K,E>* pairs = nullptr, size_t size = 0, size_t node = 0) : pairs(pairs), size(size), node(node) { }
+
+			reference operator*() const { return pairs[node]; }
+			pointer operator->() const { return pairs + node; }
+			const_iterator& operator++();   // O(log n), O(1) amortized
+			const_iterator operator++(int) { const_iterator temp = *this; ++*this; return temp; }
+			bool operator==(const const_iterator& other) const { return node == other.node; }
+			bool operator!=(const const_iterator& other) const { return node != other.node; }
+		};
+
+		FrozenDictionary();
+		FrozenDictionary(const Dictionary<K, E>& dict);   // O(n log n). Copy the pairs of any dictionary.
+		FrozenDictionary(const KVpair<K,E>* first, const KVpair<K,E>* last);   // O(n log n). For repeated keys, the last pair wins.
+		FrozenDictionary(const FrozenDictionary& obj);   // O(n)
+		FrozenDictionary(FrozenDictionary&& obj) noexcept;
+		~FrozenDictionary() override;   // O(n) if K or E have destructor
+
+		FrozenDictionary& operator=(const FrozenDictionary& obj);   // O(n)
+		FrozenDictionary& operator=(FrozenDictionary&& obj) noexcept;
+		E& operator[](K k) const override;   // O(log n)
+
+		void clear() override;   // O(n) if K or E have destructor
+		void insert(const K& k, const E& e) override;   // Throws std::logic_error
+		E remove(const K& k) override;   // Throws std::logic_error
+		E removeAny() override;   // Throws std::logic_error
+		const E* find(const K& k) const override;   // O(log n)
+		int length() const override;
+		void forEach(const std::function<void(const K&, const E&)>& visit) const override;   // O(n). In key order
+
+		const_iterator lower_bound(const K& k) const;   // O(log n)
+		const_iterator upper_bound(const K& k) const;   // O(log n)
+		std::pair<const_iterator, const_iterator> range(const K& low, const K& high) const;   // O(log n). Pairs with keys in [low, high]
+		const_iterator begin() const;   // O(log n)
+		const_iterator end() const;
+	};
+
+
+
+	/// Dictionary of type D shared by several threads, protected by a reader/writer lock (std::shared_mutex). Any number of readers (get(), contains(), read()) run at the same time, while writers (insert(), remove()...) wait for them and run alone. Since a pointer or reference to an element could be invalidated by a writer as soon as the lock is released, this class doesn't implement Dictionary<K,E> (find() and operator[] can't be offered safely): get() copies the element, and read() passes it to a function while the lock is held. For read-only data shared by threads, no lock is needed: all dictionaries in this file have const lookups that don't modify anything.
+	template <typename K, typename E, typename D>
+	class RWLockedDictionary
+	{
+	private:
+		D dict;
+		mutable std::shared_mutex mutex;
+
+	public:
+		template <typename... Args>
+		RWLockedDictionary(Args&&... args);   // Arguments for the constructor of D
+		RWLockedDictionary(const RWLockedDictionary& obj) = delete;
+		RWLockedDictionary& operator=(const RWLockedDictionary& obj) = delete;
+
+		bool get(const K& k, E& e) const;   // Shared lock. Copy the element of a key (returns false if the key isn't in the dictionary)
+		bool contains(const K& k) const;   // Shared lock
+		template <typename F>
+		bool read(const K& k, F&& visit) const;   // Shared lock. Call visit(const E&) (returns false if the key isn't in the dictionary)
+		int length() const;   // Shared lock
+
+		void clear();   // Exclusive lock
+		void insert(const K& k, const E& e);   // Exclusive lock
+		E remove(const K& k);   // Exclusive lock
+		E removeAny();   // Exclusive lock
+
+		template <typename F>
+		auto withReadLock(F&& f) const;   // Shared lock. Call f(const D&), e.g., for several lookups or an iteration
+		template <typename F>
+		auto withWriteLock(F&& f);   // Exclusive lock. Call f(D&), e.g., for a batch of insertions
 	};
 
 
 
 	// Definitions ----------------------------------------
 
-	// -- StaticArray --------------------------------------
+	// -- ArrayStorage --------------------------------------
 
-	/// Constructor. Allocate memory for a number of elements.
+	/// Get uninitialized memory for a number of elements, aligned for T.
 	template <typename T>
-	StaticArray<T>::StaticArray(size_t capacity)
-		: List(), capacity(capacity), size(0), curr(0)
+	T* ArrayStorage<T>::allocate(size_t capacity)
 	{
-		array = new T[capacity];
+		if (!capacity) return nullptr;
+
+		if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+
+		return static_cast<T*>(::operator new(capacity * sizeof(T)));
 	}
 
-	/// Constructor. Allocate memory for the elements in the initializer list and copy them into our list.
+	/// Release memory obtained from allocate(). Elements must have been destroyed already.
 	template <typename T>
-	StaticArray<T>::StaticArray(const std::initializer_list<T>& il)
-		: capacity(il.size()), size(il.size()), curr(0)
+	void ArrayStorage<T>::deallocate(T* storage)
 	{
-		array = new T[il.size()];
+		if (!storage) return;
 
-		const T* item = il.begin();
-		for (size_t i = 0; i < il.size(); i++)
-			array[i] = item[i];
+		if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			::operator delete(storage, std::align_val_t(alignof(T)));
+		else
+			::operator delete(storage);
+	}
+
+	/// Call the destructor of the elements in [first, last).
+	template <typename T>
+	void ArrayStorage<T>::destroy(T* first, T* last)
+	{
+		if (!std::is_trivially_destructible<T>::value)
+			for (; first != last; ++first)
+				first->~T();
+	}
+
+	/// Move-construct "count" elements into uninitialized storage (dest) and destroy the originals (src). Trivially copyable types are just memcpy'ed.
+	template <typename T>
+	void ArrayStorage<T>::relocate(T* src, size_t count, T* dest)
+	{
+		if (std::is_trivially_copyable<T>::value)
+		{
+			if (count) std::memcpy((void*)dest, (const void*)src, count * sizeof(T));
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			new (dest + i) T(std::move(src[i]));
+			src[i].~T();
+		}
+	}
+
+
+	// -- StaticArray --------------------------------------
+
+	/// Constructor. Allocate memory for a number of elements (no element is constructed).
+	template <typename T>
+	StaticArray<T>::StaticArray(size_t capacity)
+		: List(), capacity(capacity), size(0), curr(0)
+	{
+		array = ArrayStorage<T>::allocate(capacity);
+	}
+
+	/// Constructor. Allocate memory for the elements in the initializer list and copy them into our list.
+	template <typename T>
+	StaticArray<T>::StaticArray(const std::initializer_list<T>& il)
+		: capacity(il.size()), size(0), curr(0)
+	{
+		array = ArrayStorage<T>::allocate(il.size());
+
+		for (const T& item : il)
+			new (array + size++) T(item);
 	}
 
 	/// Copy constructor.
@@ -641,19 +1730,40 @@ namespace dss   // Data Structures namespace
 		copyFrom(obj);
 	}
 
-	/// Destructor. Delete the memory allocated by the constructor for this list. 
+	/// Move constructor. The array of obj is taken (see takeArray()), and obj is left empty.
+	template <typename T>
+	StaticArray<T>::StaticArray(StaticArray&& obj) noexcept
+		: array(nullptr), capacity(0), size(0), curr(0)
+	{
+		takeArray(obj);
+	}
+
+	/// Destructor. Destroy the active elements and delete the memory allocated by the constructor for this list. 
 	template <typename T>
-	StaticArray<T>::~StaticArray() { delete[] array; }
+	StaticArray<T>::~StaticArray()
+	{
+		ArrayStorage<T>::destroy(array, array + size);
+		ArrayStorage<T>::deallocate(array);
+	}
 
-	/// Copy-assignment operator overloading.
+	/// Copy-assignment operator overloading. The copy is made first, so a throwing copy leaves the list unchanged.
 	template <typename T>
 	StaticArray<T>& StaticArray<T>::operator=(const StaticArray& obj)
 	{
 		if (this == &obj) return *this;
 
-		if (array) delete[] array;
-		
-		copyFrom(obj);
+		StaticArray temp(obj);
+		return *this = std::move(temp);
+	}
+
+	/// Move-assignment operator overloading. Our elements are destroyed and our storage released (through releaseStorage(), so derived arrays free their own storage), and the array of obj is taken (see takeArray()).
+	template <typename T>
+	StaticArray<T>& StaticArray<T>::operator=(StaticArray&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		releaseStorage();
+		takeArray(obj);
 
 		return *this;
 	}
@@ -668,22 +1778,123 @@ namespace dss   // Data Structures namespace
 		return array[i];
 	}
 
-	/// Make the object a copy of another.
+	/// Make the object a copy of another. If a copy throws, the elements copied so far are destroyed and the array is released before rethrowing.
 	template <typename T>
 	void StaticArray<T>::copyFrom(const StaticArray& obj)
 	{
 		capacity = obj.capacity;
-		size = obj.size;
+		size = 0;
 		curr = obj.curr;
 		
-		array = new T[capacity];
-		for (size_t i = 0; i < size; i++)
-			array[i] = obj.array[i];
+		array = ArrayStorage<T>::allocate(capacity);
+		if (std::is_trivially_copyable<T>::value)
+		{
+			if (obj.size) std::memcpy((void*)array, (const void*)obj.array, obj.size * sizeof(T));
+			size = obj.size;
+		}
+		else
+		{
+			try
+			{
+				for (; size < obj.size; size++)
+					new (array + size) T(obj.array[size]);
+			}
+			catch (...)
+			{
+				ArrayStorage<T>::destroy(array, array + size);
+				ArrayStorage<T>::deallocate(array);
+				throw;
+			}
+		}
+	}
+
+	/// Take the elements of obj (we must have no storage). Its array is taken as is if obj can hand it over; otherwise (e.g., the inline buffer of a SmallArray), the elements are relocated to a new heap array of their size (a failed allocation terminates, since moves are noexcept). obj is left empty.
+	template <typename T>
+	void StaticArray<T>::takeArray(StaticArray& obj) noexcept
+	{
+		if (obj.handsOverArray())
+		{
+			array = obj.array;
+			capacity = obj.capacity;
+			obj.array = nullptr;
+			obj.capacity = 0;
+		}
+		else
+		{
+			array = ArrayStorage<T>::allocate(obj.size);
+			ArrayStorage<T>::relocate(obj.array, obj.size, array);
+			capacity = obj.size;
+		}
+
+		size = obj.size;
+		curr = obj.curr;
+		obj.size = obj.curr = 0;
+	}
+
+	/// Destroy the elements and free the array. The list is left empty, with no storage (capacity 0).
+	template <typename T>
+	void StaticArray<T>::releaseStorage() noexcept
+	{
+		ArrayStorage<T>::destroy(array, array + size);
+		ArrayStorage<T>::deallocate(array);
+
+		array = nullptr;
+		capacity = size = curr = 0;
+	}
+
+	/// The array is heap memory from ArrayStorage<T>::allocate(), so other StaticArrays can take it.
+	template <typename T>
+	bool StaticArray<T>::handsOverArray() const noexcept { return true; }
+
+	/// Shift the elements in [pos, size) "count" slots to the right (size is not modified). Afterwards, slots [pos, pos + count) are uninitialized. Capacity must be large enough.
+	template <typename T>
+	void StaticArray<T>::openGap(size_t pos, size_t count)
+	{
+		if (!count || pos == size) return;
+
+		if (std::is_trivially_copyable<T>::value)
+		{
+			std::memmove((void*)(array + pos + count), (const void*)(array + pos), (size - pos) * sizeof(T));
+			return;
+		}
+
+		for (size_t i = size; i-- > pos; )
+		{
+			if (i + count >= size) new (array + i + count) T(std::move(array[i]));
+			else array[i + count] = std::move(array[i]);
+		}
+
+		ArrayStorage<T>::destroy(array + pos, array + (pos + count < size ? pos + count : size));
+	}
+
+	/// Shift the elements in [pos + count, size) "count" slots to the left (size is not modified). Slots [pos, pos + count) must be uninitialized. Afterwards, slots [size - count, size) are uninitialized.
+	template <typename T>
+	void StaticArray<T>::closeGap(size_t pos, size_t count)
+	{
+		if (!count || pos + count == size) return;
+
+		if (std::is_trivially_copyable<T>::value)
+		{
+			std::memmove((void*)(array + pos), (const void*)(array + pos + count), (size - pos - count) * sizeof(T));
+			return;
+		}
+
+		for (size_t i = pos + count; i < size; i++)
+		{
+			if (i - count < pos + count) new (array + i - count) T(std::move(array[i]));
+			else array[i - count] = std::move(array[i]);
+		}
+
+		ArrayStorage<T>::destroy(array + (size - count > pos + count ? size - count : pos + count), array + size);
 	}
 
-	/// Set size to 0 (capacity remains the same).
+	/// Destroy all elements and set size to 0 (capacity remains the same).
 	template <typename T>
-	void StaticArray<T>::clear() { size = curr = 0; }
+	void StaticArray<T>::clear()
+	{
+		ArrayStorage<T>::destroy(array, array + size);
+		size = curr = 0;
+	}
 
 	/// Store a new element in the list just before the current position.
 	template <typename T>
@@ -692,10 +1903,15 @@ namespace dss   // Data Structures namespace
 		if (size == capacity)
 			throw std::out_of_range("List capacity exceeded");
 
-		for (size_t i = size; i > curr; i--)
-			array[i] = array[i - 1];
+		if (curr == size)
+			new (array + curr) T(item);
+		else
+		{
+			T temp(item);   // item may be an element of this list
+			openGap(curr, 1);
+			new (array + curr) T(std::move(temp));
+		}
 
-		array[curr] = item;
 		size++;
 	}
 
@@ -706,25 +1922,143 @@ namespace dss   // Data Structures namespace
 		if (size == capacity)
 			throw std::out_of_range("List capacity exceeded");
 
-		array[size++] = item;
+		new (array + size) T(item);
+		size++;
+	}
+
+	/// Move a new element into the list just before the current position.
+	template <typename T>
+	void StaticArray<T>::insert(T&& item)
+	{
+		if (size == capacity)
+			throw std::out_of_range("List capacity exceeded");
+
+		if (curr == size)
+			new (array + curr) T(std::move(item));
+		else
+		{
+			T temp(std::move(item));   // item may be an element of this list
+			openGap(curr, 1);
+			new (array + curr) T(std::move(temp));
+		}
+
+		size++;
+	}
+
+	/// Move a new element to the end of the list (size).
+	template <typename T>
+	void StaticArray<T>::append(T&& item)
+	{
+		if (size == capacity)
+			throw std::out_of_range("List capacity exceeded");
+
+		new (array + size) T(std::move(item));
+		size++;
 	}
 
 	/// Remove the current element from the list.
 	template <typename T>
 	T StaticArray<T>::remove()
 	{
-		if (curr >= capacity)
+		if (curr >= size)
 			throw std::out_of_range("No current element");
 
-		T item = array[curr];
-
-		for (size_t i = curr; i < size - 1; i++)
-			array[i] = array[i + 1];
+		T item = std::move(array[curr]);
+		ArrayStorage<T>::destroy(array + curr, array + curr + 1);
+		closeGap(curr, 1);
 
 		size--;
 		return item;
 	}
 
+	/// Copy-construct the elements [first, last) into the uninitialized gap that starts at pos (see openGap()). If a copy throws, the gap is closed before rethrowing, so the list stays valid.
+	template <typename T>
+	void StaticArray<T>::fillGap(size_t pos, const T* first, const T* last)
+	{
+		try { std::uninitialized_copy(first, last, array + pos); }
+		catch (...)
+		{
+			size += last - first;   // The shifted tail ends at size + count: closeGap() works up to size
+			closeGap(pos, last - first);
+			size -= last - first;
+			throw;
+		}
+	}
+
+	/// Check whether the range [first, last) points into the active elements of this array.
+	template <typename T>
+	bool StaticArray<T>::overlaps(const T* first, const T* last) const
+	{
+		std::less<const T*> less;
+		return first != last && less(first, array + size) && less(array, last);
+	}
+
+	/// Store the elements [first, last) just before the current position (curr points to the first of them). The tail is shifted only once.
+	template <typename T>
+	void StaticArray<T>::insertRange(const T* first, const T* last)
+	{
+		size_t count = last - first;
+		if (size + count > capacity)
+			throw std::out_of_range("List capacity exceeded");
+
+		if (overlaps(first, last))
+		{
+			std::vector<T> temp(first, last);
+			insertRange(temp.data(), temp.data() + count);
+			return;
+		}
+
+		openGap(curr, count);
+		fillGap(curr, first, last);
+		size += count;
+	}
+
+	/// Store the elements [first, last) at the end of the list.
+	template <typename T>
+	void StaticArray<T>::appendRange(const T* first, const T* last)
+	{
+		size_t count = last - first;
+		if (size + count > capacity)
+			throw std::out_of_range("List capacity exceeded");
+
+		std::uninitialized_copy(first, last, array + size);
+		size += count;
+	}
+
+	/// Remove the elements in positions [pos, pos + count). The tail is shifted only once, and curr moves to pos.
+	template <typename T>
+	void StaticArray<T>::removeRange(size_t pos, size_t count)
+	{
+		if (pos > size || count > size - pos)
+			throw std::out_of_range("Range out of range");
+
+		ArrayStorage<T>::destroy(array + pos, array + pos + count);
+		closeGap(pos, count);
+		size -= count;
+		curr = pos;
+	}
+
+	/// Replace the content of the list with the elements [first, last). curr moves to the start.
+	template <typename T>
+	void StaticArray<T>::assign(const T* first, const T* last)
+	{
+		size_t count = last - first;
+		if (count > capacity)
+			throw std::out_of_range("List capacity exceeded");
+
+		if (overlaps(first, last))
+		{
+			std::vector<T> temp(first, last);
+			assign(temp.data(), temp.data() + count);
+			return;
+		}
+
+		ArrayStorage<T>::destroy(array, array + size);
+		size = curr = 0;
+		std::uninitialized_copy(first, last, array);
+		size = count;
+	}
+
 	/// Move curr to the first element.
 	template <typename T>
 	void StaticArray<T>::moveToStart() { curr = 0; }
@@ -759,1714 +2093,7204 @@ namespace dss   // Data Structures namespace
 	template <typename T>
 	size_t StaticArray<T>::currPos() const { return curr; }
 
-	/// Get the element stored in the current position.
+	/// Get the maximum number of elements the array can hold without reallocating.
 	template <typename T>
-	const T& StaticArray<T>::getValue() const
-	{
-		if (curr >= size)
-			throw std::out_of_range("No current element");
+	size_t StaticArray<T>::getCapacity() const { return capacity; }
 
-		return array[curr];
-	}
+	/// Get a pointer to the first element. The elements are contiguous: [data(), data() + length()).
+	template <typename T>
+	T* StaticArray<T>::data() { return array; }
 
-	/// External template function for any List subclass. If item is found, returns its position. Otherwise, returns array size. List::currPos' value can be modified.
 	template <typename T>
-	size_t find(List<T>* list, const T& item)
-	{
-		int i = 0;
-		for (list->moveToStart(); list->currPos() < list->length(); list->next())
-		{
-			if (item == list->getValue())
-				return list->currPos();
-		}
+	const T* StaticArray<T>::data() const { return array; }
 
-		return list->currPos();
-	}
+	/// Get an iterator to the first element.
+	template <typename T>
+	typename StaticArray<T>::iterator StaticArray<T>::begin() { return array; }
 
-	/// Print all the elements in the list.
+	/// Get an iterator to one-past-the-last element.
 	template <typename T>
-	void printList(List<T>* list)
-	{
-		for (list->moveToStart(); list->currPos() < list->length(); list->next())
-			std::cout << list->getValue() << " ";
+	typename StaticArray<T>::iterator StaticArray<T>::end() { return array + size; }
 
-		std::cout << std::endl;
-	}
+	template <typename T>
+	typename StaticArray<T>::const_iterator StaticArray<T>::begin() const { return array; }
 
-	/// Memory efficient swap operation. Alternatively, it can be made faster using more memory.
 	template <typename T>
-	void swap(T& a, T& b)
-	{
-		// Option 1: Faster, but uses more space.
-		// T temp = a;
-		// a = b;
-		// b = temp;
+	typename StaticArray<T>::const_iterator StaticArray<T>::end() const { return array + size; }
 
-		// Option 2: Slower, but uses less space.
-		a = a + b;
-		b = a - b;
-		a = a - b;
-	}
+	template <typename T>
+	typename StaticArray<T>::const_iterator StaticArray<T>::cbegin() const { return array; }
 
+	template <typename T>
+	typename StaticArray<T>::const_iterator StaticArray<T>::cend() const { return array + size; }
 
-	// -- DynamicArray --------------------------------------
+#if __cplusplus >= 202002L
+	static_assert(std::contiguous_iterator<StaticArray<int>::iterator>, "StaticArray iterators must be contiguous");
+	static_assert(std::contiguous_iterator<DynamicArray<int>::const_iterator>, "DynamicArray iterators must be contiguous");
+#endif
 
-	/// Constructor. Allocate memory for a number of elements.
+	/// Get the element stored in the current position.
 	template <typename T>
-	DynamicArray<T>::DynamicArray(size_t size) : StaticArray(size) { }
+	const T& StaticArray<T>::getValue() const
+	{
+		if (curr >= size)
+			throw std::out_of_range("No current element");
 
-	/// Constructor. Allocate memory for the elements in the initializer list and copy them into our list.
-	template <typename T>
-	DynamicArray<T>::DynamicArray(const std::initializer_list<T>& il) : StaticArray(il) { }
+		return array[curr];
+	}
 
-	/// Copy constructor.
+	/// Sort the elements according to cmp (introsort: quicksort with insertion sort for small ranges and heapsort as fallback). Not stable. curr moves to the start.
 	template <typename T>
-	DynamicArray<T>::DynamicArray(const DynamicArray& obj) : StaticArray(obj) { }
+	template <typename Compare>
+	void StaticArray<T>::sort(Compare cmp)
+	{
+		introsort(array, array + size, cmp);
+		curr = 0;
+	}
 
-	/// Destructor. Delete the memory allocated by the constructor for this list. 
+	/// Sort through the List interface. cmp is called through std::function.
 	template <typename T>
-	DynamicArray<T>::~DynamicArray() { }
+	void StaticArray<T>::sort(const std::function<bool(const T&, const T&)>& cmp) { sort(std::cref(cmp)); }
 
-	/// Copy-assignment operator overloading.
+	/// Sort the elements according to cmp using up to "threads" threads (0: one per hardware thread). Small arrays are sorted sequentially. cmp is called concurrently, so it must be thread-safe. curr moves to the start.
 	template <typename T>
-	DynamicArray<T>& DynamicArray<T>::operator=(const DynamicArray& obj)
+	template <typename Compare>
+	void StaticArray<T>::parallelSort(Compare cmp, unsigned threads)
 	{
-		if (this == &obj) return *this;
+		if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
 
-		if(array) delete[] array;
+		parallelIntrosort(array, array + size, cmp, threads);
+		curr = 0;
+	}
 
-		copyFrom(obj);
+	/// Index of the lowest set bit (mask != 0).
+	inline unsigned lowestBit(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
 
-		return *this;
+	/// Index of the lowest set bit (mask != 0).
+	inline unsigned lowestBit64(uint64_t mask)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+		return index;
+#elif defined(_MSC_VER)
+		return ((uint32_t)mask ? lowestBit((uint32_t)mask) : 32 + lowestBit((uint32_t)(mask >> 32)));
+#else
+		return __builtin_ctzll(mask);
+#endif
 	}
 
-	/// Increase array capacity if necessary.
-	template <typename T>
-	void DynamicArray<T>::increaseCapacity()
+	/// Ask the CPU to start loading the cache line of an address (read access). It doesn't wait, and it's only a hint.
+	inline void prefetch(const void* address)
 	{
-		if (size == capacity)
-		{
-			capacity = capacity ? capacity * 2 : 1;
-			T* newArray = new T[capacity];
+#if defined(DSS_SSE2)
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(address);
+#endif
+	}
 
-			for (size_t i = 0; i < size; i++)
-				newArray[i] = array[i];
+	/// True if findContiguous() can compare T with vector instructions: integers, float and double (their == is the same as the vector comparison, including NaN and -0.0).
+	template <typename T>
+	struct SimdSearchable : std::integral_constant<bool,
+		(std::is_integral<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+		std::is_same<T, float>::value || std::is_same<T, double>::value> { };
 
-			delete[] array;
-			array = newArray;
-		}
+#if defined(DSS_SSE2)
+	/// Vector with item in every lane.
+	template <typename T>
+	__m128i simdSet128(T item)
+	{
+		if constexpr (std::is_same<T, float>::value) return _mm_castps_si128(_mm_set1_ps(item));
+		else if constexpr (std::is_same<T, double>::value) return _mm_castpd_si128(_mm_set1_pd(item));
+		else if constexpr (sizeof(T) == 1) return _mm_set1_epi8((char)item);
+		else if constexpr (sizeof(T) == 2) return _mm_set1_epi16((short)item);
+		else if constexpr (sizeof(T) == 4) return _mm_set1_epi32((int)item);
+		else return _mm_set1_epi64x((long long)item);
 	}
 
-	/// Decrease array capacity if necessary.
+	/// Lane-wise a == b. Equal lanes get all their bits set.
 	template <typename T>
-	void DynamicArray<T>::decreaseCapacity()
+	__m128i simdEqual128(__m128i a, __m128i b)
 	{
-		if (capacity && size == (capacity / 4))
+		if constexpr (std::is_same<T, float>::value) return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+		else if constexpr (std::is_same<T, double>::value) return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+		else if constexpr (sizeof(T) == 1) return _mm_cmpeq_epi8(a, b);
+		else if constexpr (sizeof(T) == 2) return _mm_cmpeq_epi16(a, b);
+		else if constexpr (sizeof(T) == 4) return _mm_cmpeq_epi32(a, b);
+		else
 		{
-			capacity /= 2;
-			T* newArray = new T[capacity];
-
-			for (size_t i = 0; i < size; i++)
-				newArray[i] = array[i];
-
-			delete[] array;
-			array = newArray;
+			__m128i halves = _mm_cmpeq_epi32(a, b);   // SSE2 has no 64-bit compare: both 32-bit halves must be equal
+			return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
 		}
 	}
 
-	/// Set size to 0 (capacity remains the same).
+	/// Byte mask (bit i = byte i) of the elements equal to key in the 16 bytes at p.
 	template <typename T>
-	void DynamicArray<T>::clear()
+	uint32_t simdMatch128(const T* p, __m128i key)
 	{
-		capacity = size = curr = 0;
-		delete[] array;
-		array = new T[0];
+		return (uint32_t)_mm_movemask_epi8(simdEqual128<T>(_mm_loadu_si128((const __m128i*)p), key));
 	}
+#endif
 
-	/// Store a new element in the list just before the current position.
+#if defined(DSS_AVX2)
 	template <typename T>
-	void DynamicArray<T>::insert(const T& item)
+	__m256i simdSet256(T item)
 	{
-		increaseCapacity();
-
-		for (size_t i = size; i > curr; i--)
-			array[i] = array[i - 1];
-
-		array[curr] = item;
-		size++;
+		if constexpr (std::is_same<T, float>::value) return _mm256_castps_si256(_mm256_set1_ps(item));
+		else if constexpr (std::is_same<T, double>::value) return _mm256_castpd_si256(_mm256_set1_pd(item));
+		else if constexpr (sizeof(T) == 1) return _mm256_set1_epi8((char)item);
+		else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16((short)item);
+		else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32((int)item);
+		else return _mm256_set1_epi64x((long long)item);
 	}
 
-	/// Store a new element at the end of the list (size).
 	template <typename T>
-	void DynamicArray<T>::append(const T& item)
+	uint32_t simdMatch256(const T* p, __m256i key)
 	{
-		increaseCapacity();
+		__m256i a = _mm256_loadu_si256((const __m256i*)p);
+		__m256i equal;
+		if constexpr (std::is_same<T, float>::value) equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(key), _CMP_EQ_OQ));
+		else if constexpr (std::is_same<T, double>::value) equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(key), _CMP_EQ_OQ));
+		else if constexpr (sizeof(T) == 1) equal = _mm256_cmpeq_epi8(a, key);
+		else if constexpr (sizeof(T) == 2) equal = _mm256_cmpeq_epi16(a, key);
+		else if constexpr (sizeof(T) == 4) equal = _mm256_cmpeq_epi32(a, key);
+		else equal = _mm256_cmpeq_epi64(a, key);
 
-		array[size++] = item;
+		return (uint32_t)_mm256_movemask_epi8(equal);
 	}
+#endif
 
-	/// Remove the current element from the list.
+	/// Linear search over a contiguous range. Returns the position of the first element equal to item, or size if there is none. Integers, float and double are compared with SSE2/AVX2 (4 vectors per iteration, with a single branch), and the tail with scalar code. Other types use a plain loop (no virtual calls).
 	template <typename T>
-	T DynamicArray<T>::remove()
+	size_t findContiguous(const T* first, size_t size, const T& item)
 	{
-		if (curr >= capacity)
-			throw std::out_of_range("No current element");
-
-		decreaseCapacity();
+		size_t i = 0;
 
-		T item = array[curr];
+		if constexpr (SimdSearchable<T>::value)
+		{
+#if defined(DSS_AVX2)
+			const size_t lanes = 32 / sizeof(T);
+			__m256i key = simdSet256(item);
+			for (; i + 4 * lanes <= size; i += 4 * lanes)
+			{
+				uint32_t masks[4] = { simdMatch256(first + i, key), simdMatch256(first + i + lanes, key), simdMatch256(first + i + 2 * lanes, key), simdMatch256(first + i + 3 * lanes, key) };
+				if (masks[0] | masks[1] | masks[2] | masks[3])
+					for (size_t k = 0; k < 4; k++)
+						if (masks[k]) return i + k * lanes + lowestBit(masks[k]) / sizeof(T);
+			}
+			for (; i + lanes <= size; i += lanes)
+				if (uint32_t mask = simdMatch256(first + i, key))
+					return i + lowestBit(mask) / sizeof(T);
+#elif defined(DSS_SSE2)
+			const size_t lanes = 16 / sizeof(T);
+			__m128i key = simdSet128(item);
+			for (; i + 4 * lanes <= size; i += 4 * lanes)
+			{
+				uint32_t masks[4] = { simdMatch128(first + i, key), simdMatch128(first + i + lanes, key), simdMatch128(first + i + 2 * lanes, key), simdMatch128(first + i + 3 * lanes, key) };
+				if (masks[0] | masks[1] | masks[2] | masks[3])
+					for (size_t k = 0; k < 4; k++)
+						if (masks[k]) return i + k * lanes + lowestBit(masks[k]) / sizeof(T);
+			}
+			for (; i + lanes <= size; i += lanes)
+				if (uint32_t mask = simdMatch128(first + i, key))
+					return i + lowestBit(mask) / sizeof(T);
+#endif
+		}
 
-		for (size_t i = curr; i < size - 1; i++)
-			array[i] = array[i + 1];
+		for (; i < size; i++)
+			if (first[i] == item)
+				return i;
 
-		size--;
-		return item;
+		return size;
 	}
 
+	/// External template function for any List subclass. If item is found, returns its position. Otherwise, returns array size. List::currPos' value can be modified. Array-based lists are searched directly in their buffer (findContiguous()), without virtual calls.
+	template <typename T>
+	size_t find(List<T>* list, const T& item)
+	{
+		if (StaticArray<T>* array = dynamic_cast<StaticArray<T>*>(list))
+		{
+			size_t pos = findContiguous(array->data(), array->length(), item);
+			array->moveToPos(pos);
+			return pos;
+		}
 
-	// -- Node --------------------------------------
+		for (list->moveToStart(); list->currPos() < list->length(); list->next())
+		{
+			if (item == list->getValue())
+				return list->currPos();
+		}
 
-	/// Constructor.
-	template <typename T>
-	Node<T>::Node() { };
+		return list->currPos();
+	}
 
-	/// Constructor.
+	/// Print all the elements in the list.
 	template <typename T>
-	Node<T>::Node(T content) : element(content) { };
+	void printList(List<T>* list)
+	{
+		for (list->moveToStart(); list->currPos() < list->length(); list->next())
+			std::cout << list->getValue() << " ";
 
-	/// Copy constructor.
-	template <typename T>
-	Node<T>::Node(const Node& obj) : element(obj.element) { };
+		std::cout << std::endl;
+	}
 
-	/// Destructor.
-	template <typename T>
-	Node<T>::~Node() { };
+	/// Statically dispatched find() for any list type L. Since the concrete lists are final, their calls are resolved at compile time and can be inlined (L = List<T> still works, through the vtable). Array-based lists are searched with findContiguous(). Positions are counted here, so currPos() is not called. If item is found, returns its position. Otherwise, returns list size. The list's current position is modified.
+	template <typename L>
+	size_t find(L& list, const typename L::value_type& item)
+	{
+		typedef typename L::value_type T;
 
-	/// Copy-assignment operator overloading.
+		if constexpr (std::is_base_of<StaticArray<T>, L>::value)
+		{
+			size_t pos = findContiguous(list.data(), list.length(), item);
+			list.moveToPos(pos);
+			return pos;
+		}
+		else
+		{
+			if constexpr (std::is_same<L, List<T>>::value)
+				if (StaticArray<T>* array = dynamic_cast<StaticArray<T>*>(&list))
+					return find(*array, item);
+
+			size_t size = list.length();
+			size_t i = 0;
+
+			for (list.moveToStart(); i < size; list.next(), i++)
+				if (item == list.getValue())
+					return i;
+
+			return i;
+		}
+	}
+
+	/// Statically dispatched printList() for any list type L.
+	template <typename L>
+	void printList(L& list)
+	{
+		size_t size = list.length();
+
+		list.moveToStart();
+		for (size_t i = 0; i < size; i++, list.next())
+			std::cout << list.getValue() << " ";
+
+		std::cout << std::endl;
+	}
+
+	/// Memory efficient swap operation. Alternatively, it can be made faster using more memory.
 	template <typename T>
-	Node<T>& Node<T>::operator=(const Node& obj) 
-	{ 
+	void swap(T& a, T& b)
+	{
+		// Option 1: Faster, but uses more space.
+		// T temp = a;
+		// a = b;
+		// b = temp;
+
+		// Option 2: Slower, but uses less space.
+		a = a + b;
+		b = a - b;
+		a = a - b;
+	}
+
+	/// Sort any list type L with the algorithm that suits its layout. Calls to the concrete lists are statically dispatched, so cmp can be inlined (L = List<T> still works, through the vtable and std::function). curr moves to the start.
+	template <typename L, typename Compare>
+	void sort(L& list, Compare cmp) { list.sort(cmp); }
+
+	const size_t insertionSortThreshold = 16;   // Ranges smaller than this are insertion sorted
+	const size_t nintherThreshold = 128;   // Ranges bigger than this take the pivot from 9 elements instead of 3
+	const size_t partialInsertionSortLimit = 8;   // Max. moves before partialInsertionSort() gives up
+	const size_t parallelSortThreshold = 1 << 15;   // Ranges smaller than this are sorted by a single thread
+
+	/// Sort [first, last) with insertion sort. O(n^2), but the fastest option for small or almost sorted ranges.
+	template <typename T, typename Compare>
+	void insertionSort(T* first, T* last, Compare& cmp)
+	{
+		if (first == last) return;
+
+		for (T* i = first + 1; i < last; i++)
+		{
+			if (!cmp(*i, *(i - 1))) continue;
+
+			T item = std::move(*i);
+			T* j = i;
+			do
+			{
+				*j = std::move(*(j - 1));
+				j--;
+			} while (j > first && cmp(item, *(j - 1)));
+			*j = std::move(item);
+		}
+	}
+
+	/// Insertion sort that gives up (returns false) after moving elements more than partialInsertionSortLimit times. Returns true if [first, last) got sorted.
+	template <typename T, typename Compare>
+	bool partialInsertionSort(T* first, T* last, Compare& cmp)
+	{
+		if (first == last) return true;
+
+		size_t moves = 0;
+		for (T* i = first + 1; i < last; i++)
+		{
+			if (!cmp(*i, *(i - 1))) continue;
+
+			T item = std::move(*i);
+			T* j = i;
+			do
+			{
+				*j = std::move(*(j - 1));
+				j--;
+			} while (j > first && cmp(item, *(j - 1)));
+			*j = std::move(item);
+
+			moves += i - j;
+			if (moves > partialInsertionSortLimit) return false;
+		}
+
+		return true;
+	}
+
+	/// Restore the max-heap property of the subtree rooted at i, in a heap of n elements.
+	template <typename T, typename Compare>
+	void siftDown(T* first, size_t i, size_t n, Compare& cmp)
+	{
+		T item = std::move(first[i]);
+
+		for (size_t child; (child = 2 * i + 1) < n; i = child)
+		{
+			if (child + 1 < n && cmp(first[child], first[child + 1])) child++;
+			if (!cmp(item, first[child])) break;
+			first[i] = std::move(first[child]);
+		}
+
+		first[i] = std::move(item);
+	}
+
+	/// Sort [first, last) with heapsort. O(n log n) in the worst case, but slower than quicksort on average. Used by introsort when partitions keep being unbalanced.
+	template <typename T, typename Compare>
+	void heapSort(T* first, T* last, Compare& cmp)
+	{
+		size_t n = last - first;
+
+		for (size_t i = n / 2; i-- > 0; )
+			siftDown(first, i, n, cmp);
+
+		for (size_t end = n; end-- > 1; )
+		{
+			std::swap(first[0], first[end]);
+			siftDown(first, 0, end, cmp);
+		}
+	}
+
+	/// Order 3 elements so that !(b < a) and !(c < b).
+	template <typename T, typename Compare>
+	void sort3(T* a, T* b, T* c, Compare& cmp)
+	{
+		if (cmp(*b, *a)) std::swap(*a, *b);
+		if (cmp(*c, *b))
+		{
+			std::swap(*b, *c);
+			if (cmp(*b, *a)) std::swap(*a, *b);
+		}
+	}
+
+	/// Move the median of 3 (or the median of 3 medians, for big ranges) to *first, to be used as pivot. Afterwards, there is some element >= pivot at the end of the range, and some element <= pivot after first, which stop the partition loops without bounds checks.
+	template <typename T, typename Compare>
+	void choosePivot(T* first, T* last, Compare& cmp)
+	{
+		size_t size = last - first;
+		size_t half = size / 2;
+
+		if (size > nintherThreshold)
+		{
+			sort3(first, first + half, last - 1, cmp);
+			sort3(first + 1, first + (half - 1), last - 2, cmp);
+			sort3(first + 2, first + (half + 1), last - 3, cmp);
+			sort3(first + (half - 1), first + half, first + (half + 1), cmp);
+			std::swap(*first, *(first + half));
+		}
+		else sort3(first + half, first, last - 1, cmp);
+	}
+
+	/// Partition [first, last) around the pivot *first: elements < pivot go to its left, and the rest to its right. Returns the pivot's final position, and whether the range was already partitioned (no swaps were needed).
+	template <typename T, typename Compare>
+	std::pair<T*, bool> partitionRight(T* first, T* last, Compare& cmp)
+	{
+		T pivot = std::move(*first);
+		T* i = first;
+		T* j = last;
+
+		while (cmp(*++i, pivot));
+
+		if (i - 1 == first)
+			while (i < j && !cmp(*--j, pivot));
+		else
+			while (!cmp(*--j, pivot));
+
+		bool alreadyPartitioned = i >= j;
+
+		while (i < j)
+		{
+			std::swap(*i, *j);
+			while (cmp(*++i, pivot));
+			while (!cmp(*--j, pivot));
+		}
+
+		T* pivotPos = i - 1;
+		*first = std::move(*pivotPos);
+		*pivotPos = std::move(pivot);
+		return std::make_pair(pivotPos, alreadyPartitioned);
+	}
+
+	/// Partition [first, last) around the pivot *first: elements equal to the pivot go to its left, and the bigger ones to its right. Returns the pivot's final position. Used when the pivot is equal to the element preceding the range, so the elements equal to it are already in place.
+	template <typename T, typename Compare>
+	T* partitionLeft(T* first, T* last, Compare& cmp)
+	{
+		T pivot = std::move(*first);
+		T* i = first;
+		T* j = last;
+
+		while (cmp(pivot, *--j));
+
+		if (j + 1 == last)
+			while (i < j && !cmp(pivot, *++i));
+		else
+			while (!cmp(pivot, *++i));
+
+		while (i < j)
+		{
+			std::swap(*i, *j);
+			while (cmp(pivot, *--j));
+			while (!cmp(pivot, *++i));
+		}
+
+		*first = std::move(*j);
+		*j = std::move(pivot);
+		return j;
+	}
+
+	/// Introsort loop (pattern-defeating quicksort variant). It recurses on the smaller partition and iterates on the bigger one, so the stack depth is O(log n). leftmost is false when the element preceding the range (*(first - 1)) is a previous pivot, which is <= every element of the range. After "badAllowed" highly unbalanced partitions, it switches to heapsort.
+	template <typename T, typename Compare>
+	void introsortLoop(T* first, T* last, Compare& cmp, int badAllowed, bool leftmost)
+	{
+		while (true)
+		{
+			size_t size = last - first;
+			if (size < insertionSortThreshold)
+			{
+				insertionSort(first, last, cmp);
+				return;
+			}
+
+			choosePivot(first, last, cmp);
+
+			if (!leftmost && !cmp(*(first - 1), *first))   // Many duplicates: skip all the elements equal to the pivot
+			{
+				first = partitionLeft(first, last, cmp) + 1;
+				continue;
+			}
+
+			std::pair<T*, bool> result = partitionRight(first, last, cmp);
+			T* pivot = result.first;
+			size_t leftSize = pivot - first;
+			size_t rightSize = last - (pivot + 1);
+			bool highlyUnbalanced = leftSize < size / 8 || rightSize < size / 8;
+
+			if (highlyUnbalanced)
+			{
+				if (--badAllowed == 0)
+				{
+					heapSort(first, last, cmp);
+					return;
+				}
+			}
+			else if (result.second && partialInsertionSort(first, pivot, cmp) && partialInsertionSort(pivot + 1, last, cmp))
+				return;   // Already (almost) sorted
+
+			if (leftSize < rightSize)
+			{
+				introsortLoop(first, pivot, cmp, badAllowed, leftmost);
+				first = pivot + 1;
+				leftmost = false;
+			}
+			else
+			{
+				introsortLoop(pivot + 1, last, cmp, badAllowed, false);
+				last = pivot;
+			}
+		}
+	}
+
+	/// Sort [first, last) according to cmp. O(n log n) in the worst case, O(n) for sorted, reversed or all-equal ranges. Not stable.
+	template <typename T, typename Compare>
+	void introsort(T* first, T* last, Compare& cmp)
+	{
+		int depthLimit = 1;
+		for (size_t size = last - first; size > 1; size >>= 1)
+			depthLimit++;
+
+		introsortLoop(first, last, cmp, depthLimit, true);
+	}
+
+	/// Sort [first, last) according to cmp using up to "threads" threads. Each step partitions the range once and sorts both sides concurrently. Exceptions thrown by cmp are propagated after all the threads have finished.
+	template <typename T, typename Compare>
+	void parallelIntrosort(T* first, T* last, Compare& cmp, unsigned threads)
+	{
+		if (threads < 2 || size_t(last - first) < parallelSortThreshold)
+		{
+			introsort(first, last, cmp);
+			return;
+		}
+
+		choosePivot(first, last, cmp);
+		T* pivot = partitionRight(first, last, cmp).first;
+
+		std::future<void> left = std::async(std::launch::async, [first, pivot, &cmp, threads]() { parallelIntrosort(first, pivot, cmp, threads / 2); });
+		parallelIntrosort(pivot + 1, last, cmp, threads - threads / 2);
+		left.get();
+	}
+
+	/// Merge two sorted chains of nodes. On ties, nodes of "a" go first (stable). Returns the first node of the result.
+	template <typename N, typename Compare, typename Next, typename SetNext>
+	N* mergeChains(N* a, N* b, Compare& cmp, Next& next, SetNext& setNext)
+	{
+		N* first;
+		if (cmp(b->element, a->element)) { first = b; b = next(b); }
+		else { first = a; a = next(a); }
+
+		N* last = first;
+		while (a && b)
+		{
+			if (cmp(b->element, a->element)) { setNext(last, b); last = b; b = next(b); }
+			else { setNext(last, a); last = a; a = next(a); }
+		}
+
+		setNext(last, a ? a : b);
+		return first;
+	}
+
+	/// Bottom-up merge sort for a null-terminated chain of nodes, linked through next(node) and setNext(node, nextNode). Nodes are relinked, elements are never copied or moved. The chain is read only once: each node is merged into an array of sorted runs of 2^i nodes (like adding 1 to a binary counter), so merges work on recently visited nodes. Stable. Returns the first node of the sorted chain.
+	template <typename N, typename Compare, typename Next, typename SetNext>
+	N* mergeSortChain(N* first, Compare& cmp, Next next, SetNext setNext)
+	{
+		N* runs[64] = { };   // runs[i]: sorted run of 2^i nodes, or nullptr
+		size_t used = 0;
+
+		while (first)
+		{
+			N* run = first;
+			first = next(first);
+			setNext(run, nullptr);
+
+			size_t i = 0;
+			for (; i < used && runs[i]; i++)
+			{
+				run = mergeChains(runs[i], run, cmp, next, setNext);
+				runs[i] = nullptr;
+			}
+
+			runs[i] = run;
+			if (i == used) used++;
+		}
+
+		N* result = nullptr;
+		for (size_t i = 0; i < used; i++)
+			if (runs[i])
+				result = result ? mergeChains(runs[i], result, cmp, next, setNext) : runs[i];
+
+		return result;
+	}
+
+
+	// -- DynamicArray --------------------------------------
+
+	/// Constructor. Get memory for a number of elements (in the inline buffer if they fit). Like reserve(), it is a floor for automatic shrinking.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>::DynamicArray(size_t size)
+		: StaticArray<T>(size_t(0)), shrinkThreshold(0.25f), minCapacity(size), reallocCount(0), copiedBytes(0)
+	{
+		capacity = size;
+		array = getStorage(capacity);
+	}
+
+	/// Constructor. Get memory for the elements in the initializer list and copy them into our list.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>::DynamicArray(const std::initializer_list<T>& il)
+		: StaticArray<T>(size_t(0)), shrinkThreshold(0.25f), minCapacity(0), reallocCount(0), copiedBytes(0)
+	{
+		construct(il.begin(), il.end());
+	}
+
+	/// Copy constructor. Capacity is the size of obj (or N, if greater), with no reserved capacity. Counters start from 0.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>::DynamicArray(const DynamicArray& obj)
+		: StaticArray<T>(size_t(0)), shrinkThreshold(obj.shrinkThreshold), minCapacity(0), reallocCount(0), copiedBytes(0)
+	{
+		construct(obj.array, obj.array + obj.size);
+		curr = obj.curr;
+	}
+
+	/// Move constructor. The heap array of obj is taken (with its reserved capacity), or the elements in its inline buffer are relocated to ours. obj is left empty. Counters start from 0.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>::DynamicArray(DynamicArray&& obj) noexcept(nothrowMove)
+		: StaticArray<T>(size_t(0)), shrinkThreshold(obj.shrinkThreshold), minCapacity(0), reallocCount(0), copiedBytes(0)
+	{
+		moveFrom(obj);
+	}
+
+	/// Destructor. Destroy the elements if they are in the inline buffer (heap memory is released by StaticArray).
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>::~DynamicArray()
+	{
+		if (array == inlineData())
+		{
+			ArrayStorage<T>::destroy(array, array + size);
+			array = nullptr;
+			size = 0;
+		}
+	}
+
+	/// Copy-assignment operator overloading. Current storage is reused if it is big enough.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>& DynamicArray<T, Growth, N>::operator=(const DynamicArray& obj)
+	{
 		if (this == &obj) return *this;
 
-		element = obj.element; 
+		assign(obj.array, obj.array + obj.size);
+		curr = obj.curr;
+		shrinkThreshold = obj.shrinkThreshold;
 
-		return *this; 
-	};
+		return *this;
+	}
 
+	/// Move-assignment operator overloading. Our elements are destroyed, and the elements of obj are taken (see moveFrom()). obj is left empty.
+	template <typename T, typename Growth, size_t N>
+	DynamicArray<T, Growth, N>& DynamicArray<T, Growth, N>::operator=(DynamicArray&& obj) noexcept(nothrowMove)
+	{
+		if (this == &obj) return *this;
 
-	// -- SNode --------------------------------------
+		ArrayStorage<T>::destroy(array, array + size);
+		freeStorage(array);
+		moveFrom(obj);
+		shrinkThreshold = obj.shrinkThreshold;
+
+		return *this;
+	}
+
+	/// Get uninitialized memory for newCapacity elements: the inline buffer if they fit (newCapacity is rounded up to N), or heap memory. The inline buffer must not be in use.
+	template <typename T, typename Growth, size_t N>
+	T* DynamicArray<T, Growth, N>::getStorage(size_t& newCapacity)
+	{
+		if (newCapacity <= N)
+		{
+			newCapacity = N;
+			return inlineData();
+		}
+
+		return ArrayStorage<T>::allocate(newCapacity);
+	}
+
+	/// Release memory obtained from getStorage(). Elements must have been destroyed already.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::freeStorage(T* storage)
+	{
+		if (storage != inlineData())
+			ArrayStorage<T>::deallocate(storage);
+	}
+
+	/// Destroy the elements and release our storage (the inline buffer stays with the object). Called by the StaticArray assignments, so they don't free the inline buffer. The list is left empty, with no storage.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::releaseStorage() noexcept
+	{
+		ArrayStorage<T>::destroy(array, array + size);
+		freeStorage(array);
+
+		array = nullptr;
+		capacity = size = curr = minCapacity = 0;
+	}
+
+	/// A heap array can be taken by other StaticArrays, but the inline buffer can't.
+	template <typename T, typename Growth, size_t N>
+	bool DynamicArray<T, Growth, N>::handsOverArray() const noexcept { return N == 0 || array != inlineData(); }
+
+	/// Get memory for the elements [first, last) and copy them into our list. Only for constructors (the array must be empty and have no storage). If a copy throws, the storage is released before rethrowing.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::construct(const T* first, const T* last)
+	{
+		size_t count = last - first;
+		capacity = count;
+		array = getStorage(capacity);
+
+		try { std::uninitialized_copy(first, last, array); }
+		catch (...)
+		{
+			freeStorage(array);
+			array = nullptr;
+			capacity = 0;
+			throw;
+		}
+
+		size = count;
+	}
+
+	/// Take the elements of obj (our elements must have been destroyed and our storage released). A heap array is taken as is, while elements in the inline buffer of obj are relocated to ours. obj is left empty (with its inline buffer, if any).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::moveFrom(DynamicArray& obj) noexcept(nothrowMove)
+	{
+		if (obj.array == obj.inlineData())
+		{
+			array = inlineData();
+			ArrayStorage<T>::relocate(obj.array, obj.size, array);
+		}
+		else
+			array = obj.array;
+
+		capacity = obj.capacity;
+		size = obj.size;
+		curr = obj.curr;
+		minCapacity = obj.minCapacity;
+
+		obj.capacity = obj.size = obj.curr = obj.minCapacity = 0;
+		obj.array = obj.getStorage(obj.capacity);
+	}
+
+	/// Decrease array capacity if size fell to the shrink threshold. The new capacity is the one a growth from "size" would produce, so the next insertions don't reallocate again (hysteresis), but never below the reserved capacity (minCapacity).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::decreaseCapacity()
+	{
+		if (capacity <= minCapacity || size > capacity * shrinkThreshold) return;
+
+		size_t newCapacity = std::max(size ? Growth::grow(size, sizeof(T)) : 0, minCapacity);
+		if (newCapacity < capacity)
+			reallocate(newCapacity);
+	}
+
+	/// Move the active elements to a new array with a different capacity (>= size). Only active elements are relocated (move-construction, or memcpy for trivially copyable types).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::reallocate(size_t newCapacity)
+	{
+		if (array == inlineData() && newCapacity <= N) return;   // Already in the inline buffer
+
+		T* newArray = getStorage(newCapacity);
+		ArrayStorage<T>::relocate(array, size, newArray);
+		freeStorage(array);
+
+		array = newArray;
+		capacity = newCapacity;
+		reallocCount++;
+		copiedBytes += size * sizeof(T);
+	}
+
+	/// Construct a new element in place at any position from 0 to size, shifting subsequent elements to the right.
+	template <typename T, typename Growth, size_t N>
+	template <typename... Args>
+	T& DynamicArray<T, Growth, N>::emplaceAt(size_t pos, Args&&... args)
+	{
+		if (size == capacity)
+			return emplaceGrow(pos, std::forward<Args>(args)...);
+
+		if (pos == size)
+			new (array + pos) T(std::forward<Args>(args)...);
+		else
+		{
+			T temp(std::forward<Args>(args)...);   // args may refer to an element of this list
+			openGap(pos, 1);
+			new (array + pos) T(std::move(temp));
+		}
+
+		size++;
+		return array[pos];
+	}
+
+	/// Slow path of emplaceAt(), used when the array is full. The new element is built in the new array before relocating the old ones (args may refer to an element of this list).
+	template <typename T, typename Growth, size_t N>
+	template <typename... Args>
+	T& DynamicArray<T, Growth, N>::emplaceGrow(size_t pos, Args&&... args)
+	{
+		size_t newCapacity = Growth::grow(capacity, sizeof(T));
+		T* newArray = getStorage(newCapacity);
+
+		try { new (newArray + pos) T(std::forward<Args>(args)...); }
+		catch (...) { freeStorage(newArray); throw; }
+
+		ArrayStorage<T>::relocate(array, pos, newArray);
+		ArrayStorage<T>::relocate(array + pos, size - pos, newArray + pos + 1);
+		freeStorage(array);
+
+		array = newArray;
+		capacity = newCapacity;
+		reallocCount++;
+		copiedBytes += size * sizeof(T);
+		size++;
+		return array[pos];
+	}
+
+	/// Store the elements [first, last) at any position from 0 to size. The tail is shifted (or relocated, if the array grows) only once.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::insertAt(size_t pos, const T* first, const T* last)
+	{
+		size_t count = last - first;
+
+		if (size + count > capacity)   // Copy the new elements before relocating the old ones ([first, last) may be part of this list).
+		{
+			size_t newCapacity = capacity;
+			while (newCapacity < size + count)
+				newCapacity = Growth::grow(newCapacity, sizeof(T));
+
+			T* newArray = getStorage(newCapacity);
+			try { std::uninitialized_copy(first, last, newArray + pos); }
+			catch (...) { freeStorage(newArray); throw; }
+
+			ArrayStorage<T>::relocate(array, pos, newArray);
+			ArrayStorage<T>::relocate(array + pos, size - pos, newArray + pos + count);
+			freeStorage(array);
+
+			array = newArray;
+			capacity = newCapacity;
+			reallocCount++;
+			copiedBytes += size * sizeof(T);
+		}
+		else if (overlaps(first, last))
+		{
+			std::vector<T> temp(first, last);
+			insertAt(pos, temp.data(), temp.data() + count);
+			return;
+		}
+		else
+		{
+			openGap(pos, count);
+			fillGap(pos, first, last);
+		}
+
+		size += count;
+	}
+
+	/// Store the elements [first, last) just before the current position (curr points to the first of them).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::insertRange(const T* first, const T* last) { insertAt(curr, first, last); }
+
+	/// Store the elements [first, last) at the end of the list.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::appendRange(const T* first, const T* last) { insertAt(size, first, last); }
+
+	/// Remove the elements in positions [pos, pos + count). The tail is shifted only once, and curr moves to pos.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::removeRange(size_t pos, size_t count)
+	{
+		StaticArray<T>::removeRange(pos, count);
+
+		decreaseCapacity();
+	}
+
+	/// Replace the content of the list with the elements [first, last). curr moves to the start.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::assign(const T* first, const T* last)
+	{
+		if (size_t(last - first) > capacity)
+		{
+			size_t count = last - first, newCapacity = count;
+			T* newArray = getStorage(newCapacity);
+			try { std::uninitialized_copy(first, last, newArray); }
+			catch (...) { freeStorage(newArray); throw; }
+
+			ArrayStorage<T>::destroy(array, array + size);
+			freeStorage(array);
+
+			array = newArray;
+			capacity = newCapacity;
+			size = count;
+			curr = 0;
+			reallocCount++;
+		}
+		else
+			StaticArray<T>::assign(first, last);
+	}
+
+	/// Destroy all elements and release the heap memory beyond the reserved capacity (without reserve, capacity becomes N, the inline buffer).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::clear()
+	{
+		ArrayStorage<T>::destroy(array, array + size);
+		size = curr = 0;
+
+		if (capacity > minCapacity && !(array == inlineData() && minCapacity <= N))
+		{
+			size_t newCapacity = minCapacity;
+			T* newArray = getStorage(newCapacity);   // No allocation unless a capacity was reserved
+			freeStorage(array);
+			array = newArray;
+			capacity = newCapacity;
+		}
+	}
+
+	/// Store a new element in the list just before the current position.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::insert(const T& item) { emplaceAt(curr, item); }
+
+	/// Move a new element into the list just before the current position.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::insert(T&& item) { emplaceAt(curr, std::move(item)); }
+
+	/// Construct a new element in place just before the current position, and return a reference to it.
+	template <typename T, typename Growth, size_t N>
+	template <typename... Args>
+	T& DynamicArray<T, Growth, N>::emplace(Args&&... args) { return emplaceAt(curr, std::forward<Args>(args)...); }
+
+	/// Store a new element at the end of the list (size).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::append(const T& item) { emplace_back(item); }
+
+	/// Move a new element to the end of the list (size).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::append(T&& item) { emplace_back(std::move(item)); }
+
+	/// Construct a new element in place at the end of the list (size) and return a reference to it. Fast path kept small so it can be inlined.
+	template <typename T, typename Growth, size_t N>
+	template <typename... Args>
+	T& DynamicArray<T, Growth, N>::emplace_back(Args&&... args)
+	{
+		if (size == capacity)
+			return emplaceGrow(size, std::forward<Args>(args)...);
+
+		new (array + size) T(std::forward<Args>(args)...);
+		return array[size++];
+	}
+
+	/// Remove the current element from the list.
+	template <typename T, typename Growth, size_t N>
+	T DynamicArray<T, Growth, N>::remove()
+	{
+		T item = StaticArray<T>::remove();
+
+		decreaseCapacity();
+
+		return item;
+	}
+
+	/// Make sure the array can hold at least newCapacity elements without further reallocations. The reserved capacity is kept when elements are removed (until shrink_to_fit()), so fill-and-drain cycles don't reallocate.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::reserve(size_t newCapacity)
+	{
+		if (newCapacity > capacity)
+			reallocate(newCapacity);
+
+		if (newCapacity > minCapacity)
+			minCapacity = newCapacity;
+	}
+
+	/// Release the unused capacity (capacity becomes size, or N if the elements fit in the inline buffer). The reserved capacity is dropped too.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::shrink_to_fit()
+	{
+		minCapacity = 0;
+		if (capacity > size)
+			reallocate(size);
+	}
+
+	/// Set the fraction of capacity at or below which the array shrinks (default: 0.25). Use 0 to shrink only when empty, or a negative value to never shrink. For hysteresis, keep it below 1/(growth factor).
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::setShrinkThreshold(float threshold) { shrinkThreshold = threshold; }
+
+	/// Get the number of reallocations (growths, shrinks, reserve, shrink_to_fit) since construction or the last resetCounters().
+	template <typename T, typename Growth, size_t N>
+	size_t DynamicArray<T, Growth, N>::reallocations() const { return reallocCount; }
+
+	/// Get the number of bytes relocated by reallocations since construction or the last resetCounters().
+	template <typename T, typename Growth, size_t N>
+	size_t DynamicArray<T, Growth, N>::bytesCopied() const { return copiedBytes; }
+
+	/// Set reallocation counters to 0.
+	template <typename T, typename Growth, size_t N>
+	void DynamicArray<T, Growth, N>::resetCounters() { reallocCount = copiedBytes = 0; }
+
+
+	// -- SlabArena --------------------------------------
+
+	/// Constructor. No memory is allocated until the first node is requested.
+	template <typename N>
+	SlabArena<N>::SlabArena(size_t firstChunk)
+		: current(0), bump(nullptr), bumpEnd(nullptr), freeSlots(nullptr), firstChunk(firstChunk ? firstChunk : 1), shared(false) { }
+
+	/// Move constructor. The chunks of obj are taken (with the nodes in them), and obj is left without memory.
+	template <typename N>
+	SlabArena<N>::SlabArena(SlabArena&& obj) noexcept
+		: chunks(std::move(obj.chunks)), current(obj.current), bump(obj.bump), bumpEnd(obj.bumpEnd), freeSlots(obj.freeSlots), firstChunk(obj.firstChunk), shared(obj.shared)
+	{
+		obj.chunks.clear();
+		obj.reset();
+	}
+
+	/// Destructor. Returns all chunks to the system (nodes must have been destroyed already).
+	template <typename N>
+	SlabArena<N>::~SlabArena() { release(); }
+
+	/// Move-assignment operator overloading. Our chunks are returned to the system (nodes must have been destroyed already), and the chunks of obj are taken.
+	template <typename N>
+	SlabArena<N>& SlabArena<N>::operator=(SlabArena&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		release();
+
+		chunks = std::move(obj.chunks);
+		current = obj.current;
+		bump = obj.bump;
+		bumpEnd = obj.bumpEnd;
+		freeSlots = obj.freeSlots;
+		firstChunk = obj.firstChunk;
+		shared = obj.shared;
+
+		obj.chunks.clear();
+		obj.reset();
+
+		return *this;
+	}
+
+	/// Move to the next chunk kept by reset(), or allocate a new one (double the size of the last one, up to maxChunkBytes).
+	template <typename N>
+	void SlabArena<N>::nextChunk()
+	{
+		if (current + 1 < chunks.size())
+			current++;
+		else
+		{
+			size_t slots = firstChunk;
+			if (!chunks.empty())
+			{
+				size_t maxSlots = maxChunkBytes / sizeof(Slot) ? maxChunkBytes / sizeof(Slot) : 1;
+				slots = chunks.back().second * 2 < maxSlots ? chunks.back().second * 2 : maxSlots;
+				if (slots < chunks.back().second) slots = chunks.back().second;
+			}
+
+			chunks.reserve(chunks.size() * 2 + 1);   // Reserve first, so push_back cannot throw after "new" (shared_ptr deletes the chunk if it throws)
+			chunks.push_back(std::make_pair(std::shared_ptr<Slot>(new Slot[slots], std::default_delete<Slot[]>()), slots));
+			current = chunks.size() - 1;
+		}
+
+		bump = chunks[current].first.get();
+		bumpEnd = bump + chunks[current].second;
+	}
+
+	/// Get uninitialized storage for one node: a recycled slot if available, otherwise the next unused slot.
+	template <typename N>
+	N* SlabArena<N>::allocate()
+	{
+		Slot* slot;
+
+		if (freeSlots)
+		{
+			slot = freeSlots;
+			freeSlots = freeSlots->next;
+		}
+		else
+		{
+			if (bump == bumpEnd) nextChunk();
+			slot = bump++;
+		}
+
+		return reinterpret_cast<N*>(slot->storage);
+	}
+
+	/// Recycle the storage of a node (already destroyed).
+	template <typename N>
+	void SlabArena<N>::deallocate(N* node)
+	{
+		Slot* slot = reinterpret_cast<Slot*>(node);
+		slot->next = freeSlots;
+		freeSlots = slot;
+	}
+
+	/// Mark all slots as free at once. Nodes still in use must have been destroyed (or be trivially destructible). Chunks shared with other arenas may hold their nodes, so they are dropped instead of reused.
+	template <typename N>
+	void SlabArena<N>::reset()
+	{
+		if (shared)
+		{
+			chunks.erase(std::remove_if(chunks.begin(), chunks.end(),
+				[](const std::pair<std::shared_ptr<Slot>, size_t>& chunk) { return chunk.first.use_count() > 1; }), chunks.end());
+			shared = false;
+		}
+
+		current = 0;
+		freeSlots = nullptr;
+		bump = chunks.empty() ? nullptr : chunks[0].first.get();
+		bumpEnd = chunks.empty() ? nullptr : bump + chunks[0].second;
+	}
+
+	/// Return all chunks to the system.
+	template <typename N>
+	void SlabArena<N>::release()
+	{
+		chunks.clear();   // Chunks still shared with other arenas are kept alive by them
+		reset();
+	}
+
+	/// Take shared ownership of the chunks that obj is using, so the nodes allocated by obj can be moved (relinked) to a structure that uses this arena. A chunk is returned to the system when no arena holds it. New nodes are not carved out of the shared chunks (only our own free slots are recycled).
+	template <typename N>
+	void SlabArena<N>::share(SlabArena& obj)
+	{
+		if (this == &obj || obj.chunks.empty()) return;
+
+		std::vector<const void*> held;   // Chunks we already hold (e.g. after a split-splice round trip) are not added again
+		held.reserve(chunks.size());
+		for (auto& chunk : chunks)
+			held.push_back(chunk.first.get());
+		std::sort(held.begin(), held.end());
+
+		std::vector<std::pair<std::shared_ptr<Slot>, size_t>> added;
+		for (size_t i = 0; i <= obj.current; i++)
+			if (!std::binary_search(held.begin(), held.end(), obj.chunks[i].first.get()))
+				added.push_back(obj.chunks[i]);
+
+		if (chunks.empty())
+		{
+			chunks = std::move(added);
+			current = chunks.size() - 1;   // No room for bump allocation: next allocation gets a new chunk
+			bump = bumpEnd = nullptr;
+		}
+		else
+		{
+			chunks.insert(chunks.begin() + current, added.begin(), added.end());   // Before our current chunk (chunks after it must be unused)
+			current += added.size();
+		}
+
+		shared = obj.shared = true;
+	}
+
+	/// Get the number of slots in all chunks (used or not).
+	template <typename N>
+	size_t SlabArena<N>::capacity() const
+	{
+		size_t slots = 0;
+		for (auto& chunk : chunks)
+			slots += chunk.second;
+
+		return slots;
+	}
+
+
+	// -- NodePool --------------------------------------
+
+	/// Constructor.
+	template <typename N, template <typename> class Alloc>
+	NodePool<N, Alloc>::NodePool(size_t freelistCap)
+		: freelist(nullptr), freeCount(0), freelistCap(freelistCap) { }
+
+	/// Move constructor. The allocator and the freelist of obj are taken.
+	template <typename N, template <typename> class Alloc>
+	NodePool<N, Alloc>::NodePool(NodePool&& obj) noexcept
+		: allocator(std::move(obj.allocator)), freelist(obj.freelist), freeCount(obj.freeCount), freelistCap(obj.freelistCap)
+	{
+		obj.freelist = nullptr;
+		obj.freeCount = 0;
+	}
+
+	/// Destructor. The allocator releases its memory, but the freelist must be given back first if the allocator frees nodes one by one.
+	template <typename N, template <typename> class Alloc>
+	NodePool<N, Alloc>::~NodePool()
+	{
+		if (!bulkRelease) shrink();
+	}
+
+	/// Move-assignment operator overloading. Our storage is given back (live nodes must have been destroyed already), and the allocator and the freelist of obj are taken.
+	template <typename N, template <typename> class Alloc>
+	NodePool<N, Alloc>& NodePool<N, Alloc>::operator=(NodePool&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		if (!bulkRelease) shrink();
+		allocator = std::move(obj.allocator);
+		freelist = obj.freelist;
+		freeCount = obj.freeCount;
+		freelistCap = obj.freelistCap;
+
+		obj.freelist = nullptr;
+		obj.freeCount = 0;
+
+		return *this;
+	}
+
+	/// Get storage for one node: from the freelist, if available, or from the allocator.
+	template <typename N, template <typename> class Alloc>
+	N* NodePool<N, Alloc>::allocate()
+	{
+		if (!freelist)
+			return allocator.allocate();
+
+		FreeSlot* slot = freelist;
+		freelist = freelist->next;
+		freeCount--;
+		slot->~FreeSlot();
+		return reinterpret_cast<N*>(slot);
+	}
+
+	/// Recycle the storage of a destroyed node: keep it in the freelist if it's not full, or give it back to the allocator.
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::deallocate(N* node)
+	{
+		if (freeCount >= freelistCap)
+			return allocator.deallocate(node);
+
+		freelist = new (node) FreeSlot{ freelist };
+		freeCount++;
+	}
+
+	/// Release all nodes at once (if the allocator supports it).
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::reset()
+	{
+		if (!bulkRelease) return;
+
+		freelist = nullptr;
+		freeCount = 0;
+		allocator.reset();
+	}
+
+	/// Give all storage back to the system (live nodes must have been destroyed).
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::release()
+	{
+		shrink();
+		allocator.release();
+	}
+
+	/// Fill the freelist up to "count" nodes, so the next "count" allocations don't call the allocator.
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::reserve(size_t count)
+	{
+		while (freeCount < count)
+		{
+			freelist = new (allocator.allocate()) FreeSlot{ freelist };
+			freeCount++;
+		}
+	}
+
+	/// Give every node in the freelist back to the allocator.
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::shrink()
+	{
+		FreeSlot* slot;
+		while (freelist)
+		{
+			slot = freelist;
+			freelist = freelist->next;
+			slot->~FreeSlot();
+			allocator.deallocate(reinterpret_cast<N*>(slot));
+		}
+
+		freeCount = 0;
+	}
+
+	/// Set the max. number of nodes in the freelist. Nodes over the new cap are given back to the allocator (which may keep them, like SlabArena does).
+	template <typename N, template <typename> class Alloc>
+	void NodePool<N, Alloc>::setFreelistCap(size_t cap)
+	{
+		freelistCap = cap;
+
+		FreeSlot* slot;
+		while (freeCount > freelistCap)
+		{
+			slot = freelist;
+			freelist = freelist->next;
+			freeCount--;
+			slot->~FreeSlot();
+			allocator.deallocate(reinterpret_cast<N*>(slot));
+		}
+	}
+
+	/// Get the max. number of nodes in the freelist.
+	template <typename N, template <typename> class Alloc>
+	size_t NodePool<N, Alloc>::getFreelistCap() const { return freelistCap; }
+
+	/// Get the number of nodes in the freelist.
+	template <typename N, template <typename> class Alloc>
+	size_t NodePool<N, Alloc>::freeNodes() const { return freeCount; }
+
+
+	// -- PositionIndex --------------------------------------
+
+	/// Constructor. The index is empty.
+	template <typename N>
+	PositionIndex<N>::PositionIndex()
+		: header(newEntry(nullptr, maxHeight)), height(1), count(0), seed(2463534242u) { }
+
+	/// Destructor.
+	template <typename N>
+	PositionIndex<N>::~PositionIndex()
+	{
+		clear();
+		deleteEntry(header);
+	}
+
+	/// Allocate an entry and its links (in one block). Links are set to the end of the index.
+	template <typename N>
+	typename PositionIndex<N>::Entry* PositionIndex<N>::newEntry(N* node, size_t height)
+	{
+		Entry* entry = static_cast<Entry*>(::operator new(sizeof(Entry) + height * sizeof(Link)));
+		entry->node = node;
+		entry->height = height;
+
+		Link* links = entry->links();
+		for (size_t i = 0; i < height; i++)
+			new (links + i) Link{ nullptr, 0 };
+
+		return entry;
+	}
+
+	template <typename N>
+	void PositionIndex<N>::deleteEntry(Entry* entry) { ::operator delete(entry); }
+
+	/// Get a random tower height: 1 with probability 3/4, 2 with probability 3/16, etc.
+	template <typename N>
+	size_t PositionIndex<N>::randomHeight()
+	{
+		size_t h = 1;
+		while (h < maxHeight)
+		{
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			if (seed & 3) break;
+			h++;
+		}
+
+		return h;
+	}
+
+	/// Find, in each level, the last entry before position "pos" (update), and its rank (number of positions from the header). Return the entry in position "pos" (or nullptr).
+	template <typename N>
+	typename PositionIndex<N>::Entry* PositionIndex<N>::predecessors(size_t pos, Entry** update, size_t* rank) const
+	{
+		Entry* entry = header;
+		size_t r = 0;
+
+		for (size_t level = height; level-- > 0; )
+		{
+			Link* link = entry->links() + level;
+			while (link->next && r + link->width <= pos)
+			{
+				r += link->width;
+				entry = link->next;
+				link = entry->links() + level;
+			}
+
+			update[level] = entry;
+			rank[level] = r;
+		}
+
+		return update[0]->links()[0].next;
+	}
+
+	/// Get the node in position "pos".
+	template <typename N>
+	N* PositionIndex<N>::at(size_t pos) const
+	{
+		if (pos >= count)
+			throw std::out_of_range("No current element");
+
+		Entry* entry = header;
+		size_t r = 0;   // Rank of entry (header: 0, position i: i + 1)
+
+		for (size_t level = height; level-- > 0; )
+		{
+			Link* link = entry->links() + level;
+			while (link->next && r + link->width <= pos + 1)
+			{
+				r += link->width;
+				entry = link->next;
+				link = entry->links() + level;
+			}
+		}
+
+		return entry->node;
+	}
+
+	/// Insert a node in position "pos" (the nodes from "pos" onwards move one position forward).
+	template <typename N>
+	void PositionIndex<N>::insert(size_t pos, N* node)
+	{
+		if (pos > count)
+			throw std::out_of_range("Pos out of range");
+
+		Entry* update[maxHeight];
+		size_t rank[maxHeight];
+		predecessors(pos, update, rank);
+
+		size_t h = randomHeight();
+		for (; height < h; height++)
+		{
+			update[height] = header;
+			rank[height] = 0;
+			header->links()[height].width = count;
+		}
+
+		Entry* entry = newEntry(node, h);
+		Link* links = entry->links();
+		for (size_t level = 0; level < h; level++)
+		{
+			Link& prevLink = update[level]->links()[level];
+			links[level].next = prevLink.next;
+			links[level].width = prevLink.width - (pos - rank[level]);
+			prevLink.next = entry;
+			prevLink.width = pos - rank[level] + 1;
+		}
+
+		for (size_t level = h; level < height; level++)
+			update[level]->links()[level].width++;
+
+		count++;
+	}
+
+	/// Remove the node in position "pos" from the index (the nodes after it move one position back).
+	template <typename N>
+	void PositionIndex<N>::erase(size_t pos)
+	{
+		if (pos >= count)
+			throw std::out_of_range("Pos out of range");
+
+		Entry* update[maxHeight];
+		size_t rank[maxHeight];
+		Entry* entry = predecessors(pos, update, rank);
+
+		for (size_t level = 0; level < height; level++)
+		{
+			Link& prevLink = update[level]->links()[level];
+			if (prevLink.next == entry)
+			{
+				prevLink.width += entry->links()[level].width - 1;
+				prevLink.next = entry->links()[level].next;
+			}
+			else
+				prevLink.width--;
+		}
+
+		while (height > 1 && header->links()[height - 1].next == nullptr)
+			height--;
+
+		deleteEntry(entry);
+		count--;
+	}
+
+	/// Remove all nodes from the index.
+	template <typename N>
+	void PositionIndex<N>::clear()
+	{
+		Entry* next;
+		for (Entry* entry = header->links()[0].next; entry; entry = next)
+		{
+			next = entry->links()[0].next;
+			deleteEntry(entry);
+		}
+
+		for (size_t level = 0; level < maxHeight; level++)
+			header->links()[level] = Link{ nullptr, 0 };
+
+		height = 1;
+		count = 0;
+	}
+
+	/// Get the number of nodes in the index.
+	template <typename N>
+	size_t PositionIndex<N>::size() const { return count; }
+
+
+	// -- Node --------------------------------------
+
+	/// Constructor.
+	template <typename T>
+	Node<T>::Node() { };
+
+	/// Constructor.
+	template <typename T>
+	Node<T>::Node(T content) : element(content) { };
+
+	/// Constructor. The element is constructed in place from the arguments.
+	template <typename T>
+	template <typename... Args>
+	Node<T>::Node(std::in_place_t, Args&&... args) : element(std::forward<Args>(args)...) { }
+
+	/// Copy constructor.
+	template <typename T>
+	Node<T>::Node(const Node& obj) : element(obj.element) { };
+
+	/// Destructor.
+	template <typename T>
+	Node<T>::~Node() { };
+
+	/// Copy-assignment operator overloading.
+	template <typename T>
+	Node<T>& Node<T>::operator=(const Node& obj) 
+	{ 
+		if (this == &obj) return *this;
+
+		element = obj.element; 
+
+		return *this; 
+	};
+
+
+	// -- SNode --------------------------------------
+
+	/// Constructor. Specify the item (element) and next node.
+	template <typename T>
+	SNode<T>::SNode(const T& content, SNode* nextNode)
+		: Node(content), next(nextNode) { }
+
+	/// Constructor. Specify next node.
+	template <typename T>
+	SNode<T>::SNode(SNode* nextNode)
+		: Node(), next(nextNode) { }
+
+	/// Constructor. Specify next node, and the arguments for constructing the item in place.
+	template <typename T>
+	template <typename... Args>
+	SNode<T>::SNode(std::in_place_t, SNode* nextNode, Args&&... args)
+		: Node(std::in_place, std::forward<Args>(args)...), next(nextNode) { }
+
+	/// Copy constructor. Be careful: The pointer to next node is copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
+	template <typename T>
+	SNode<T>::SNode(const SNode& obj)
+		: Node(obj.element), next(obj.next) { }
+
+	/// Destructor. Linked nodes are not destroyed: the container owns them and releases them iteratively (a recursive destruction overflows the stack in long lists).
+	template <typename T>
+	SNode<T>::~SNode() { }
+
+	/// Copy-assignment operator overloading.
+	template <typename T>
+	SNode<T>& SNode<T>::operator=(const SNode &obj)
+	{
+		if (this == &obj) return *this;
+		
+		(Node&)(*this) = obj;
+		next = obj.next;
+
+		return *this;
+	}
+
+	/// Set all member variables of the node.
+	template <typename T>
+	void SNode<T>::setNode(const T& content, SNode* nextNode)
+	{
+		element = content;
+		next = nextNode;
+	}
+
+
+	// -- DNode --------------------------------------
+
+	/// Constructor. Specify the item (element) and previous and next nodes.
+	template <typename T>
+	DNode<T>::DNode(const T& content, DNode* prevNode, DNode* nextNode)
+		: Node(content), prev(prevNode), next(nextNode) { }
+
+	/// Constructor. Specify previous and next nodes.
+	template <typename T>
+	DNode<T>::DNode(DNode* prevNode, DNode* nextNode)
+		: Node(), prev(prevNode), next(nextNode) { }
+
+	/// Constructor. Specify previous and next nodes, and the arguments for constructing the item in place.
+	template <typename T>
+	template <typename... Args>
+	DNode<T>::DNode(std::in_place_t, DNode* prevNode, DNode* nextNode, Args&&... args)
+		: Node(std::in_place, std::forward<Args>(args)...), prev(prevNode), next(nextNode) { }
+
+	/// Copy constructor. Be careful: The pointers to previous and next node are copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
+	template <typename T>
+	DNode<T>::DNode(const DNode& obj)
+		: Node(obj.element), prev(obj.prev), next(obj.next) { }
+
+	/// Destructor. Linked nodes are not destroyed: the container owns them.
+	template <typename T>
+	DNode<T>::~DNode() { }
+
+	/// Copy-assignment operator overloading.
+	template <typename T>
+	DNode<T>& DNode<T>::operator=(const DNode& obj)
+	{
+		if (this == &obj) return *this;
+		
+		(Node&)(*this) = obj;
+		prev = obj.prev;
+		next = obj.next;
+
+		return *this;
+	}
+	
+	/// Set all member variables of the node.
+	template <typename T>
+	void DNode<T>::setNode(const T& content, DNode* prevNode, DNode* nextNode)
+	{
+		element = content;
+		prev = prevNode;
+		next = nextNode;
+	}
+
+
+	// -- DNodeXor --------------------------------------
+
+	/// Constructor. Specify the item (element) and previous and next nodes.
+	template <typename T>
+	XorNode<T>::XorNode(const T& content, XorNode* prevNode, XorNode* nextNode)
+		: Node(content), npx(XOR(prevNode, nextNode)) { }
+
+	/// Constructor. Specify previous and next nodes.
+	template <typename T>
+	XorNode<T>::XorNode(XorNode* prevNode, XorNode* nextNode)
+		: Node(), npx(XOR(prevNode, nextNode)) { }
+
+	/// Constructor. Specify previous and next nodes, and the arguments for constructing the item in place.
+	template <typename T>
+	template <typename... Args>
+	XorNode<T>::XorNode(std::in_place_t, XorNode* prevNode, XorNode* nextNode, Args&&... args)
+		: Node(std::in_place, std::forward<Args>(args)...), npx(XOR(prevNode, nextNode)) { }
+
+	/// Copy constructor. Be careful: The pointers to previous and next node are copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
+	template <typename T>
+	XorNode<T>::XorNode(const XorNode& obj)
+		: Node(obj.element), npx(nullptr) { }
+
+	/// Destructor. User is responsible for deleting link nodes. XorNode cannot delete any link node by itself because needs user-provided information about a link-node.
+	template <typename T>
+	XorNode<T>::~XorNode() { }
+
+	/// Copy-assignment operator overloading.
+	template <typename T>
+	XorNode<T>& XorNode<T>::operator=(const XorNode& obj)
+	{
+		if (this == &obj) return *this;
+
+		(Node&)(*this) = obj;
+		npx = obj.npx;
+
+		return *this;
+	}
+
+	/// Set all member variables of the node (npx member is set based on the prev and next link nodes).
+	template <typename T>
+	void XorNode<T>::setNode(const T& content, XorNode* prev, XorNode* next)
+	{
+		element = content;
+		npx = XOR(prev, next);
+	}
+
+	/// Set the npx member based on the prev and next link nodes.
+	template <typename T>
+	void XorNode<T>::setNode(XorNode* prev, XorNode* next)
+	{
+		npx = XOR(prev, next);
+	}
+
+	template <typename T>
+	XorNode<T>* XorNode<T>::next(XorNode* prev) { return XOR(npx, prev); }
+
+	template <typename T>
+	XorNode<T>* XorNode<T>::prev(XorNode* next) { return XOR(npx, next); }
+
+	/// XOR operator. Useful for finding out the other link pointer (given x=aXORb, then a=xXORb and b = xXORa)
+	template <typename T>
+	XorNode<T>* XorNode<T>::XOR(XorNode* x, XorNode* a)
+	{
+		return reinterpret_cast<XorNode*>(reinterpret_cast<uintptr_t>(x) ^ reinterpret_cast<uintptr_t>(a));
+	}
+
+
+	// -- SinglyLinkedList --------------------------------------
+
+	/// Constructor.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>::SinglyLinkedList(size_t unusedArg)
+		: pos(0), count(0), index(nullptr)
+	{ 
+		curr = head = tail = &header;
+	}
+
+	/// Constructor. It takes an initialization list.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>::SinglyLinkedList(const std::initializer_list<T>& il)
+		: pos(0), count(0), index(nullptr)
+	{
+		curr = head = tail = &header;
+
+		for(const T& item : il)
+			append(item);
+	}
+
+	/// Copy constructor.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>::SinglyLinkedList(const SinglyLinkedList& obj)
+		: pos(0), count(0), index(nullptr)
+	{
+		curr = head = tail = &header;
+		if (obj.index) enableIndex(true);
+
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The nodes (and the allocator that owns them), the current position and the index are taken from obj, which is left empty.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>::SinglyLinkedList(SinglyLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value)
+		: pos(0), count(0), allocator(std::move(obj.allocator)), index(nullptr)
+	{
+		curr = head = tail = &header;
+		moveFrom(obj);
+	}
+
+	/// Destructor. Delete all nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>::~SinglyLinkedList()
+	{
+		destroyNodes();
+		delete index;
+	}
+
+	/// Copy-assignment operator overloading.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>& SinglyLinkedList<T, Alloc>::operator=(const SinglyLinkedList& obj)
+	{
+		if (this == &obj) return *this;
+		
+		clear();
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. Our nodes are destroyed, and the nodes of obj (and the allocator that owns them), its current position and its index are taken. obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc>& SinglyLinkedList<T, Alloc>::operator=(SinglyLinkedList&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		destroyNodes();
+		delete index;
+		allocator = std::move(obj.allocator);
+		moveFrom(obj);
+
+		return *this;
+	}
+
+	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
+	template <typename T, template <typename> class Alloc>
+	T& SinglyLinkedList<T, Alloc>::operator[](size_t pos) const
+	{
+		if (pos >= count)
+			throw std::out_of_range("No current element");
+
+		if (index)
+			return index->at(pos)->element;
+
+		SNode<T>* nod = head->next;
+		for (size_t i = 0; i < pos; i++)
+			nod = nod->next;
+
+		return nod->element;
+	}
+
+	/// Get memory for a node from the allocator, construct the node (its item is constructed in place from args), and return a pointer to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	SNode<T>* SinglyLinkedList<T, Alloc>::newNode(SNode<T>* nextNode, Args&&... args)
+	{
+		SNode<T>* node = allocator.allocate();
+
+		try { return new (node) SNode<T>(std::in_place, nextNode, std::forward<Args>(args)...); }
+		catch (...) { allocator.deallocate(node); throw; }
+	}
+
+	/// Destroy a node and give its memory back to the allocator.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::deleteNode(SNode<T>* node)
+	{
+		node->~SNode();
+		allocator.deallocate(node);
+	}
+
+	/// Destroy all nodes, except header node (links are not updated). If T is trivially destructible and the allocator can release all nodes at once, nodes are not traversed.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::destroyNodes()
+	{
+		if (!Alloc<SNode<T>>::bulkRelease || !std::is_trivially_destructible<T>::value)
+		{
+			SNode<T>* nextNode;
+			for (SNode<T>* node = head->next; node; node = nextNode)
+			{
+				nextNode = node->next;
+				deleteNode(node);
+			}
+		}
+
+		allocator.reset();
+	}
+
+	/// Append the nodes of another list to this one (empty), and copy its current position.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::copyFrom(const SinglyLinkedList& obj)
+	{
+		for (SNode<T>* node = obj.head->next; node != nullptr; node = node->next)
+		{
+			append(node->element);
+			if (obj.curr == node) curr = tail;
+		}
+
+		pos = obj.pos;
+	}
+
+	/// Take the nodes of obj, its current position and its index (our nodes must have been destroyed, and our allocator replaced with the one of obj). obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::moveFrom(SinglyLinkedList& obj) noexcept
+	{
+		head->next = obj.head->next;
+		tail = obj.tail == obj.head ? head : obj.tail;
+		curr = obj.curr == obj.head ? head : obj.curr;
+		pos = obj.pos;
+		count = obj.count;
+		index = obj.index;
+
+		obj.head->next = nullptr;
+		obj.curr = obj.tail = obj.head;
+		obj.pos = obj.count = 0;
+		obj.index = nullptr;
+	}
+
+	/// Destroy all nodes in the list, except header node.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::clear()
+	{
+		if (count == 0) return;
+
+		destroyNodes();
+		if (index) index->clear();
+		head->next = nullptr;
+
+		curr = tail = head;
+		pos = count = 0;
+	}
+
+	/// Store a new node in the list just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::insert(const T& content) { emplace(content); }
+
+	/// Move a new item into a new node just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::insert(T&& content) { emplace(std::move(content)); }
+
+	/// Construct a new item in place, in a new node just before the current position, and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& SinglyLinkedList<T, Alloc>::emplace(Args&&... args)
+	{
+		SNode<T>* node = newNode(curr->next, std::forward<Args>(args)...);
+		indexNode(pos, node);
+
+		curr->next = node;   // New node inserted after curr (to insert in the head, we use header node)
+		if (tail == curr) tail = node;
+		count++;
+		return node->element;
+	}
+	
+	/// Store a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::append(const T& content) { emplace_back(content); }
+
+	/// Move a new item into a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::append(T&& content) { emplace_back(std::move(content)); }
+
+	/// Construct a new item in place, in a new node at the end of the list (tail), and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& SinglyLinkedList<T, Alloc>::emplace_back(Args&&... args)
+	{
+		SNode<T>* node = newNode(nullptr, std::forward<Args>(args)...);
+		indexNode(count, node);
+
+		tail = tail->next = node;
+		count++;
+		return node->element;
+	}
+
+	/// Remove the current node from the list and destroy it.
+	template <typename T, template <typename> class Alloc>
+	T SinglyLinkedList<T, Alloc>::remove()
+	{	
+		if (curr == tail) throw std::out_of_range("No current element");
+		if (index) index->erase(pos);
+		if (curr->next == tail) tail = curr;
+		
+		SNode<T>* extract = curr->next;
+		T content = std::move(extract->element);
+
+		curr->next = curr->next->next;
+		deleteNode(extract);
+		count--;
+		return content;
+	}
+
+	/// Store the items [first, last) just before the current position, keeping their order (the current node becomes the first of them).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::insertRange(const T* first, const T* last)
+	{
+		while (last != first)
+			insert(*--last);
+	}
+
+	/// Store the items [first, last) at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::appendRange(const T* first, const T* last)
+	{
+		for (; first != last; ++first)
+			append(*first);
+	}
+
+	/// Remove the nodes in positions [pos, pos + count) and destroy them. curr moves to pos.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::removeRange(size_t pos, size_t count)
+	{
+		if (pos > this->count || count > this->count - pos)
+			throw std::out_of_range("Range out of range");
+
+		moveToPos(pos);
+		while (count--)
+			remove();
+	}
+
+	/// Replace the content of the list with the items [first, last). curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::assign(const T* first, const T* last)
+	{
+		clear();
+		appendRange(first, last);
+		moveToStart();
+	}
+
+	/// Get the number of nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	size_t SinglyLinkedList<T, Alloc>::length() const { return count; }
+
+	/// Get the position number of the current node.
+	template <typename T, template <typename> class Alloc>
+	size_t SinglyLinkedList<T, Alloc>::currPos() const { return pos; }
+
+	/// Get the item stored in the current node.
+	template <typename T, template <typename> class Alloc>
+	const T& SinglyLinkedList<T, Alloc>::getValue() const
+	{
+		if (curr == tail)
+			throw std::out_of_range("No current element");
+
+		return curr->next->element;
+	}
+
+	/// Move curr to the header node.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::moveToStart()
+	{
+		curr = head;
+		pos = 0;
+	}
+
+	/// Move curr to the tail (node one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::moveToEnd()
+	{
+		curr = tail;
+		pos = count;
+	}
+
+	/// Move curr to any position from 0 to one-past-the-end. O(distance) from curr when moving forwards (O(1) to the end).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::moveToPos(size_t pos)
+	{
+		if (pos > count)
+			throw std::out_of_range("No current element");
+
+		if (pos == count)
+			return moveToEnd();
+
+		if (index)
+		{
+			curr = pos ? index->at(pos - 1) : head;
+			this->pos = pos;
+			return;
+		}
+
+		if (pos < this->pos)
+			moveToStart();
+
+		for (; this->pos < pos; this->pos++)   // Walk from curr
+			curr = curr->next;
+	}
+
+	/// Move curr to the previous node, except when curr==head.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::prev()
+	{
+		if (curr != head)
+		{
+			if (index)
+				curr = pos > 1 ? index->at(pos - 2) : head;
+			else
+			{
+				SNode<T>* node = head;
+				while (node->next != curr) node = node->next;
+				curr = node;
+			}
+
+			pos--;
+		}
+	}
+
+	/// Move curr to the next node, if it exists (including one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::next()
+	{
+		if (curr != tail)
+		{
+			curr = curr->next;
+			pos++;
+		}
+	}
+	
+
+	/// Add a new node (not linked yet) to the index, in position "pos". If the index cannot grow, the node is deleted.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::indexNode(size_t pos, SNode<T>* node)
+	{
+		if (!index) return;
+
+		try { index->insert(pos, node); }
+		catch (...) { deleteNode(node); throw; }
+	}
+
+	/// Enable or disable the positional index (indexable skip list). With index, operator[] and moveToPos() are O(log n) instead of O(n), but insert(), append() and remove() are O(log n) instead of O(1), and each node uses extra memory for the index.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::enableIndex(bool enable)
+	{
+		if (!enable)
+		{
+			delete index;
+			index = nullptr;
+			return;
+		}
+
+		if (index) return;
+
+		index = new PositionIndex<SNode<T>>();
+		try
+		{
+			size_t i = 0;
+			for (SNode<T>* node = head->next; node; node = node->next)
+				index->insert(i++, node);
+		}
+		catch (...)
+		{
+			delete index;
+			index = nullptr;
+			throw;
+		}
+	}
+
+	/// Check whether the positional index is enabled.
+	template <typename T, template <typename> class Alloc>
+	bool SinglyLinkedList<T, Alloc>::indexed() const { return index != nullptr; }
+
+	/// Add the k nodes that follow curr to the index (if enabled). If the index cannot grow, it's disabled and the exception is rethrown (the list is still valid).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::indexRange(size_t k)
+	{
+		if (!index) return;
+
+		try
+		{
+			SNode<T>* node = curr->next;
+			for (size_t i = 0; i < k; i++, node = node->next)
+				index->insert(pos + i, node);
+		}
+		catch (...)
+		{
+			enableIndex(false);
+			throw;
+		}
+	}
+
+	/// Move all the nodes of obj just before position "pos", keeping their order. Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to pos (the first node moved).
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::spliceAt(size_t pos, SinglyLinkedList& obj)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot splice a list into itself");
+
+		moveToPos(pos);
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		obj.tail->next = curr->next;
+		if (tail == curr) tail = obj.tail;
+		curr->next = obj.head->next;
+		count += obj.count;
+		size_t k = obj.count;
+
+		obj.head->next = nullptr;
+		obj.curr = obj.tail = obj.head;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		indexRange(k);
+	}
+
+	/// Move the nodes from position "pos" to the end to a new list, and return it. Nodes are relinked, not copied (the new list takes shared ownership of the allocator chunks that hold them). curr moves to pos (the end).
+	template <typename T, template <typename> class Alloc>
+	SinglyLinkedList<T, Alloc> SinglyLinkedList<T, Alloc>::splitAt(size_t pos)
+	{
+		moveToPos(pos);
+
+		SinglyLinkedList result;
+		if (index) result.enableIndex(true);
+		if (pos == count) return result;
+
+		result.allocator.share(allocator);
+
+		result.head->next = curr->next;
+		result.tail = tail;
+		result.count = count - pos;
+		curr->next = nullptr;
+		tail = curr;
+		count = pos;
+
+		if (index)
+		{
+			try { result.indexRange(result.count); }
+			catch (...)   // Give the nodes back
+			{
+				tail->next = result.head->next;
+				tail = result.tail;
+				count += result.count;
+				result.head->next = nullptr;
+				result.tail = result.head;
+				result.count = 0;
+				throw;
+			}
+
+			for (size_t i = result.count; i > 0; i--)
+				index->erase(pos + i - 1);
+		}
+
+		return result;
+	}
+
+	/// Merge the nodes of obj into this list. Both must be sorted according to cmp, and so will be the result (equal items of this list go first). Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to the start. cmp must not throw.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void SinglyLinkedList<T, Alloc>::mergeSorted(SinglyLinkedList& obj, Compare cmp)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot merge a list with itself");
+
+		moveToStart();
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		SNode<T>* a = head->next;
+		SNode<T>* b = obj.head->next;
+		SNode<T>* last = head;
+		while (a && b)
+			if (cmp(b->element, a->element))
+			{
+				last = last->next = b;
+				b = b->next;
+			}
+			else
+			{
+				last = last->next = a;
+				a = a->next;
+			}
+
+		if (a) last->next = a;   // The rest of this list is still linked to our tail
+		else
+		{
+			last->next = b;
+			tail = obj.tail;
+		}
+		count += obj.count;
+
+		obj.head->next = nullptr;
+		obj.curr = obj.tail = obj.head;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort the items according to cmp with a bottom-up merge sort. Nodes are relinked, items are never copied or moved. Stable. curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void SinglyLinkedList<T, Alloc>::sort(Compare cmp)
+	{
+		moveToStart();
+		if (count < 2) return;
+
+		head->next = mergeSortChain(head->next, cmp,
+			[](SNode<T>* node) { return node->next; },
+			[](SNode<T>* node, SNode<T>* nextNode) { node->next = nextNode; });
+
+		for (tail = head->next; tail->next; tail = tail->next);
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort through the List interface. cmp is called through std::function.
+	template <typename T, template <typename> class Alloc>
+	void SinglyLinkedList<T, Alloc>::sort(const std::function<bool(const T&, const T&)>& cmp) { sort(std::cref(cmp)); }
+
+
+	// -- DoubleLinkedList --------------------------------------
+
+	/// Constructor.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>::DoubleLinkedList(size_t unusedArg)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->next = tail;
+		tail->prev = head;
+		curr = head;
+	}
+
+	/// Constructor. It takes an initialization list.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>::DoubleLinkedList(const std::initializer_list<T>& il)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->next = tail;
+		tail->prev = head;
+		curr = head;
+
+		for (const T& item : il)
+			append(item);
+	}
+
+	/// Copy constructor.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>::DoubleLinkedList(const DoubleLinkedList& obj)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->next = tail;
+		tail->prev = head;
+		curr = head;
+		if (obj.index) enableIndex(true);
+
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The nodes (and the allocator that owns them), the current position and the index are taken from obj, which is left empty.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>::DoubleLinkedList(DoubleLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value)
+		: pos(0), count(0), allocator(std::move(obj.allocator)), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		moveFrom(obj);
+	}
+
+	/// Destructor. Delete all nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>::~DoubleLinkedList()
+	{
+		destroyNodes();
+		delete index;
+	}
+	
+	/// Copy-assignment operator overloading.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>& DoubleLinkedList<T, Alloc>::operator=(const DoubleLinkedList& obj)
+	{
+		if (this == &obj) return *this;
+		
+		clear();
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. Our nodes are destroyed, and the nodes of obj (and the allocator that owns them), its current position and its index are taken. obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc>& DoubleLinkedList<T, Alloc>::operator=(DoubleLinkedList&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		destroyNodes();
+		delete index;
+		allocator = std::move(obj.allocator);
+		moveFrom(obj);
+
+		return *this;
+	}
+	
+	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
+	template <typename T, template <typename> class Alloc>
+	T& DoubleLinkedList<T, Alloc>::operator[](size_t pos) const
+	{
+		if (pos >= count)
+			throw std::out_of_range("No current element");
+
+		if (index)
+			return index->at(pos)->element;
+
+		DNode<T>* node = head->next;
+		for (size_t i = 0; i < pos; i++)
+			node = node->next;
+
+		return node->element;
+	}
+	
+	/// Get memory for a node from the allocator, construct the node (its item is constructed in place from args), and return a pointer to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	DNode<T>* DoubleLinkedList<T, Alloc>::newNode(DNode<T>* prevNode, DNode<T>* nextNode, Args&&... args)
+	{
+		DNode<T>* node = allocator.allocate();
+
+		try { return new (node) DNode<T>(std::in_place, prevNode, nextNode, std::forward<Args>(args)...); }
+		catch (...) { allocator.deallocate(node); throw; }
+	}
+
+	/// Destroy a node and give its memory back to the allocator.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::deleteNode(DNode<T>* node)
+	{
+		node->~DNode();
+		allocator.deallocate(node);
+	}
+
+	/// Destroy all nodes, except header and tailer nodes (links are not updated). If T is trivially destructible and the allocator can release all nodes at once, nodes are not traversed.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::destroyNodes()
+	{
+		if (!Alloc<DNode<T>>::bulkRelease || !std::is_trivially_destructible<T>::value)
+		{
+			DNode<T>* nextNode;
+			for (DNode<T>* node = head->next; node != tail; node = nextNode)
+			{
+				nextNode = node->next;
+				deleteNode(node);
+			}
+		}
+
+		allocator.reset();
+	}
+
+	/// Append the nodes of another list to this one (empty), and copy its current position.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::copyFrom(const DoubleLinkedList& obj)
+	{
+		for (DNode<T>* node = obj.head->next; node != obj.tail; node = node->next)
+		{
+			append(node->element);
+			if (obj.curr == node) curr = tail->prev;
+		}
+
+		pos = obj.pos;
+	}
+
+	/// Take the nodes of obj, its current position and its index (our nodes must have been destroyed, and our allocator replaced with the one of obj). obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::moveFrom(DoubleLinkedList& obj) noexcept
+	{
+		if (obj.count)
+		{
+			head->next = obj.head->next;
+			tail->prev = obj.tail->prev;
+			head->next->prev = head;
+			tail->prev->next = tail;
+		}
+		else
+		{
+			head->next = tail;
+			tail->prev = head;
+		}
+
+		curr = obj.curr == obj.head ? head : obj.curr;
+		pos = obj.pos;
+		count = obj.count;
+		index = obj.index;
+
+		obj.head->next = obj.tail;
+		obj.tail->prev = obj.head;
+		obj.curr = obj.head;
+		obj.pos = obj.count = 0;
+		obj.index = nullptr;
+	}
+
+	/// Destroy all nodes in the list, except header and tailer nodes.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::clear()
+	{
+		if (count == 0) return;
+
+		destroyNodes();
+		if (index) index->clear();
+
+		head->next = tail;
+		tail->prev = head;
+
+		curr = head;
+		pos = count = 0;
+	}
+
+	/// Store a new node in the list just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::insert(const T& content) { emplace(content); }
+
+	/// Move a new item into a new node just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::insert(T&& content) { emplace(std::move(content)); }
+
+	/// Construct a new item in place, in a new node just before the current position, and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& DoubleLinkedList<T, Alloc>::emplace(Args&&... args)
+	{
+		DNode<T>* node = newNode(curr, curr->next, std::forward<Args>(args)...);
+		indexNode(pos, node);
+
+		curr->next = curr->next->prev = node;
+
+		count++;
+		return node->element;
+	}
+
+	/// Store a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::append(const T& content) { emplace_back(content); }
+
+	/// Move a new item into a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::append(T&& content) { emplace_back(std::move(content)); }
+
+	/// Construct a new item in place, in a new node at the end of the list (tail), and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& DoubleLinkedList<T, Alloc>::emplace_back(Args&&... args)
+	{
+		DNode<T>* node = newNode(tail->prev, tail, std::forward<Args>(args)...);
+		indexNode(count, node);
+
+		tail->prev = tail->prev->next = node;
+		
+		count++;
+		return node->element;
+	}
+
+	/// Remove the current node from the list and destroy it.
+	template <typename T, template <typename> class Alloc>
+	T DoubleLinkedList<T, Alloc>::remove()
+	{
+		if (curr->next == tail) throw std::out_of_range("No current element");
+		if (index) index->erase(pos);
+
+		DNode<T>* extract = curr->next;
+		T content = std::move(extract->element);
+
+		curr->next->next->prev = curr;
+		curr->next = curr->next->next;
+		
+		deleteNode(extract);
+		count--;
+		return content;
+	}
+
+	/// Store the items [first, last) just before the current position, keeping their order (the current node becomes the first of them).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::insertRange(const T* first, const T* last)
+	{
+		while (last != first)
+			insert(*--last);
+	}
+
+	/// Store the items [first, last) at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::appendRange(const T* first, const T* last)
+	{
+		for (; first != last; ++first)
+			append(*first);
+	}
+
+	/// Remove the nodes in positions [pos, pos + count) and destroy them. curr moves to pos.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::removeRange(size_t pos, size_t count)
+	{
+		if (pos > this->count || count > this->count - pos)
+			throw std::out_of_range("Range out of range");
+
+		moveToPos(pos);
+		while (count--)
+			remove();
+	}
+
+	/// Replace the content of the list with the items [first, last). curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::assign(const T* first, const T* last)
+	{
+		clear();
+		appendRange(first, last);
+		moveToStart();
+	}
+
+	/// Get the number of nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	size_t DoubleLinkedList<T, Alloc>::length() const { return count; }
+
+	/// Get the position number of the current node.
+	template <typename T, template <typename> class Alloc>
+	size_t DoubleLinkedList<T, Alloc>::currPos() const { return pos; }
+
+	/// Get the item stored in the current node.
+	template <typename T, template <typename> class Alloc>
+	const T& DoubleLinkedList<T, Alloc>::getValue() const
+	{
+		if (curr == tail->prev)
+			throw std::out_of_range("No current element");
+		
+		return curr->next->element;
+	}
+
+	/// Move curr to the header node.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::moveToStart()
+	{
+		curr = head;
+		pos = 0;
+	}
+
+	/// Move curr to the tail (node one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::moveToEnd()
+	{
+		curr = tail->prev;
+		pos = count;
+	}
+
+	/// Move curr to any position from 0 to one-past-the-end. O(distance) from curr (O(1) to the end).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::moveToPos(size_t pos)
+	{
+		if (pos > count)
+			throw std::out_of_range("No current element");
+
+		if (pos == count)
+			return moveToEnd();
+
+		if (index)
+		{
+			curr = pos ? index->at(pos - 1) : head;
+			this->pos = pos;
+		}
+		else if (pos >= this->pos)   // Walk from curr, forwards or backwards
+			for (; this->pos < pos; this->pos++)
+				curr = curr->next;
+		else
+			for (; this->pos > pos; this->pos--)
+				curr = curr->prev;
+	}
+
+	/// Move curr to the previous node, except when curr==head.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::prev()
+	{
+		if (curr != head)
+		{
+			curr = curr->prev;
+			pos--;
+		}
+	}
+
+	/// Move curr to the next node, if it exists (including one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::next()
+	{
+		if (curr != tail->prev)
+		{
+			curr = curr->next;
+			pos++;
+		}
+	}
+
+	/// Add a new node (not linked yet) to the index, in position "pos". If the index cannot grow, the node is deleted.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::indexNode(size_t pos, DNode<T>* node)
+	{
+		if (!index) return;
+
+		try { index->insert(pos, node); }
+		catch (...) { deleteNode(node); throw; }
+	}
+
+	/// Enable or disable the positional index (indexable skip list). With index, operator[] and moveToPos() are O(log n) instead of O(n), but insert(), append() and remove() are O(log n) instead of O(1), and each node uses extra memory for the index.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::enableIndex(bool enable)
+	{
+		if (!enable)
+		{
+			delete index;
+			index = nullptr;
+			return;
+		}
+
+		if (index) return;
+
+		index = new PositionIndex<DNode<T>>();
+		try
+		{
+			size_t i = 0;
+			for (DNode<T>* node = head->next; node != tail; node = node->next)
+				index->insert(i++, node);
+		}
+		catch (...)
+		{
+			delete index;
+			index = nullptr;
+			throw;
+		}
+	}
+
+	/// Check whether the positional index is enabled.
+	template <typename T, template <typename> class Alloc>
+	bool DoubleLinkedList<T, Alloc>::indexed() const { return index != nullptr; }
+
+	/// Add the k nodes that follow curr to the index (if enabled). If the index cannot grow, it's disabled and the exception is rethrown (the list is still valid).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::indexRange(size_t k)
+	{
+		if (!index) return;
+
+		try
+		{
+			DNode<T>* node = curr->next;
+			for (size_t i = 0; i < k; i++, node = node->next)
+				index->insert(pos + i, node);
+		}
+		catch (...)
+		{
+			enableIndex(false);
+			throw;
+		}
+	}
+
+	/// Move all the nodes of obj just before position "pos", keeping their order. Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to pos (the first node moved).
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::spliceAt(size_t pos, DoubleLinkedList& obj)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot splice a list into itself");
+
+		moveToPos(pos);
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		DNode<T>* first = obj.head->next;
+		DNode<T>* last = obj.tail->prev;
+		last->next = curr->next;
+		curr->next->prev = last;
+		first->prev = curr;
+		curr->next = first;
+		count += obj.count;
+		size_t k = obj.count;
+
+		obj.head->next = obj.tail;
+		obj.tail->prev = obj.head;
+		obj.curr = obj.head;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		indexRange(k);
+	}
+
+	/// Move the nodes from position "pos" to the end to a new list, and return it. Nodes are relinked, not copied (the new list takes shared ownership of the allocator chunks that hold them). curr moves to pos (the end).
+	template <typename T, template <typename> class Alloc>
+	DoubleLinkedList<T, Alloc> DoubleLinkedList<T, Alloc>::splitAt(size_t pos)
+	{
+		moveToPos(pos);
+
+		DoubleLinkedList result;
+		if (index) result.enableIndex(true);
+		if (pos == count) return result;
+
+		result.allocator.share(allocator);
+
+		DNode<T>* first = curr->next;
+		DNode<T>* last = tail->prev;
+		result.head->next = first;
+		first->prev = result.head;
+		result.tail->prev = last;
+		last->next = result.tail;
+		result.count = count - pos;
+		curr->next = tail;
+		tail->prev = curr;
+		count = pos;
+
+		if (index)
+		{
+			try { result.indexRange(result.count); }
+			catch (...)   // Give the nodes back
+			{
+				curr->next = first;
+				first->prev = curr;
+				tail->prev = last;
+				last->next = tail;
+				count += result.count;
+				result.head->next = result.tail;
+				result.tail->prev = result.head;
+				result.count = 0;
+				throw;
+			}
+
+			for (size_t i = result.count; i > 0; i--)
+				index->erase(pos + i - 1);
+		}
+
+		return result;
+	}
+
+	/// Merge the nodes of obj into this list. Both must be sorted according to cmp, and so will be the result (equal items of this list go first). Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to the start. cmp must not throw.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void DoubleLinkedList<T, Alloc>::mergeSorted(DoubleLinkedList& obj, Compare cmp)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot merge a list with itself");
+
+		moveToStart();
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		DNode<T>* a = head->next;
+		DNode<T>* b = obj.head->next;
+		DNode<T>* last = head;
+		while (a != tail && b != obj.tail)
+		{
+			if (cmp(b->element, a->element))
+			{
+				last->next = b;
+				b->prev = last;
+				b = b->next;
+			}
+			else
+			{
+				last->next = a;
+				a->prev = last;
+				a = a->next;
+			}
+			last = last->next;
+		}
+
+		if (a != tail)   // The rest of this list is still linked to our tailer node
+		{
+			last->next = a;
+			a->prev = last;
+		}
+		else
+		{
+			last->next = b;
+			b->prev = last;
+			last = obj.tail->prev;
+			last->next = tail;
+			tail->prev = last;
+		}
+		count += obj.count;
+
+		obj.head->next = obj.tail;
+		obj.tail->prev = obj.head;
+		obj.curr = obj.head;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort the items according to cmp with a bottom-up merge sort. The nodes are sorted as a singly linked chain, and then the prev links are rebuilt. Nodes are relinked, items are never copied or moved. Stable. curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void DoubleLinkedList<T, Alloc>::sort(Compare cmp)
+	{
+		moveToStart();
+		if (count < 2) return;
+
+		tail->prev->next = nullptr;
+		head->next = mergeSortChain(head->next, cmp,
+			[](DNode<T>* node) { return node->next; },
+			[](DNode<T>* node, DNode<T>* nextNode) { node->next = nextNode; });
+
+		DNode<T>* prevNode = head;
+		for (DNode<T>* node = head->next; node; node = node->next)
+		{
+			node->prev = prevNode;
+			prevNode = node;
+		}
+		prevNode->next = tail;
+		tail->prev = prevNode;
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort through the List interface. cmp is called through std::function.
+	template <typename T, template <typename> class Alloc>
+	void DoubleLinkedList<T, Alloc>::sort(const std::function<bool(const T&, const T&)>& cmp) { sort(std::cref(cmp)); }
+
+
+	// -- XorLinkedList --------------------------------------
+
+	/// Constructor.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>::XorLinkedList(size_t unusedArg)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->setNode(nullptr, tail);
+		tail->setNode(head, nullptr);
+		curr = head;
+		currPrev = nullptr;
+	}
+
+	/// Constructor. It takes an initialization list.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>::XorLinkedList(const std::initializer_list<T>& il)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->setNode(nullptr, tail);
+		tail->setNode(head, nullptr);
+		curr = head;
+		currPrev = nullptr;
+
+		for (const T& item : il)
+			append(item);
+	}
+
+	/// Copy constructor.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>::XorLinkedList(const XorLinkedList& obj)
+		: pos(0), count(0), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		head->setNode(nullptr, tail);
+		tail->setNode(head, nullptr);
+		curr = head;
+		currPrev = nullptr;
+		if (obj.index) enableIndex(true);
+
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The nodes (and the allocator that owns them), the current position and the index are taken from obj, which is left empty.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>::XorLinkedList(XorLinkedList&& obj) noexcept(std::is_nothrow_default_constructible<T>::value)
+		: pos(0), count(0), allocator(std::move(obj.allocator)), index(nullptr)
+	{
+		head = &header;
+		tail = &trailer;
+		moveFrom(obj);
+	}
+
+	/// Destructor. Delete all nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>::~XorLinkedList()
+	{
+		destroyNodes();
+		delete index;
+	}
+
+	/// Copy-assignment operator overloading.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>& XorLinkedList<T, Alloc>::operator=(const XorLinkedList<T, Alloc>& obj)
+	{
+		if (this == &obj) return *this;
+
+		clear();
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. Our nodes are destroyed, and the nodes of obj (and the allocator that owns them), its current position and its index are taken. obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc>& XorLinkedList<T, Alloc>::operator=(XorLinkedList&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		destroyNodes();
+		delete index;
+		allocator = std::move(obj.allocator);
+		moveFrom(obj);
+
+		return *this;
+	}
+
+	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
+	template <typename T, template <typename> class Alloc>
+	T& XorLinkedList<T, Alloc>::operator[](size_t pos) const
+	{
+		if (pos >= count)
+			throw std::out_of_range("No current element");
+
+		if (index)
+			return index->at(pos)->element;
+
+		XorNode<T>* temp, *prevNode = head, *node = head->next(nullptr);
+		for (size_t i = 0; i < pos; i++)
+		{
+			temp = node;
+			node = node->next(prevNode);
+			prevNode = temp;
+		}
+		
+		return node->element;
+	}
+
+	/// Get memory for a node from the allocator, construct the node (its item is constructed in place from args), and return a pointer to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	XorNode<T>* XorLinkedList<T, Alloc>::newNode(XorNode<T>* prevNode, XorNode<T>* nextNode, Args&&... args)
+	{
+		XorNode<T>* node = allocator.allocate();
+
+		try { return new (node) XorNode<T>(std::in_place, prevNode, nextNode, std::forward<Args>(args)...); }
+		catch (...) { allocator.deallocate(node); throw; }
+	}
+
+	/// Destroy a node and give its memory back to the allocator.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::deleteNode(XorNode<T>* node)
+	{
+		node->~XorNode();
+		allocator.deallocate(node);
+	}
+
+	/// Destroy all nodes, except header and tailer nodes (links are not updated). If T is trivially destructible and the allocator can release all nodes at once, nodes are not traversed.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::destroyNodes()
+	{
+		if (!Alloc<XorNode<T>>::bulkRelease || !std::is_trivially_destructible<T>::value)
+		{
+			XorNode<T>* nextNode, * prevNode = head;
+			for (XorNode<T>* node = head->next(nullptr); node != tail; node = nextNode)
+			{
+				nextNode = node->next(prevNode);
+				prevNode = node;
+				deleteNode(node);
+			}
+		}
+
+		allocator.reset();
+	}
+
+	/// Append the nodes of another list to this one (empty), and copy its current position.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::copyFrom(const XorLinkedList& obj)
+	{
+		XorNode<T>* temp, * node = obj.head, * prevNode = nullptr;
+		while (node != obj.tail->prev(nullptr))
+		{
+			temp = node;
+			node = node->next(prevNode);
+			prevNode = temp;
+
+			append(node->element);
+			if (obj.curr == node)
+			{
+				curr = tail->prev(nullptr);
+				currPrev = curr->prev(tail);
+			}
+		}
+
+		pos = obj.pos;
+	}
+
+	/// Take the nodes of obj, its current position and its index (our nodes must have been destroyed, and our allocator replaced with the one of obj). obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::moveFrom(XorLinkedList& obj) noexcept
+	{
+		if (obj.count)   // Relink the first and last nodes to our header and tailer nodes
+		{
+			XorNode<T>* first = obj.head->next(nullptr);
+			XorNode<T>* last = obj.tail->prev(nullptr);
+			first->setNode(head, first->next(obj.head));
+			last->setNode(last->prev(obj.tail), tail);
+			head->setNode(nullptr, first);
+			tail->setNode(last, nullptr);
+		}
+		else
+		{
+			head->setNode(nullptr, tail);
+			tail->setNode(head, nullptr);
+		}
+
+		curr = obj.curr == obj.head ? head : obj.curr;
+		currPrev = obj.currPrev == obj.head ? head : obj.currPrev;
+		pos = obj.pos;
+		count = obj.count;
+		index = obj.index;
+
+		obj.head->setNode(nullptr, obj.tail);
+		obj.tail->setNode(obj.head, nullptr);
+		obj.curr = obj.head;
+		obj.currPrev = nullptr;
+		obj.pos = obj.count = 0;
+		obj.index = nullptr;
+	}
+
+	/// Destroy all nodes in the list, except header and tailer nodes.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::clear()
+	{
+		if (count == 0) return;
+
+		destroyNodes();
+		if (index) index->clear();
+
+		head->setNode(nullptr, tail);
+		tail->setNode(head, nullptr);
+
+		curr = head;
+		currPrev = nullptr;
+		pos = count = 0;
+	}
+
+	/// Store a new node in the list just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::insert(const T& content) { emplace(content); }
+
+	/// Move a new item into a new node just before the current position.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::insert(T&& content) { emplace(std::move(content)); }
+
+	/// Construct a new item in place, in a new node just before the current position, and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& XorLinkedList<T, Alloc>::emplace(Args&&... args)
+	{
+		XorNode<T>* nextNode = curr->next(currPrev);
+		XorNode<T>* node = newNode(curr, nextNode, std::forward<Args>(args)...);
+		indexNode(pos, node);
+
+		nextNode->setNode(node, nextNode->next(curr));
+		curr->setNode(currPrev, node);
+
+		count++;
+		return node->element;
+	}
+
+	/// Store a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::append(const T& content) { emplace_back(content); }
+
+	/// Move a new item into a new node at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::append(T&& content) { emplace_back(std::move(content)); }
+
+	/// Construct a new item in place, in a new node at the end of the list (tail), and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& XorLinkedList<T, Alloc>::emplace_back(Args&&... args)
+	{
+		XorNode<T>* prevNode = tail->prev(nullptr);
+		XorNode<T>* node = newNode(prevNode, tail, std::forward<Args>(args)...);
+		indexNode(count, node);
+
+		prevNode->setNode(prevNode->prev(tail), node);
+		tail->setNode(node, nullptr);
+
+		count++;
+		return node->element;
+	}
+
+	/// Remove the current node from the list and destroy it.
+	template <typename T, template <typename> class Alloc>
+	T XorLinkedList<T, Alloc>::remove()
+	{
+		if (curr->next(currPrev) == tail) throw std::out_of_range("No current element");
+		if (index) index->erase(pos);
+
+		XorNode<T>* remNode = curr->next(currPrev);
+		T content = std::move(remNode->element);
+		XorNode<T>* nextNode = remNode->next(curr);
+		
+		curr->setNode(currPrev, nextNode);
+		nextNode->setNode(curr, nextNode->next(remNode));
+
+		deleteNode(remNode);
+		count--;
+		return content;
+	}
+
+	/// Store the items [first, last) just before the current position, keeping their order (the current node becomes the first of them).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::insertRange(const T* first, const T* last)
+	{
+		while (last != first)
+			insert(*--last);
+	}
+
+	/// Store the items [first, last) at the end of the list (tail).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::appendRange(const T* first, const T* last)
+	{
+		for (; first != last; ++first)
+			append(*first);
+	}
+
+	/// Remove the nodes in positions [pos, pos + count) and destroy them. curr moves to pos.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::removeRange(size_t pos, size_t count)
+	{
+		if (pos > this->count || count > this->count - pos)
+			throw std::out_of_range("Range out of range");
+
+		moveToPos(pos);
+		while (count--)
+			remove();
+	}
+
+	/// Replace the content of the list with the items [first, last). curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::assign(const T* first, const T* last)
+	{
+		clear();
+		appendRange(first, last);
+		moveToStart();
+	}
+
+	/// Get the number of nodes in the list.
+	template <typename T, template <typename> class Alloc>
+	size_t XorLinkedList<T, Alloc>::length() const { return count; }
+
+	/// Get the position number of the current node.
+	template <typename T, template <typename> class Alloc>
+	size_t XorLinkedList<T, Alloc>::currPos() const { return pos; }
+
+	/// Get the item stored in the current node.
+	template <typename T, template <typename> class Alloc>
+	const T& XorLinkedList<T, Alloc>::getValue() const
+	{
+		if (curr == tail->prev(nullptr))
+			throw std::out_of_range("No current element");
+
+		return curr->next(currPrev)->element;
+	}
+
+	/// Move curr to the header node.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::moveToStart()
+	{
+		curr = head;
+		currPrev = nullptr;
+		pos = 0;
+	}
+
+	/// Move curr to the tail (node one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::moveToEnd()
+	{
+		curr = tail->prev(nullptr);
+		currPrev = curr->prev(tail);
+		pos = count;
+	}
+
+	/// Move curr to any position from 0 to one-past-the-end. O(distance) from curr when moving forwards (O(1) to the end).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::moveToPos(size_t pos)
+	{
+		if (pos > count)
+			throw std::out_of_range("No current element");
+
+		if (pos == count)
+			return moveToEnd();
+
+		if (index)
+		{
+			curr = pos ? index->at(pos - 1) : head;
+			currPrev = pos > 1 ? index->at(pos - 2) : (pos ? head : nullptr);
+			this->pos = pos;
+			return;
+		}
+
+		if (pos < this->pos)
+			moveToStart();
+
+		XorNode<T>* temp;
+		for (; this->pos < pos; this->pos++)   // Walk from curr
+		{
+			temp = curr;
+			curr = curr->next(currPrev);
+			currPrev = temp;
+		}
+	}
+
+	/// Move curr to the previous node, except when curr==head.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::prev()
+	{
+		if (curr != head)
+		{
+			XorNode<T>* temp = curr;
+			curr = curr->prev(curr->next(currPrev));
+			currPrev = curr->prev(temp);
+			pos--;
+		}
+	}
+
+	/// Move curr to the next node, if it exists (including one-past-the-end).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::next()
+	{
+		if (curr != tail->prev(nullptr))
+		{
+			XorNode<T>* temp = curr;
+			curr = curr->next(currPrev);
+			currPrev = temp;
+			pos++;
+		}
+	}
+
+	/// Add a new node (not linked yet) to the index, in position "pos". If the index cannot grow, the node is deleted.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::indexNode(size_t pos, XorNode<T>* node)
+	{
+		if (!index) return;
+
+		try { index->insert(pos, node); }
+		catch (...) { deleteNode(node); throw; }
+	}
+
+	/// Enable or disable the positional index (indexable skip list). With index, operator[] and moveToPos() are O(log n) instead of O(n), but insert(), append() and remove() are O(log n) instead of O(1), and each node uses extra memory for the index.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::enableIndex(bool enable)
+	{
+		if (!enable)
+		{
+			delete index;
+			index = nullptr;
+			return;
+		}
+
+		if (index) return;
+
+		index = new PositionIndex<XorNode<T>>();
+		try
+		{
+			XorNode<T>* nextNode, * prevNode = head;
+			size_t i = 0;
+			for (XorNode<T>* node = head->next(nullptr); node != tail; node = nextNode)
+			{
+				index->insert(i++, node);
+				nextNode = node->next(prevNode);
+				prevNode = node;
+			}
+		}
+		catch (...)
+		{
+			delete index;
+			index = nullptr;
+			throw;
+		}
+	}
+
+	/// Check whether the positional index is enabled.
+	template <typename T, template <typename> class Alloc>
+	bool XorLinkedList<T, Alloc>::indexed() const { return index != nullptr; }
+
+	/// Add the k nodes that follow curr to the index (if enabled). If the index cannot grow, it's disabled and the exception is rethrown (the list is still valid).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::indexRange(size_t k)
+	{
+		if (!index) return;
+
+		try
+		{
+			XorNode<T>* prevNode = curr;
+			XorNode<T>* node = curr->next(currPrev);
+			for (size_t i = 0; i < k; i++)
+			{
+				index->insert(pos + i, node);
+				XorNode<T>* temp = node;
+				node = node->next(prevNode);
+				prevNode = temp;
+			}
+		}
+		catch (...)
+		{
+			enableIndex(false);
+			throw;
+		}
+	}
+
+	/// Move all the nodes of obj just before position "pos", keeping their order. Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to pos (the first node moved).
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::spliceAt(size_t pos, XorLinkedList& obj)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot splice a list into itself");
+
+		moveToPos(pos);
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		XorNode<T>* nextNode = curr->next(currPrev);
+		XorNode<T>* first = obj.head->next(nullptr);
+		XorNode<T>* last = obj.tail->prev(nullptr);
+		first->setNode(curr, first->next(obj.head));
+		last->setNode(last->prev(obj.tail), nextNode);   // If first == last, its prev is already curr
+		nextNode->setNode(last, nextNode->next(curr));
+		curr->setNode(currPrev, first);
+		count += obj.count;
+		size_t k = obj.count;
+
+		obj.head->setNode(nullptr, obj.tail);
+		obj.tail->setNode(obj.head, nullptr);
+		obj.curr = obj.head;
+		obj.currPrev = nullptr;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		indexRange(k);
+	}
+
+	/// Move the nodes from position "pos" to the end to a new list, and return it. Nodes are relinked, not copied (the new list takes shared ownership of the allocator chunks that hold them). curr moves to pos (the end).
+	template <typename T, template <typename> class Alloc>
+	XorLinkedList<T, Alloc> XorLinkedList<T, Alloc>::splitAt(size_t pos)
+	{
+		moveToPos(pos);
+
+		XorLinkedList result;
+		if (index) result.enableIndex(true);
+		if (pos == count) return result;
+
+		result.allocator.share(allocator);
+
+		XorNode<T>* first = curr->next(currPrev);
+		XorNode<T>* last = tail->prev(nullptr);
+		first->setNode(result.head, first->next(curr));
+		last->setNode(last->prev(tail), result.tail);   // If first == last, its prev is already result.head
+		result.head->setNode(nullptr, first);
+		result.tail->setNode(last, nullptr);
+		result.count = count - pos;
+		curr->setNode(currPrev, tail);
+		tail->setNode(curr, nullptr);
+		count = pos;
+
+		if (index)
+		{
+			try { result.indexRange(result.count); }
+			catch (...)   // Give the nodes back
+			{
+				first->setNode(curr, first->next(result.head));
+				last->setNode(last->prev(result.tail), tail);
+				curr->setNode(currPrev, first);
+				tail->setNode(last, nullptr);
+				count += result.count;
+				result.head->setNode(nullptr, result.tail);
+				result.tail->setNode(result.head, nullptr);
+				result.count = 0;
+				throw;
+			}
+
+			for (size_t i = result.count; i > 0; i--)
+				index->erase(pos + i - 1);
+		}
+
+		return result;
+	}
+
+	/// Merge the nodes of obj into this list. Both must be sorted according to cmp, and so will be the result (equal items of this list go first). Nodes are relinked, not copied (this list takes shared ownership of the allocator chunks that hold them). obj is left empty. curr moves to the start. cmp must not throw.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void XorLinkedList<T, Alloc>::mergeSorted(XorLinkedList& obj, Compare cmp)
+	{
+		if (this == &obj) throw std::invalid_argument("Cannot merge a list with itself");
+
+		moveToStart();
+		if (obj.count == 0) return;
+
+		allocator.share(obj.allocator);
+
+		XorNode<T>* aPrev = head;   // Both runs are walked with their previous nodes. Nodes already merged can be relinked, since runs don't read their links.
+		XorNode<T>* a = head->next(nullptr);
+		XorNode<T>* bPrev = obj.head;
+		XorNode<T>* b = obj.head->next(nullptr);
+		XorNode<T>* lastPrev = nullptr;
+		XorNode<T>* last = head;
+		XorNode<T>* node;
+		while (a != tail && b != obj.tail)
+		{
+			if (cmp(b->element, a->element))
+			{
+				node = b;
+				b = b->next(bPrev);
+				bPrev = node;
+			}
+			else
+			{
+				node = a;
+				a = a->next(aPrev);
+				aPrev = node;
+			}
+
+			last->setNode(lastPrev, node);
+			lastPrev = last;
+			last = node;
+		}
+
+		if (a != tail)   // The rest of this list is still linked to our tailer node
+		{
+			last->setNode(lastPrev, a);
+			a->setNode(last, a->next(aPrev));
+		}
+		else
+		{
+			last->setNode(lastPrev, b);
+			b->setNode(last, b->next(bPrev));
+			last = obj.tail->prev(nullptr);
+			last->setNode(last->prev(obj.tail), tail);
+			tail->setNode(last, nullptr);
+		}
+		count += obj.count;
+
+		obj.head->setNode(nullptr, obj.tail);
+		obj.tail->setNode(obj.head, nullptr);
+		obj.curr = obj.head;
+		obj.currPrev = nullptr;
+		obj.pos = obj.count = 0;
+		if (obj.index) obj.index->clear();
+		obj.allocator.reset();   // Drop the chunks shared with us
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort the items according to cmp with a bottom-up merge sort. The nodes are sorted as a singly linked chain (each link stores only the next node, which is XOR'ed with nullptr), and then the XOR links are rebuilt. Nodes are relinked, items are never copied or moved. Stable. curr moves to the start.
+	template <typename T, template <typename> class Alloc>
+	template <typename Compare>
+	void XorLinkedList<T, Alloc>::sort(Compare cmp)
+	{
+		moveToStart();
+		if (count < 2) return;
+
+		XorNode<T>* first = head->next(nullptr);
+		XorNode<T>* prevNode = head;
+		XorNode<T>* nextNode;
+		for (XorNode<T>* node = first; node != tail; node = nextNode)
+		{
+			nextNode = node->next(prevNode);
+			node->setNode(nullptr, nextNode == tail ? nullptr : nextNode);
+			prevNode = node;
+		}
+
+		first = mergeSortChain(first, cmp,
+			[](XorNode<T>* node) { return node->next(nullptr); },
+			[](XorNode<T>* node, XorNode<T>* nextNode) { node->setNode(nullptr, nextNode); });
+
+		head->setNode(nullptr, first);
+		prevNode = head;
+		for (XorNode<T>* node = first; node; node = nextNode)
+		{
+			nextNode = node->next(nullptr);
+			node->setNode(prevNode, nextNode ? nextNode : tail);
+			prevNode = node;
+		}
+		tail->setNode(prevNode, nullptr);
+		currPrev = nullptr;
+
+		if (index)
+		{
+			index->clear();
+			indexRange(count);
+		}
+	}
+
+	/// Sort through the List interface. cmp is called through std::function.
+	template <typename T, template <typename> class Alloc>
+	void XorLinkedList<T, Alloc>::sort(const std::function<bool(const T&, const T&)>& cmp) { sort(std::cref(cmp)); }
+
+
+	// -- UNode --------------------------------------
+
+	/// Constructor. Specify previous and next nodes. The node is empty.
+	template <typename T, size_t N>
+	UNode<T, N>::UNode(UNode* prevNode, UNode* nextNode)
+		: prev(prevNode), next(nextNode), count(0) { }
+
+	/// Destructor. Destroys the items, but not the linked nodes.
+	template <typename T, size_t N>
+	UNode<T, N>::~UNode()
+	{
+		T* items = elements();
+		for (size_t i = 0; i < count; i++)
+			items[i].~T();
+	}
+
+	/// Get a pointer to the first item of the block.
+	template <typename T, size_t N>
+	T* UNode<T, N>::elements() { return reinterpret_cast<T*>(storage); }
+
+	template <typename T, size_t N>
+	const T* UNode<T, N>::elements() const { return reinterpret_cast<const T*>(storage); }
+
+
+	// -- UnrolledLinkedList --------------------------------------
+
+	/// Constructor. No node is allocated until the first item is stored.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>::UnrolledLinkedList(size_t unusedArg)
+		: head(nullptr), tail(nullptr), curr(nullptr), index(0), pos(0), count(0) { }
+
+	/// Constructor. It takes an initialization list.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>::UnrolledLinkedList(const std::initializer_list<T>& il)
+		: head(nullptr), tail(nullptr), curr(nullptr), index(0), pos(0), count(0)
+	{
+		for (const T& item : il)
+			append(item);
+	}
+
+	/// Copy constructor.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>::UnrolledLinkedList(const UnrolledLinkedList& obj)
+		: head(nullptr), tail(nullptr), curr(nullptr), index(0), pos(0), count(0)
+	{
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The nodes of obj and its current position are taken. obj is left empty, with no node.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>::UnrolledLinkedList(UnrolledLinkedList&& obj) noexcept
+		: head(nullptr), tail(nullptr), curr(nullptr), index(0), pos(0), count(0)
+	{
+		*this = std::move(obj);
+	}
+
+	/// Destructor. Delete all nodes.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>::~UnrolledLinkedList()
+	{
+		UNode<T, N>* nextNode;
+		for (UNode<T, N>* node = head; node; node = nextNode)
+		{
+			nextNode = node->next;
+			delete node;
+		}
+	}
+
+	/// Copy-assignment operator overloading.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>& UnrolledLinkedList<T, N>::operator=(const UnrolledLinkedList& obj)
+	{
+		if (this == &obj) return *this;
+
+		clear();
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. The nodes and the current position are swapped with those of obj.
+	template <typename T, size_t N>
+	UnrolledLinkedList<T, N>& UnrolledLinkedList<T, N>::operator=(UnrolledLinkedList&& obj) noexcept
+	{
+		std::swap(head, obj.head);
+		std::swap(tail, obj.tail);
+		std::swap(curr, obj.curr);
+		std::swap(index, obj.index);
+		std::swap(pos, obj.pos);
+		std::swap(count, obj.count);
+
+		return *this;
+	}
+
+	/// Subscript operator overloading. The current position is not changed.
+	template <typename T, size_t N>
+	T& UnrolledLinkedList<T, N>::operator[](size_t i) const
+	{
+		if (i >= count)
+			throw std::out_of_range("No current element");
+
+		UNode<T, N>* node = head;
+		while (i >= node->count)
+		{
+			i -= node->count;
+			node = node->next;
+		}
+
+		return node->elements()[i];
+	}
+
+	/// Append the items of another list to this one (empty), and copy its current position.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::copyFrom(const UnrolledLinkedList& obj)
+	{
+		for (UNode<T, N>* node = obj.head; node; node = node->next)
+			appendRange(node->elements(), node->elements() + node->count);
+
+		moveToPos(obj.pos);
+	}
+
+	/// Move the upper half of a full node to a new node inserted after it. The cursor is kept on the same item.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::split(UNode<T, N>* node)
+	{
+		UNode<T, N>* newNode = new UNode<T, N>(node, node->next);
+		size_t half = node->count / 2;
+		T* from = node->elements() + half;
+		T* to = newNode->elements();
+
+		for (size_t i = 0; i < node->count - half; i++)
+		{
+			new (to + i) T(std::move(from[i]));
+			newNode->count++;
+		}
+		for (size_t i = 0; i < newNode->count; i++)
+			from[i].~T();
+		node->count = half;
+
+		if (node->next) node->next->prev = newNode;
+		else tail = newNode;
+		node->next = newNode;
+
+		if (curr == node && index >= half)
+		{
+			curr = newNode;
+			index -= half;
+		}
+	}
+
+	/// Move all the items of the node after "node" into "node", and delete the next node. The cursor is kept on the same item.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::merge(UNode<T, N>* node)
+	{
+		UNode<T, N>* nextNode = node->next;
+		T* from = nextNode->elements();
+		T* to = node->elements() + node->count;
+
+		if (curr == nextNode)
+		{
+			curr = node;
+			index += node->count;
+		}
+
+		for (size_t i = 0; i < nextNode->count; i++)
+		{
+			new (to + i) T(std::move(from[i]));
+			node->count++;
+		}
+		for (size_t i = 0; i < nextNode->count; i++)
+			from[i].~T();
+		nextNode->count = 0;
+
+		unlink(nextNode);
+	}
+
+	/// Unlink and delete a node. The list must have more than one node, and the cursor must not be in this node.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::unlink(UNode<T, N>* node)
+	{
+		if (node->prev) node->prev->next = node->next;
+		else head = node->next;
+
+		if (node->next) node->next->prev = node->prev;
+		else tail = node->prev;
+
+		delete node;
+	}
+
+	/// If the cursor is one-past-the-end of a node that is not the tail, move it to the first item of the next node.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::normalize()
+	{
+		if (index == curr->count && curr != tail)
+		{
+			curr = curr->next;
+			index = 0;
+		}
+	}
+
+	/// Check whether [first, last) overlaps the storage of any node.
+	template <typename T, size_t N>
+	bool UnrolledLinkedList<T, N>::overlaps(const T* first, const T* last) const
+	{
+		std::less<const T*> less;
+		for (UNode<T, N>* node = head; node; node = node->next)
+			if (less(first, node->elements() + N) && less(node->elements(), last))
+				return true;
+
+		return false;
+	}
+
+	/// Destroy all items and delete all nodes except the first one.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::clear()
+	{
+		if (!head) return;
+
+		UNode<T, N>* nextNode;
+		for (UNode<T, N>* node = head->next; node; node = nextNode)
+		{
+			nextNode = node->next;
+			delete node;
+		}
+
+		T* items = head->elements();
+		for (size_t i = 0; i < head->count; i++)
+			items[i].~T();
+
+		head->count = 0;
+		head->next = nullptr;
+		curr = tail = head;
+		index = pos = count = 0;
+	}
+
+	/// Store a new item just before the current position. If the current node is full, it's split first.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::insert(const T& item) { emplace(item); }
+
+	/// Move a new item just before the current position. If the current node is full, it's split first.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::insert(T&& item) { emplace(std::move(item)); }
+
+	/// Construct a new item from args just before the current position, and return a reference to it. If the current node is full, it's split first.
+	template <typename T, size_t N>
+	template <typename... Args>
+	T& UnrolledLinkedList<T, N>::emplace(Args&&... args)
+	{
+		if (!head || (curr == tail && index == N))   // One-past-the-end of a full tail: start a new node instead of splitting
+			return emplace_back(std::forward<Args>(args)...);
+
+		T content(std::forward<Args>(args)...);   // args may refer to items stored in this list
+		if (curr->count == N) split(curr);
+
+		T* items = curr->elements();
+		if (index == curr->count)
+			new (items + index) T(std::move(content));
+		else
+		{
+			new (items + curr->count) T(std::move(items[curr->count - 1]));
+			std::move_backward(items + index, items + curr->count - 1, items + curr->count);
+			items[index] = std::move(content);
+		}
+
+		curr->count++;
+		count++;
+		return items[index];
+	}
+
+	/// Store a new item at the end of the list. If the last node is full, a new node is added.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::append(const T& item) { emplace_back(item); }
+
+	/// Move a new item to the end of the list. If the last node is full, a new node is added.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::append(T&& item) { emplace_back(std::move(item)); }
+
+	/// Construct a new item from args at the end of the list, and return a reference to it. If the last node is full (or there is no node yet), a new node is added.
+	template <typename T, size_t N>
+	template <typename... Args>
+	T& UnrolledLinkedList<T, N>::emplace_back(Args&&... args)
+	{
+		T* item;
+		if (!tail || tail->count == N)
+		{
+			T content(std::forward<Args>(args)...);   // args may refer to items stored in this list
+			UNode<T, N>* newNode = new UNode<T, N>(tail, nullptr);
+			if (tail) tail->next = newNode;
+			else curr = head = newNode;
+			tail = newNode;
+			item = new (newNode->elements()) T(std::move(content));
+		}
+		else
+			item = new (tail->elements() + tail->count) T(std::forward<Args>(args)...);
+
+		tail->count++;
+		count++;
+		normalize();
+		return *item;
+	}
+
+	/// Remove the current item and return it. If its node gets less than half full, it's merged with the next node (if they fit in one node), and empty nodes are deleted.
+	template <typename T, size_t N>
+	T UnrolledLinkedList<T, N>::remove()
+	{
+		if (!curr || index == curr->count) throw std::out_of_range("No current element");
+
+		T* items = curr->elements();
+		T content = std::move(items[index]);
+		std::move(items + index + 1, items + curr->count, items + index);
+		items[curr->count - 1].~T();
+		curr->count--;
+		count--;
+
+		if (curr->count == 0 && curr != tail)
+		{
+			UNode<T, N>* node = curr;
+			curr = curr->next;
+			index = 0;
+			unlink(node);
+		}
+		else if (curr->count == 0 && curr != head)
+		{
+			UNode<T, N>* node = curr;
+			curr = curr->prev;
+			index = curr->count;
+			unlink(node);
+		}
+		else if (curr->count < N / 2 && curr->next && curr->count + curr->next->count <= N)
+			merge(curr);
+
+		normalize();
+		return content;
+	}
+
+	/// Store the items [first, last) just before the current position, keeping their order (the current item becomes the first of them).
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::insertRange(const T* first, const T* last)
+	{
+		if (overlaps(first, last))
+		{
+			std::vector<T> temp(first, last);
+			return insertRange(temp.data(), temp.data() + temp.size());
+		}
+
+		while (last != first)
+			insert(*--last);
+	}
+
+	/// Store the items [first, last) at the end of the list.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::appendRange(const T* first, const T* last)
+	{
+		for (; first != last; ++first)
+			append(*first);
+	}
+
+	/// Remove the items in positions [pos, pos + count). The current position moves to pos.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::removeRange(size_t pos, size_t count)
+	{
+		if (pos > this->count || count > this->count - pos)
+			throw std::out_of_range("Range out of range");
+
+		moveToPos(pos);
+		while (count--)
+			remove();
+	}
+
+	/// Replace the content of the list with the items [first, last). The current position moves to the start.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::assign(const T* first, const T* last)
+	{
+		if (overlaps(first, last))
+		{
+			std::vector<T> temp(first, last);
+			return assign(temp.data(), temp.data() + temp.size());
+		}
+
+		clear();
+		appendRange(first, last);
+		moveToStart();
+	}
+
+	/// Get the number of items in the list.
+	template <typename T, size_t N>
+	size_t UnrolledLinkedList<T, N>::length() const { return count; }
+
+	/// Get the position of the current item.
+	template <typename T, size_t N>
+	size_t UnrolledLinkedList<T, N>::currPos() const { return pos; }
+
+	/// Get the current item.
+	template <typename T, size_t N>
+	const T& UnrolledLinkedList<T, N>::getValue() const
+	{
+		if (!curr || index == curr->count)
+			throw std::out_of_range("No current element");
+
+		return curr->elements()[index];
+	}
+
+	/// Move the cursor to the first item.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::moveToStart()
+	{
+		curr = head;
+		index = pos = 0;
+	}
+
+	/// Move the cursor to one-past-the-end.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::moveToEnd()
+	{
+		curr = tail;
+		index = (tail ? tail->count : 0);
+		pos = count;
+	}
+
+	/// Move the cursor to any position from 0 to one-past-the-end.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::moveToPos(size_t pos)
+	{
+		if (pos > count)
+			throw std::out_of_range("No current element");
+
+		this->pos = pos;
+		curr = head;
+		while (curr != tail && pos >= curr->count)
+		{
+			pos -= curr->count;
+			curr = curr->next;
+		}
+
+		index = pos;
+	}
+
+	/// Move the cursor to the previous item, except at the start.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::prev()
+	{
+		if (pos == 0) return;
+
+		if (index == 0)
+		{
+			curr = curr->prev;
+			index = curr->count;
+		}
+
+		index--;
+		pos--;
+	}
+
+	/// Move the cursor to the next item, if it exists (including one-past-the-end).
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::next()
+	{
+		if (pos == count) return;
+
+		index++;
+		pos++;
+		normalize();
+	}
+
+	/// Sort the items according to cmp. Items are moved to a contiguous buffer, sorted there with introsort (cache-friendly), and moved back into the same nodes. Not stable. If cmp throws, some items may be left moved-from (as with std::sort). curr moves to the start.
+	template <typename T, size_t N>
+	template <typename Compare>
+	void UnrolledLinkedList<T, N>::sort(Compare cmp)
+	{
+		moveToStart();
+		if (count < 2) return;
+
+		std::vector<T> items;
+		items.reserve(count);
+		for (UNode<T, N>* node = head; node; node = node->next)
+			for (size_t i = 0; i < node->count; i++)
+				items.push_back(std::move(node->elements()[i]));
+
+		introsort(items.data(), items.data() + items.size(), cmp);
+
+		size_t k = 0;
+		for (UNode<T, N>* node = head; node; node = node->next)
+			for (size_t i = 0; i < node->count; i++)
+				node->elements()[i] = std::move(items[k++]);
+	}
+
+	/// Sort through the List interface. cmp is called through std::function.
+	template <typename T, size_t N>
+	void UnrolledLinkedList<T, N>::sort(const std::function<bool(const T&, const T&)>& cmp) { sort(std::cref(cmp)); }
+
+
+	// -- SArrayStack --------------------------------------
+
+	/// Constructor.
+	template<typename T>
+	SArrayStack<T>::SArrayStack(size_t size)
+		: Stack(), array(new T[size]), capacity(size), top(0) { }
+
+	/// Copy constructor.
+	template<typename T>
+	SArrayStack<T>::SArrayStack(const SArrayStack& obj)
+		: Stack(obj)
+	{
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (capacity 0).
+	template<typename T>
+	SArrayStack<T>::SArrayStack(SArrayStack&& obj) noexcept
+		: Stack(), array(obj.array), capacity(obj.capacity), top(obj.top)
+	{
+		obj.array = nullptr;
+		obj.capacity = obj.top = 0;
+	}
+
+	/// Destructor.
+	template<typename T>
+	SArrayStack<T>::~SArrayStack() { delete[] array; }
+
+	/// Make the object a copy of another.
+	template<typename T>
+	void SArrayStack<T>::copyFrom(const SArrayStack& obj)
+	{
+		array = new T[obj.capacity];
+		capacity = obj.capacity;
+		top = obj.top;
+		
+		for (size_t i = 0; i < top; i++)
+			array[i] = obj.array[i];
+	}
+
+	/// Copy-assignment operator overloading.
+	template <typename T>
+	SArrayStack<T>& SArrayStack<T>::operator=(const SArrayStack& obj)
+	{
+		if (this == &obj) return *this;
+
+		if (array) delete[] array;
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename T>
+	SArrayStack<T>& SArrayStack<T>::operator=(SArrayStack&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		delete[] array;
+
+		array = obj.array;
+		capacity = obj.capacity;
+		top = obj.top;
+
+		obj.array = nullptr;
+		obj.capacity = obj.top = 0;
+
+		return *this;
+	}
+
+	/// Remove all elements.
+	template<typename T>
+	void SArrayStack<T>::clear() { top = 0; }
+
+	/// Insert new element at the top.
+	template<typename T>
+	void SArrayStack<T>::push(const T& newElement)
+	{
+		if(top == capacity) throw std::out_of_range("Stack is full");
+
+		array[top++] = newElement;
+	}
+
+	/// Move new element to the top.
+	template<typename T>
+	void SArrayStack<T>::push(T&& newElement)
+	{
+		if(top == capacity) throw std::out_of_range("Stack is full");
+
+		array[top++] = std::move(newElement);
+	}
+
+	/// Construct a new element from args at the top, and return a reference to it. Slots are already constructed, so the element is move-assigned into its slot.
+	template<typename T>
+	template <typename... Args>
+	T& SArrayStack<T>::emplace(Args&&... args)
+	{
+		if(top == capacity) throw std::out_of_range("Stack is full");
+
+		array[top] = T(std::forward<Args>(args)...);
+		return array[top++];
+	}
+
+	/// Extract top element
+	template<typename T>
+	T SArrayStack<T>::pop()
+	{
+		if(top == 0) throw std::out_of_range("Stack is empty");
+		
+		return std::move(array[--top]);
+	}
+
+	/// Get top element
+	template<typename T>
+	const T& SArrayStack<T>::topValue() const
+	{
+		if(top == 0) throw std::out_of_range("Stack is empty");
+
+		return array[top - 1];
+	}
+
+	/// Get number of active elements.
+	template<typename T>
+	size_t SArrayStack<T>::length() const { return top; }
+
+
+	// -- DArrayStack --------------------------------------
+
+	/// Constructor. Reserve room for "capacity" elements (like reserve(), capacity won't shrink below it).
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>::DArrayStack(size_t capacity)
+		: array(ArrayStorage<T>::allocate(capacity)), capacity(capacity), top(0), shrinkThreshold(0.25f), reservedCapacity(capacity) { }
+
+	/// Copy constructor. Capacity of the copy is the number of elements (nothing reserved).
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>::DArrayStack(const DArrayStack& obj)
+		: array(ArrayStorage<T>::allocate(obj.top)), capacity(obj.top), top(0), shrinkThreshold(obj.shrinkThreshold), reservedCapacity(0)
+	{
+		try { std::uninitialized_copy(obj.array, obj.array + obj.top, array); }
+		catch (...)
+		{
+			ArrayStorage<T>::deallocate(array);
+			throw;
+		}
+
+		top = obj.top;
+	}
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (no array).
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>::DArrayStack(DArrayStack&& obj) noexcept
+		: array(obj.array), capacity(obj.capacity), top(obj.top), shrinkThreshold(obj.shrinkThreshold), reservedCapacity(obj.reservedCapacity)
+	{
+		obj.array = nullptr;
+		obj.capacity = obj.top = obj.reservedCapacity = 0;
+	}
+
+	/// Destructor
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>::~DArrayStack()
+	{
+		ArrayStorage<T>::destroy(array, array + top);
+		ArrayStorage<T>::deallocate(array);
+	}
+
+	/// Copy-assignment operator overloading. If a copy throws, this stack is not modified.
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>& DArrayStack<T, Growth>::operator=(const DArrayStack& obj)
+	{
+		if (this == &obj) return *this;
+
+		DArrayStack copy(obj);
+		return *this = std::move(copy);
+	}
+
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (no array).
+	template <typename T, typename Growth>
+	DArrayStack<T, Growth>& DArrayStack<T, Growth>::operator=(DArrayStack&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		ArrayStorage<T>::destroy(array, array + top);
+		ArrayStorage<T>::deallocate(array);
+
+		array = obj.array;
+		capacity = obj.capacity;
+		top = obj.top;
+		shrinkThreshold = obj.shrinkThreshold;
+		reservedCapacity = obj.reservedCapacity;
+
+		obj.array = nullptr;
+		obj.capacity = obj.top = obj.reservedCapacity = 0;
+
+		return *this;
+	}
+
+	/// Move the elements to a new array with newCapacity slots (>= top).
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::reallocate(size_t newCapacity)
+	{
+		T* newArray = ArrayStorage<T>::allocate(newCapacity);
+		ArrayStorage<T>::relocate(array, top, newArray);
+		ArrayStorage<T>::deallocate(array);
+
+		array = newArray;
+		capacity = newCapacity;
+	}
+
+	/// Reduce capacity if top <= capacity * shrinkThreshold (but not below minCapacity or the reserved capacity). Called after removing elements, so it doesn't throw: if the smaller array can't be allocated, the current one is kept.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::shrink() noexcept
+	{
+		size_t floor = reservedCapacity > minCapacity ? reservedCapacity : minCapacity;
+		if (capacity <= floor || top > capacity * shrinkThreshold) return;
+
+		size_t newCapacity = std::max(top ? Growth::grow(top, sizeof(T)) : 0, floor);
+		if (newCapacity < capacity)
+		{
+			try { reallocate(newCapacity); }
+			catch (const std::bad_alloc&) { }   // Nothing was moved yet: keep the current array
+		}
+	}
+
+	/// Construct a new element from args at the top of a full stack. The new element is constructed in the new array before relocating the others, so args may refer to an element of this stack.
+	template <typename T, typename Growth>
+	template <typename... Args>
+	T& DArrayStack<T, Growth>::emplaceGrow(Args&&... args)
+	{
+		size_t newCapacity = Growth::grow(capacity, sizeof(T));
+		T* newArray = ArrayStorage<T>::allocate(newCapacity);
+
+		try { new (newArray + top) T(std::forward<Args>(args)...); }
+		catch (...)
+		{
+			ArrayStorage<T>::deallocate(newArray);
+			throw;
+		}
+
+		ArrayStorage<T>::relocate(array, top, newArray);
+		ArrayStorage<T>::deallocate(array);
+
+		array = newArray;
+		capacity = newCapacity;
+		return array[top++];
+	}
+
+	/// Remove all elements. Capacity is kept.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::clear()
+	{
+		ArrayStorage<T>::destroy(array, array + top);
+		top = 0;
+	}
+
+	/// Insert new element at the top.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::push(const T& newElement) { emplace(newElement); }
+
+	/// Move new element to the top.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::push(T&& newElement) { emplace(std::move(newElement)); }
+
+	/// Construct a new element from args at the top, and return a reference to it.
+	template <typename T, typename Growth>
+	template <typename... Args>
+	T& DArrayStack<T, Growth>::emplace(Args&&... args)
+	{
+		if (top == capacity) return emplaceGrow(std::forward<Args>(args)...);
+
+		new (array + top) T(std::forward<Args>(args)...);
+		return array[top++];
+	}
+
+	/// Extract top element. Capacity may shrink.
+	template <typename T, typename Growth>
+	T DArrayStack<T, Growth>::pop()
+	{
+		if (!top) throw std::out_of_range("Stack is empty");
+
+		T item = std::move(array[--top]);
+		array[top].~T();
+
+		shrink();
+		return item;
+	}
+
+	/// Get top element
+	template <typename T, typename Growth>
+	const T& DArrayStack<T, Growth>::topValue() const
+	{
+		if (!top) throw std::out_of_range("Stack is empty");
+
+		return array[top - 1];
+	}
+
+	/// Get number of elements.
+	template <typename T, typename Growth>
+	size_t DArrayStack<T, Growth>::length() const { return top; }
+
+	/// Push "count" elements from [first, first + count), in order (the last one ends at the top). Capacity grows once (at most), and the elements are copied as a single span. If a copy throws, the stack is not modified.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::pushN(const T* first, size_t count)
+	{
+		if (top + count > capacity)
+		{
+			if (std::less_equal<const T*>()(array, first) && std::less<const T*>()(first, array + top))   // Source inside our array: copy it before reallocating
+			{
+				std::vector<T> temp(first, first + count);
+				pushN(temp.data(), count);
+				return;
+			}
+
+			reallocate(std::max(top + count, Growth::grow(capacity, sizeof(T))));
+		}
+
+		std::uninitialized_copy(first, first + count, array + top);
+		top += count;
+	}
+
+	/// Pop up to "count" elements into [dest, dest + count) (move-assignment), in the order pop() would return them (the top one first). Returns the number of elements extracted.
+	template <typename T, typename Growth>
+	size_t DArrayStack<T, Growth>::popN(T* dest, size_t count)
+	{
+		count = std::min(count, top);
+
+		for (size_t i = 0; i < count; i++)
+			dest[i] = std::move(array[top - 1 - i]);
+
+		ArrayStorage<T>::destroy(array + top - count, array + top);
+		top -= count;
+
+		shrink();
+		return count;
+	}
+
+	/// Make room for at least newCapacity elements. Pops won't shrink the stack below it (until shrink_to_fit()).
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::reserve(size_t newCapacity)
+	{
+		if (newCapacity > capacity)
+			reallocate(newCapacity);
+
+		if (newCapacity > reservedCapacity)
+			reservedCapacity = newCapacity;
+	}
+
+	/// Release the unused capacity (capacity becomes the number of elements). The reserved capacity is dropped too.
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::shrink_to_fit()
+	{
+		reservedCapacity = 0;
+		if (capacity > top)
+			reallocate(top);
+	}
+
+	/// Set the fraction of capacity at or below which the stack shrinks after a pop (default: 0.25). Use 0 to shrink only when empty, or a negative value to never shrink. For hysteresis, keep it below 1/(growth factor).
+	template <typename T, typename Growth>
+	void DArrayStack<T, Growth>::setShrinkThreshold(float threshold) { shrinkThreshold = threshold; }
+
+	/// Get the number of elements the stack can hold without reallocating.
+	template <typename T, typename Growth>
+	size_t DArrayStack<T, Growth>::getCapacity() const { return capacity; }
+
+
+	// -- DoubleSArrayStack --------------------------------------
+
+	/// Constructor. "size" is the combined capacity of both stacks.
+	template <typename T>
+	DoubleSArrayStack<T>::DoubleSArrayStack(size_t size)
+		: array(ArrayStorage<T>::allocate(size)), capacity(size), leftTop(0), rightTop(size), leftEnd(this, Side::LEFT), rightEnd(this, Side::RIGHT) { }
+
+	/// Copy constructor.
+	template <typename T>
+	DoubleSArrayStack<T>::DoubleSArrayStack(const DoubleSArrayStack& obj)
+		: array(nullptr), capacity(0), leftTop(0), rightTop(0), leftEnd(this, Side::LEFT), rightEnd(this, Side::RIGHT)
+	{
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename T>
+	DoubleSArrayStack<T>::DoubleSArrayStack(DoubleSArrayStack&& obj) noexcept
+		: array(obj.array), capacity(obj.capacity), leftTop(obj.leftTop), rightTop(obj.rightTop), leftEnd(this, Side::LEFT), rightEnd(this, Side::RIGHT)
+	{
+		obj.array = nullptr;
+		obj.capacity = obj.leftTop = obj.rightTop = 0;
+	}
+
+	/// Destructor.
+	template <typename T>
+	DoubleSArrayStack<T>::~DoubleSArrayStack()
+	{
+		clear();
+		ArrayStorage<T>::deallocate(array);
+	}
+
+	/// Make the object (with no array) a copy of another. If a copy throws, the object is left with no array.
+	template <typename T>
+	void DoubleSArrayStack<T>::copyFrom(const DoubleSArrayStack& obj)
+	{
+		T* newArray = ArrayStorage<T>::allocate(obj.capacity);
+
+		try { std::uninitialized_copy(obj.array, obj.array + obj.leftTop, newArray); }
+		catch (...)
+		{
+			ArrayStorage<T>::deallocate(newArray);
+			throw;
+		}
+
+		try { std::uninitialized_copy(obj.array + obj.rightTop, obj.array + obj.capacity, newArray + obj.rightTop); }
+		catch (...)
+		{
+			ArrayStorage<T>::destroy(newArray, newArray + obj.leftTop);
+			ArrayStorage<T>::deallocate(newArray);
+			throw;
+		}
+
+		array = newArray;
+		capacity = obj.capacity;
+		leftTop = obj.leftTop;
+		rightTop = obj.rightTop;
+	}
+
+	/// Copy-assignment operator overloading. If a copy throws, this object is not modified.
+	template <typename T>
+	DoubleSArrayStack<T>& DoubleSArrayStack<T>::operator=(const DoubleSArrayStack& obj)
+	{
+		if (this == &obj) return *this;
+
+		DoubleSArrayStack copy(obj);
+		return *this = std::move(copy);
+	}
+
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename T>
+	DoubleSArrayStack<T>& DoubleSArrayStack<T>::operator=(DoubleSArrayStack&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		clear();
+		ArrayStorage<T>::deallocate(array);
+
+		array = obj.array;
+		capacity = obj.capacity;
+		leftTop = obj.leftTop;
+		rightTop = obj.rightTop;
+
+		obj.array = nullptr;
+		obj.capacity = obj.leftTop = obj.rightTop = 0;
+
+		return *this;
+	}
+
+	/// Remove all elements of both stacks.
+	template <typename T>
+	void DoubleSArrayStack<T>::clear()
+	{
+		clear(Side::LEFT);
+		clear(Side::RIGHT);
+	}
+
+	/// Remove all elements of one stack.
+	template <typename T>
+	void DoubleSArrayStack<T>::clear(Side side)
+	{
+		if (side == Side::LEFT)
+		{
+			ArrayStorage<T>::destroy(array, array + leftTop);
+			leftTop = 0;
+		}
+		else
+		{
+			ArrayStorage<T>::destroy(array + rightTop, array + capacity);
+			rightTop = capacity;
+		}
+	}
+
+	/// Insert new element at the top of one stack.
+	template <typename T>
+	void DoubleSArrayStack<T>::push(Side side, const T& newElement) { emplace(side, newElement); }
+
+	/// Move new element to the top of one stack.
+	template <typename T>
+	void DoubleSArrayStack<T>::push(Side side, T&& newElement) { emplace(side, std::move(newElement)); }
+
+	/// Construct a new element from args at the top of one stack, and return a reference to it. Throws if the array is full (no free slot between both stacks).
+	template <typename T>
+	template <typename... Args>
+	T& DoubleSArrayStack<T>::emplace(Side side, Args&&... args)
+	{
+		if (leftTop == rightTop) throw std::out_of_range("Stack is full");
+
+		if (side == Side::LEFT)
+		{
+			new (array + leftTop) T(std::forward<Args>(args)...);
+			return array[leftTop++];
+		}
+
+		new (array + rightTop - 1) T(std::forward<Args>(args)...);
+		return array[--rightTop];
+	}
+
+	/// Extract top element of one stack.
+	template <typename T>
+	T DoubleSArrayStack<T>::pop(Side side)
+	{
+		if (!length(side)) throw std::out_of_range("Stack is empty");
+
+		T* slot = (side == Side::LEFT ? array + --leftTop : array + rightTop++);
+		T item = std::move(*slot);
+		slot->~T();
+		return item;
+	}
+
+	/// Get top element of one stack.
+	template <typename T>
+	const T& DoubleSArrayStack<T>::topValue(Side side) const
+	{
+		if (!length(side)) throw std::out_of_range("Stack is empty");
+
+		return (side == Side::LEFT ? array[leftTop - 1] : array[rightTop]);
+	}
+
+	/// Get number of elements of one stack.
+	template <typename T>
+	size_t DoubleSArrayStack<T>::length(Side side) const { return (side == Side::LEFT ? leftTop : capacity - rightTop); }
+
+	/// Get number of elements of both stacks.
+	template <typename T>
+	size_t DoubleSArrayStack<T>::length() const { return leftTop + (capacity - rightTop); }
+
+	/// Get the combined capacity of both stacks.
+	template <typename T>
+	size_t DoubleSArrayStack<T>::getCapacity() const { return capacity; }
+
+	/// Get one of the stacks as a Stack<T> (e.g., to pass it to code written for Stack<T>). The reference is valid while this object lives.
+	template <typename T>
+	Stack<T>& DoubleSArrayStack<T>::stack(Side side) { return (side == Side::LEFT ? leftEnd : rightEnd); }
+
+	/// Constructor.
+	template <typename T>
+	DoubleSArrayStack<T>::End::End(DoubleSArrayStack* owner, Side side)
+		: Stack<T>(), owner(owner), side(side) { }
+
+	template <typename T>
+	void DoubleSArrayStack<T>::End::clear() { owner->clear(side); }
+
+	template <typename T>
+	void DoubleSArrayStack<T>::End::push(const T& newElement) { owner->push(side, newElement); }
+
+	template <typename T>
+	void DoubleSArrayStack<T>::End::push(T&& newElement) { owner->push(side, std::move(newElement)); }
+
+	template <typename T>
+	T DoubleSArrayStack<T>::End::pop() { return owner->pop(side); }
+
+	template <typename T>
+	const T& DoubleSArrayStack<T>::End::topValue() const { return owner->topValue(side); }
+
+	template <typename T>
+	size_t DoubleSArrayStack<T>::End::length() const { return owner->length(side); }
+
+
+	// -- LinkedStack --------------------------------------
+
+	/// Constructor.
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>::LinkedStack(size_t unusedArg) : top(nullptr), size(0) { }
+
+	/// Copy constructor
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>::LinkedStack(const LinkedStack& obj)
+		: top(nullptr), size(0)
+	{
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The nodes of obj (and the allocator that owns them) are taken, and obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>::LinkedStack(LinkedStack&& obj) noexcept
+		: top(obj.top), size(obj.size), allocator(std::move(obj.allocator))
+	{
+		obj.top = nullptr;
+		obj.size = 0;
+	}
+
+	/// Destructor.
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>::~LinkedStack() { clear(); }
+
+	/// Copy assignment operator overloading.
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(const LinkedStack& obj)
+	{
+		if (this == &obj) return *this;
+
+		clear();
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. Our nodes are destroyed, and the nodes of obj (and the allocator that owns them) are taken. obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	LinkedStack<T, Alloc>& LinkedStack<T, Alloc>::operator=(LinkedStack&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		clear();
+		allocator = std::move(obj.allocator);
+		top = obj.top;
+		size = obj.size;
+
+		obj.top = nullptr;
+		obj.size = 0;
+
+		return *this;
+	}
+
+	/// Copy the elements stored in another linked stack into this one (empty).
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::copyFrom(const LinkedStack& obj)
+	{
+		std::vector<T*> elements;
+		for(SNode<T>* node = obj.top; node; node = node->next)
+			elements.push_back(&(node->element));
+
+		for (auto it = elements.rbegin(); it != elements.rend(); ++it)
+			push(**it);
+	}
+
+	/// Remove al elements.
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::clear()
+	{
+		if (!Alloc<SNode<T>>::bulkRelease || !std::is_trivially_destructible<T>::value)
+		{
+			SNode<T>* nextNode;
+			for (SNode<T>* node = top; node; node = nextNode)
+			{
+				nextNode = node->next;
+				node->~SNode();
+				allocator.deallocate(node);
+			}
+		}
+
+		allocator.reset();
+		top = nullptr;
+		size = 0;
+	}
+
+	/// Insert new node.
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::push(const T& newElement) { emplace(newElement); }
+
+	/// Insert new node, moving the element into it.
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::push(T&& newElement) { emplace(std::move(newElement)); }
+
+	/// Insert new node, constructing its element in place from args, and return a reference to the element.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& LinkedStack<T, Alloc>::emplace(Args&&... args)
+	{
+		SNode<T>* node = allocator.allocate();
+
+		try { top = new (node) SNode<T>(std::in_place, top, std::forward<Args>(args)...); }
+		catch (...) { allocator.deallocate(node); throw; }
+
+		size++;
+		return top->element;
+	}
+
+	/// Extract top node.
+	template <typename T, template <typename> class Alloc>
+	T LinkedStack<T, Alloc>::pop()
+	{
+		if (!top) throw std::out_of_range("Stack is empty");
+
+		T content = std::move(top->element);
+		SNode<T>* nextNode = top->next;
+		top->~SNode();
+		allocator.deallocate(top);
+		top = nextNode;
+		size--;
+		return content;
+	}
+
+	/// Get element's value from the top node.
+	template <typename T, template <typename> class Alloc>
+	const T& LinkedStack<T, Alloc>::topValue() const
+	{
+		if (!top) throw std::out_of_range("Stack is empty");
+
+		return top->element;
+	}
+
+	/// Return the list length.
+	template <typename T, template <typename> class Alloc>
+	size_t LinkedStack<T, Alloc>::length() const { return size; }
+
+	/// Pre-allocate nodes so the stack can hold "count" elements without calling the allocator.
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::reserve(size_t count) { allocator.reserve(count > size ? count - size : 0); }
+
+	/// Give back the memory of unused nodes (after a burst). With a bulk-release allocator (SlabArena), chunks can only be freed all at once, so the elements are moved (copied, if their move may throw) to a new stack with its own allocator, which then replaces this one. All of its nodes are allocated before any element is moved, so if anything throws, this stack is unchanged.
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::shrink()
+	{
+		if (!NodePool<SNode<T>, Alloc>::bulkRelease)
+			return allocator.shrink();
+
+		std::vector<SNode<T>*> nodes;
+		nodes.reserve(size);
+		for (SNode<T>* node = top; node; node = node->next)
+			nodes.push_back(node);
+
+		LinkedStack stack;
+		stack.allocator.setFreelistCap(allocator.getFreelistCap());
+		stack.allocator.reserve(size);
+
+		for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+			stack.push(std::move_if_noexcept((*it)->element));
+
+		*this = std::move(stack);
+	}
+
+	/// Set the max. number of unused nodes kept in the pool's freelist. Nodes over the cap go back to the allocator (SlabArena keeps their memory until release()).
+	template <typename T, template <typename> class Alloc>
+	void LinkedStack<T, Alloc>::setFreelistCap(size_t cap) { allocator.setFreelistCap(cap); }
+
+	/// Get the number of unused nodes kept for reuse.
+	template <typename T, template <typename> class Alloc>
+	size_t LinkedStack<T, Alloc>::freeNodes() const { return allocator.freeNodes(); }
+
+
+	// -- SArrayQueue --------------------------------------
+
+	/// Constructor. Make list array one position larger for empty slot.
+	template<typename T>
+	SArrayQueue<T>::SArrayQueue(size_t size)
+		: capacity(size + 1), rear(0), front(1), array(new T[capacity]) { }
+
+	/// Copy constructor
+	template<typename T>
+	SArrayQueue<T>::SArrayQueue(const SArrayQueue& obj)
+	{
+		copyFrom(obj);
+	}
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (no array, and no room for elements).
+	template<typename T>
+	SArrayQueue<T>::SArrayQueue(SArrayQueue&& obj) noexcept
+		: capacity(obj.capacity), front(obj.front), rear(obj.rear), array(obj.array)
+	{
+		obj.array = nullptr;
+		obj.capacity = 1;
+		obj.front = obj.rear = 0;
+	}
+
+	/// Destructor
+	template<typename T>
+	SArrayQueue<T>::~SArrayQueue() { if(array) delete[] array; }
+
+	/// Copy-assignment operator overloading
+	template<typename T>
+	SArrayQueue<T>& SArrayQueue<T>::operator=(const SArrayQueue& obj)
+	{
+		if (this == &obj) return *this;
+
+		if (array) delete[] array;
+
+		copyFrom(obj);
+
+		return *this;
+	}
+
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (no array, and no room for elements).
+	template<typename T>
+	SArrayQueue<T>& SArrayQueue<T>::operator=(SArrayQueue&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		delete[] array;
+
+		capacity = obj.capacity;
+		front = obj.front;
+		rear = obj.rear;
+		array = obj.array;
+
+		obj.array = nullptr;
+		obj.capacity = 1;
+		obj.front = obj.rear = 0;
+
+		return *this;
+	}
+
+	/// Make an object a copy of another.
+	template<typename T>
+	void SArrayQueue<T>::copyFrom(const SArrayQueue& obj)
+	{
+		capacity = obj.capacity;
+		rear = obj.rear;
+		front = obj.front;
+		array = new T[capacity];
+
+		size_t pos, size = length();
+		for (size_t i = 0; i < size; i++)
+		{
+			pos = (front + i) % capacity;
+			array[pos] = obj.array[pos];
+		}
+	}
+
+	/// Reinitialize the queue.
+	template<typename T>
+	void SArrayQueue<T>::clear()
+	{
+		rear = 0;
+		front = 1;
+	}
+
+	/// Insert new element at the rear. Queue is full when rear is 2 steps behind front.
+	template<typename T>
+	void SArrayQueue<T>::enqueue(const T& newElement)
+	{
+		if ((rear + 2) % capacity == front) throw std::out_of_range("Queue is full");
+
+		rear = (rear + 1) % capacity;
+		array[rear] = newElement;
+	}
+
+	/// Move new element to the rear.
+	template<typename T>
+	void SArrayQueue<T>::enqueue(T&& newElement)
+	{
+		if ((rear + 2) % capacity == front) throw std::out_of_range("Queue is full");
+
+		rear = (rear + 1) % capacity;
+		array[rear] = std::move(newElement);
+	}
+
+	/// Construct a new element from args at the rear, and return a reference to it. Slots are already constructed, so the element is move-assigned into its slot.
+	template<typename T>
+	template <typename... Args>
+	T& SArrayQueue<T>::emplace(Args&&... args)
+	{
+		if ((rear + 2) % capacity == front) throw std::out_of_range("Queue is full");
+
+		size_t pos = (rear + 1) % capacity;
+		array[pos] = T(std::forward<Args>(args)...);
+		rear = pos;
+		return array[rear];
+	}
+
+	/// Extract element from the front. Queue is empty when rear is right before front.
+	template<typename T>
+	T SArrayQueue<T>::dequeue()
+	{
+		if ((rear + 1) % capacity == front) throw std::out_of_range("Queue is empty");
+		T it = std::move(array[front]);
+		front = (front + 1) % capacity;
+		return it;
+	}
+
+	/// Get value of front element.
+	template<typename T>
+	const T& SArrayQueue<T>::frontValue() const
+	{
+		if (length() == 0) throw std::out_of_range("Queue is empty");
+		return array[front];
+	}
+
+	/// Return length.
+	template<typename T>
+	size_t SArrayQueue<T>::length() const { return (rear - front + 1 + capacity) % capacity; }
+
+
+	// -- DArrayQueue --------------------------------------
+
+	/// Smallest power of two >= n (1 for n == 0).
+	inline size_t ceilPowerOfTwo(size_t n)
+	{
+		size_t power = 1;
+		while (power < n) power <<= 1;
+		return power;
+	}
+
+	/// Constructor. Reserve room for "capacity" elements (rounded up to a power of two). Like reserve(), capacity won't be halved below it.
+	template<typename T>
+	DArrayQueue<T>::DArrayQueue(size_t capacity)
+		: array(nullptr), capacity(0), front(0), size(0), reservedCapacity(0)
+	{
+		reserve(capacity);
+	}
+
+	/// Copy constructor. The copy is unwrapped, and its capacity is the smallest power of two that fits the elements (nothing reserved).
+	template<typename T>
+	DArrayQueue<T>::DArrayQueue(const DArrayQueue& obj)
+		: array(nullptr), capacity(0), front(0), size(0), reservedCapacity(0)
+	{
+		if (!obj.size) return;
+
+		size_t newCapacity = ceilPowerOfTwo(obj.size);
+		T* newArray = ArrayStorage<T>::allocate(newCapacity);
+		size_t firstSpan = std::min(obj.size, obj.capacity - obj.front);   // Elements before the wrap
+		try
+		{
+			std::uninitialized_copy(obj.array + obj.front, obj.array + obj.front + firstSpan, newArray);
+			try { std::uninitialized_copy(obj.array, obj.array + (obj.size - firstSpan), newArray + firstSpan); }
+			catch (...)
+			{
+				ArrayStorage<T>::destroy(newArray, newArray + firstSpan);
+				throw;
+			}
+		}
+		catch (...)
+		{
+			ArrayStorage<T>::deallocate(newArray);
+			throw;
+		}
+
+		array = newArray;
+		capacity = newCapacity;
+		size = obj.size;
+	}
+
+	/// Move constructor. The buffer of obj is taken, and obj is left empty (no buffer).
+	template<typename T>
+	DArrayQueue<T>::DArrayQueue(DArrayQueue&& obj) noexcept
+		: array(obj.array), capacity(obj.capacity), front(obj.front), size(obj.size), reservedCapacity(obj.reservedCapacity)
+	{
+		obj.array = nullptr;
+		obj.capacity = obj.front = obj.size = obj.reservedCapacity = 0;
+	}
+
+	/// Destructor
+	template<typename T>
+	DArrayQueue<T>::~DArrayQueue()
+	{
+		clear();
+		ArrayStorage<T>::deallocate(array);
+	}
+
+	/// Copy-assignment operator overloading. If a copy throws, this queue is not modified.
+	template<typename T>
+	DArrayQueue<T>& DArrayQueue<T>::operator=(const DArrayQueue& obj)
+	{
+		if (this == &obj) return *this;
+
+		DArrayQueue copy(obj);
+		return *this = std::move(copy);
+	}
+
+	/// Move-assignment operator overloading. The buffer of obj is taken, and obj is left empty (no buffer).
+	template<typename T>
+	DArrayQueue<T>& DArrayQueue<T>::operator=(DArrayQueue&& obj) noexcept
+	{
+		if (this == &obj) return *this;
+
+		clear();
+		ArrayStorage<T>::deallocate(array);
+
+		array = obj.array;
+		capacity = obj.capacity;
+		front = obj.front;
+		size = obj.size;
+		reservedCapacity = obj.reservedCapacity;
+
+		obj.array = nullptr;
+		obj.capacity = obj.front = obj.size = obj.reservedCapacity = 0;
+
+		return *this;
+	}
+
+	template<typename T>
+	size_t DArrayQueue<T>::mask() const { return capacity - 1; }
+
+	/// Relocate the elements to uninitialized storage, in order (front goes to dest[0]). Since the elements are in at most 2 contiguous spans ([front, capacity) and [0, rear)), this takes 2 relocations (memcpy if T is trivially copyable). Afterwards, the old slots are uninitialized.
+	template<typename T>
+	void DArrayQueue<T>::unwrap(T* dest)
+	{
+		size_t firstSpan = std::min(size, capacity - front);
+
+		ArrayStorage<T>::relocate(array + front, firstSpan, dest);
+		ArrayStorage<T>::relocate(array, size - firstSpan, dest + firstSpan);
+	}
+
+	/// Move the elements to the start of a new buffer with newCapacity slots (a power of two >= size, or 0 for an empty queue).
+	template<typename T>
+	void DArrayQueue<T>::reallocate(size_t newCapacity)
+	{
+		T* newArray = ArrayStorage<T>::allocate(newCapacity);
+
+		unwrap(newArray);
+		ArrayStorage<T>::deallocate(array);
+
+		array = newArray;
+		capacity = newCapacity;
+		front = 0;
+	}
+
+	/// Halve capacity if the queue is 1/4 full (but not below minCapacity or the reserved capacity). Called after removing elements, so it doesn't throw: if the smaller buffer can't be allocated, the current one is kept.
+	template<typename T>
+	void DArrayQueue<T>::shrink() noexcept
+	{
+		if (capacity > minCapacity && capacity > reservedCapacity && size <= capacity / 4)
+		{
+			try { reallocate(capacity / 2); }
+			catch (const std::bad_alloc&) { }   // Nothing was moved yet: keep the current buffer
+		}
+	}
+
+	/// Construct a new element from args at the rear of a full queue. The new element is constructed in the new buffer before relocating the others, so args may refer to an element of this queue. Capacity doubles.
+	template<typename T>
+	template <typename... Args>
+	T& DArrayQueue<T>::emplaceGrow(Args&&... args)
+	{
+		size_t newCapacity = capacity ? capacity * 2 : 1;
+		T* newArray = ArrayStorage<T>::allocate(newCapacity);
+
+		try { new (newArray + size) T(std::forward<Args>(args)...); }
+		catch (...)
+		{
+			ArrayStorage<T>::deallocate(newArray);
+			throw;
+		}
+
+		unwrap(newArray);
+		ArrayStorage<T>::deallocate(array);
+
+		array = newArray;
+		capacity = newCapacity;
+		front = 0;
+		return array[size++];
+	}
+
+	/// Destroy all elements. Capacity is kept.
+	template<typename T>
+	void DArrayQueue<T>::clear()
+	{
+		if (!std::is_trivially_destructible<T>::value)
+			for (size_t i = 0; i < size; i++)
+				array[(front + i) & mask()].~T();
+
+		front = size = 0;
+	}
+
+	/// Insert new element at the rear. The queue grows if it's full.
+	template<typename T>
+	void DArrayQueue<T>::enqueue(const T& newElement) { emplace(newElement); }
+
+	/// Move new element to the rear. The queue grows if it's full.
+	template<typename T>
+	void DArrayQueue<T>::enqueue(T&& newElement) { emplace(std::move(newElement)); }
+
+	/// Construct a new element from args at the rear, and return a reference to it. The queue grows if it's full.
+	template<typename T>
+	template <typename... Args>
+	T& DArrayQueue<T>::emplace(Args&&... args)
+	{
+		if (size == capacity) return emplaceGrow(std::forward<Args>(args)...);
+
+		T* slot = array + ((front + size) & mask());
+		new (slot) T(std::forward<Args>(args)...);
+		size++;
+		return *slot;
+	}
+
+	/// Extract element from the front.
+	template<typename T>
+	T DArrayQueue<T>::dequeue()
+	{
+		if (!size) throw std::out_of_range("Queue is empty");
+
+		T item = std::move(array[front]);
+		array[front].~T();
+		front = (front + 1) & mask();
+		size--;
+
+		shrink();
+		return item;
+	}
+
+	/// Get value of front element.
+	template<typename T>
+	const T& DArrayQueue<T>::frontValue() const
+	{
+		if (!size) throw std::out_of_range("Queue is empty");
+		return array[front];
+	}
+
+	/// Return length.
+	template<typename T>
+	size_t DArrayQueue<T>::length() const { return size; }
+
+	/// Copy "count" elements from [first, first + count) to the rear. Capacity grows once (at most), and the elements are copied in at most 2 contiguous spans (memmove if T is trivially copyable). If a copy throws, the queue is not modified.
+	template<typename T>
+	void DArrayQueue<T>::enqueueN(const T* first, size_t count)
+	{
+		if (!count) return;
+
+		if (size + count > capacity)
+		{
+			if (std::less_equal<const T*>()(array, first) && std::less<const T*>()(first, array + capacity))   // Source inside our buffer: copy it before reallocating
+			{
+				std::vector<T> temp(first, first + count);
+				enqueueN(temp.data(), count);
+				return;
+			}
+
+			reallocate(ceilPowerOfTwo(size + count));
+		}
+
+		size_t rear = (front + size) & mask();
+		size_t firstSpan = std::min(count, capacity - rear);   // Slots before the wrap
+
+		std::uninitialized_copy(first, first + firstSpan, array + rear);
+		try { std::uninitialized_copy(first + firstSpan, first + count, array); }
+		catch (...)
+		{
+			ArrayStorage<T>::destroy(array + rear, array + rear + firstSpan);
+			throw;
+		}
+
+		size += count;
+	}
+
+	/// Move up to "count" elements from the front to [dest, dest + count) (move-assignment, in at most 2 contiguous spans). Returns the number of elements extracted.
+	template<typename T>
+	size_t DArrayQueue<T>::dequeueN(T* dest, size_t count)
+	{
+		count = std::min(count, size);
+		if (!count) return 0;
 
-	/// Constructor. Specify the item (element) and next node.
-	template <typename T>
-	SNode<T>::SNode(const T& content, SNode* nextNode)
-		: Node(content), next(nextNode) { }
+		size_t firstSpan = std::min(count, capacity - front);   // Elements before the wrap
 
-	/// Constructor. Specify next node.
-	template <typename T>
-	SNode<T>::SNode(SNode* nextNode)
-		: Node(), next(nextNode) { }
+		std::move(array + front, array + front + firstSpan, dest);
+		std::move(array, array + (count - firstSpan), dest + firstSpan);
+		ArrayStorage<T>::destroy(array + front, array + front + firstSpan);
+		ArrayStorage<T>::destroy(array, array + (count - firstSpan));
 
-	/// Copy constructor. Be careful: The pointer to next node is copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
-	template <typename T>
-	SNode<T>::SNode(const SNode& obj)
-		: Node(obj.element), next(obj.next) { }
+		front = (front + count) & mask();
+		size -= count;
 
-	/// Destructor. Destroys the next node (which causes the destruction of subsequent nodes).
-	template <typename T>
-	SNode<T>::~SNode()
-	{ 
-		if (next) delete next; 
+		shrink();
+		return count;
 	}
 
-	/// Copy-assignment operator overloading.
-	template <typename T>
-	SNode<T>& SNode<T>::operator=(const SNode &obj)
+	/// Make room for at least newCapacity elements (rounded up to a power of two). Capacity never decreases here, and dequeues won't shrink the queue below it (until shrink_to_fit()).
+	template<typename T>
+	void DArrayQueue<T>::reserve(size_t newCapacity)
 	{
-		if (this == &obj) return *this;
-		
-		(Node&)(*this) = obj;
-		next = obj.next;
+		if (!newCapacity) return;
 
-		return *this;
+		newCapacity = ceilPowerOfTwo(newCapacity);
+		if (newCapacity > capacity)
+			reallocate(newCapacity);
+
+		if (newCapacity > reservedCapacity)
+			reservedCapacity = newCapacity;
 	}
 
-	/// Set all member variables of the node.
-	template <typename T>
-	void SNode<T>::setNode(const T& content, SNode* nextNode)
+	/// Reduce capacity to the smallest power of two that fits the elements (no buffer if the queue is empty). The reserved capacity is dropped too.
+	template<typename T>
+	void DArrayQueue<T>::shrink_to_fit()
 	{
-		element = content;
-		next = nextNode;
+		reservedCapacity = 0;
+
+		size_t newCapacity = size ? ceilPowerOfTwo(size) : 0;
+
+		if (newCapacity < capacity)
+			reallocate(newCapacity);
 	}
 
+	/// Get the number of elements the queue can hold without reallocating.
+	template<typename T>
+	size_t DArrayQueue<T>::getCapacity() const { return capacity; }
 
-	// -- DNode --------------------------------------
 
-	/// Constructor. Specify the item (element) and previous and next nodes.
-	template <typename T>
-	DNode<T>::DNode(const T& content, DNode* prevNode, DNode* nextNode)
-		: Node(content), prev(prevNode), next(nextNode) { }
+	// -- LinkedQueue --------------------------------------
 
-	/// Constructor. Specify previous and next nodes.
-	template <typename T>
-	DNode<T>::DNode(DNode* prevNode, DNode* nextNode)
-		: Node(), prev(prevNode), next(nextNode) { }
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>::LinkedQueue(size_t unusedArg)
+		: front(&header), rear(front), size(0) { }
+	
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>::LinkedQueue(const LinkedQueue& obj)
+		: front(&header), rear(front), size(0)
+	{
+		copyFrom(obj);
+	}
 
-	/// Copy constructor. Be careful: The pointers to previous and next node are copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
-	template <typename T>
-	DNode<T>::DNode(const DNode& obj)
-		: Node(obj.element), prev(obj.prev), next(obj.next) { }
+	/// Move constructor. The nodes of obj (and the allocator that owns them) are taken, and obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>::LinkedQueue(LinkedQueue&& obj) noexcept(std::is_nothrow_default_constructible<T>::value)
+		: front(&header), rear(front), size(0), allocator(std::move(obj.allocator))
+	{
+		moveFrom(obj);
+	}
 
-	/// Destructor. Destroys the next link node (which causes the destruction of subsequent nodes), but not prev link node.
-	template <typename T>
-	DNode<T>::~DNode()
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>::~LinkedQueue() { clear(); }
+
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>& LinkedQueue<T, Alloc>::operator=(const LinkedQueue& obj)
 	{
-		//if (prev != nullptr) delete prev;
-		if (next != nullptr) delete next;
+		if (this == &obj) return *this;
+
+		clear();
+		copyFrom(obj);
+
+		return *this;
 	}
 
-	/// Copy-assignment operator overloading.
-	template <typename T>
-	DNode<T>& DNode<T>::operator=(const DNode& obj)
+	/// Move-assignment operator overloading. Our nodes are destroyed, and the nodes of obj (and the allocator that owns them) are taken. obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	LinkedQueue<T, Alloc>& LinkedQueue<T, Alloc>::operator=(LinkedQueue&& obj) noexcept
 	{
 		if (this == &obj) return *this;
-		
-		(Node&)(*this) = obj;
-		prev = obj.prev;
-		next = obj.next;
+
+		clear();
+		allocator = std::move(obj.allocator);
+		moveFrom(obj);
 
 		return *this;
 	}
-	
-	/// Set all member variables of the node.
-	template <typename T>
-	void DNode<T>::setNode(const T& content, DNode* prevNode, DNode* nextNode)
+
+	/// Copy the elements stored in another linked queue into this one (empty).
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::copyFrom(const LinkedQueue& obj)
 	{
-		element = content;
-		prev = prevNode;
-		next = nextNode;
+		for(SNode<T>* node = obj.front->next; node; node = node->next)
+			enqueue(node->element);
 	}
 
+	/// Take the nodes of obj (this queue must be empty, and its allocator replaced with the one of obj). obj is left empty.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::moveFrom(LinkedQueue& obj) noexcept
+	{
+		front->next = obj.front->next;
+		rear = obj.size ? obj.rear : front;
+		size = obj.size;
 
-	// -- DNodeXor --------------------------------------
+		obj.front->next = nullptr;
+		obj.rear = obj.front;
+		obj.size = 0;
+	}
 
-	/// Constructor. Specify the item (element) and previous and next nodes.
-	template <typename T>
-	XorNode<T>::XorNode(const T& content, XorNode* prevNode, XorNode* nextNode)
-		: Node(content), npx(XOR(prevNode, nextNode)) { }
+	/// Reinitialize the queue.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::clear()
+	{
+		if (!Alloc<SNode<T>>::bulkRelease || !std::is_trivially_destructible<T>::value)
+		{
+			SNode<T>* nextNode;
+			for (SNode<T>* node = front->next; node; node = nextNode)
+			{
+				nextNode = node->next;
+				node->~SNode();
+				allocator.deallocate(node);
+			}
+		}
 
-	/// Constructor. Specify previous and next nodes.
-	template <typename T>
-	XorNode<T>::XorNode(XorNode* prevNode, XorNode* nextNode)
-		: Node(), npx(XOR(prevNode, nextNode)) { }
+		allocator.reset();
+		front->next = nullptr;
+		rear = front;
+		size = 0;
+	}
 
-	/// Copy constructor. Be careful: The pointers to previous and next node are copied (multiple pointers pointing to the same node may cause problems when such node is destroyed).
-	template <typename T>
-	XorNode<T>::XorNode(const XorNode& obj)
-		: Node(obj.element), npx(nullptr) { }
+	/// Insert new element at the rear.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::enqueue(const T& newElement) { emplace(newElement); }
 
-	/// Destructor. User is responsible for deleting link nodes. XorNode cannot delete any link node by itself (unlike SNode or DNode) because needs user-provided information about a link-node.
-	template <typename T>
-	XorNode<T>::~XorNode() { }
+	/// Move new element to the rear.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::enqueue(T&& newElement) { emplace(std::move(newElement)); }
 
-	/// Copy-assignment operator overloading.
-	template <typename T>
-	XorNode<T>& XorNode<T>::operator=(const XorNode& obj)
+	/// Construct a new element from args at the rear, and return a reference to it.
+	template <typename T, template <typename> class Alloc>
+	template <typename... Args>
+	T& LinkedQueue<T, Alloc>::emplace(Args&&... args)
 	{
-		if (this == &obj) return *this;
+		SNode<T>* node = allocator.allocate();
 
-		(Node&)(*this) = obj;
-		npx = obj.npx;
+		try { rear = rear->next = new (node) SNode<T>(std::in_place, nullptr, std::forward<Args>(args)...); }
+		catch (...) { allocator.deallocate(node); throw; }
 
-		return *this;
+		size++;
+		return rear->element;
 	}
 
-	/// Set all member variables of the node (npx member is set based on the prev and next link nodes).
-	template <typename T>
-	void XorNode<T>::setNode(const T& content, XorNode* prev, XorNode* next)
+	/// Extract element from the front.
+	template <typename T, template <typename> class Alloc>
+	T LinkedQueue<T, Alloc>::dequeue()
 	{
-		element = content;
-		npx = XOR(prev, next);
+		if (size == 0) throw std::out_of_range("Queue is empty");
+		if (size == 1) rear = front;
+
+		SNode<T>* node = front->next;
+		T element = std::move(node->element);
+
+		front->next = node->next;
+		node->~SNode();
+		allocator.deallocate(node);
+		size--;
+		return element;
 	}
 
-	/// Set the npx member based on the prev and next link nodes.
-	template <typename T>
-	void XorNode<T>::setNode(XorNode* prev, XorNode* next)
+	/// Get value of front element.
+	template <typename T, template <typename> class Alloc>
+	const T& LinkedQueue<T, Alloc>::frontValue() const
 	{
-		npx = XOR(prev, next);
+		if (!size) throw std::out_of_range("Queue is empty");
+
+		return front->next->element;
 	}
 
-	template <typename T>
-	XorNode<T>* XorNode<T>::next(XorNode* prev) { return XOR(npx, prev); }
+	/// Return length.
+	template <typename T, template <typename> class Alloc>
+	size_t LinkedQueue<T, Alloc>::length() const { return size; }
 
-	template <typename T>
-	XorNode<T>* XorNode<T>::prev(XorNode* next) { return XOR(npx, next); }
+	/// Pre-allocate nodes so the queue can hold "count" elements without calling the allocator.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::reserve(size_t count) { allocator.reserve(count > size ? count - size : 0); }
 
-	/// XOR operator. Useful for finding out the other link pointer (given x=aXORb, then a=xXORb and b = xXORa)
-	template <typename T>
-	XorNode<T>* XorNode<T>::XOR(XorNode* x, XorNode* a)
+	/// Give back the memory of unused nodes (after a burst). With a bulk-release allocator (SlabArena), chunks can only be freed all at once, so the elements are moved (copied, if their move may throw) to a new queue with its own allocator, which then replaces this one. All of its nodes are allocated before any element is moved, so if anything throws, this queue is unchanged.
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::shrink()
 	{
-		return reinterpret_cast<XorNode*>(reinterpret_cast<uintptr_t>(x) ^ reinterpret_cast<uintptr_t>(a));
+		if (!NodePool<SNode<T>, Alloc>::bulkRelease)
+			return allocator.shrink();
+
+		LinkedQueue queue;
+		queue.allocator.setFreelistCap(allocator.getFreelistCap());
+		queue.allocator.reserve(size);
+
+		for (SNode<T>* node = front->next; node; node = node->next)
+			queue.enqueue(std::move_if_noexcept(node->element));
+
+		*this = std::move(queue);
 	}
 
+	/// Set the max. number of unused nodes kept in the pool's freelist. Nodes over the cap go back to the allocator (SlabArena keeps their memory until release()).
+	template <typename T, template <typename> class Alloc>
+	void LinkedQueue<T, Alloc>::setFreelistCap(size_t cap) { allocator.setFreelistCap(cap); }
 
-	// -- SinglyLinkedList --------------------------------------
+	/// Get the number of unused nodes kept for reuse.
+	template <typename T, template <typename> class Alloc>
+	size_t LinkedQueue<T, Alloc>::freeNodes() const { return allocator.freeNodes(); }
 
-	/// Constructor.
+
+	// -- SPSCQueue --------------------------------------
+
+	/// Constructor. Capacity is rounded up to a power of two (at least 1).
 	template <typename T>
-	SinglyLinkedList<T>::SinglyLinkedList(size_t unusedArg)
-		: count(0), freelist(nullptr)
-	{ 
-		curr = head = tail = new SNode<T>(nullptr);
+	SPSCQueue<T>::SPSCQueue(size_t capacity)
+		: array(nullptr), capacity(ceilPowerOfTwo(capacity ? capacity : 1)), mask(0), head(0), cachedTail(0), tail(0), cachedHead(0)
+	{
+		mask = this->capacity - 1;
+		array = ArrayStorage<T>::allocate(this->capacity);
 	}
 
-	/// Constructor. It takes an initialization list.
+	/// Destructor. No thread may be using the queue.
 	template <typename T>
-	SinglyLinkedList<T>::SinglyLinkedList(const std::initializer_list<T>& il)
-		: count(0), freelist(nullptr)
+	SPSCQueue<T>::~SPSCQueue()
 	{
-		curr = head = tail = new SNode<T>(nullptr);
+		size_t t = tail.load(std::memory_order_relaxed);
+		for (size_t h = head.load(std::memory_order_relaxed); h != t; h++)
+			array[h & mask].~T();
 
-		for(const T& item : il)
-			append(item);
+		ArrayStorage<T>::deallocate(array);
 	}
 
-	/// Copy constructor.
+	/// Number of free slots (up to "wanted"), given the producer's tail. head is read (acquire) only if the cached copy doesn't show enough room.
 	template <typename T>
-	SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList& obj)
+	size_t SPSCQueue<T>::freeSlots(size_t t, size_t wanted)
 	{
-		copyFrom(obj);
+		size_t available = capacity - (t - cachedHead);
+		if (available < wanted)
+		{
+			cachedHead = head.load(std::memory_order_acquire);
+			available = capacity - (t - cachedHead);
+		}
+
+		return std::min(available, wanted);
 	}
 
-	/// Destructor. Delete all nodes in the list, including header node.
+	/// Number of elements available (up to "wanted"), given the consumer's head. tail is read (acquire) only if the cached copy doesn't show enough elements.
 	template <typename T>
-	SinglyLinkedList<T>::~SinglyLinkedList()
+	size_t SPSCQueue<T>::usedSlots(size_t h, size_t wanted)
 	{
-		::delete head;
-		::delete freelist;
+		size_t available = cachedTail - h;
+		if (available < wanted)
+		{
+			cachedTail = tail.load(std::memory_order_acquire);
+			available = cachedTail - h;
+		}
+
+		return std::min(available, wanted);
 	}
 
-	/// Copy-assignment operator overloading.
+	/// Construct a new element from args at the back. Returns false (and does nothing) if the queue is full.
 	template <typename T>
-	SinglyLinkedList<T>& SinglyLinkedList<T>::operator=(const SinglyLinkedList& obj)
+	template <typename... Args>
+	bool SPSCQueue<T>::try_emplace(Args&&... args)
 	{
-		if (this == &obj) return *this;
-		
-		clear();
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (!freeSlots(t, 1)) return false;
 
-		copyFrom(obj);
+		new (array + (t & mask)) T(std::forward<Args>(args)...);
+		tail.store(t + 1, std::memory_order_release);   // Publish the element
+		return true;
+	}
 
-		return *this;
+	/// Insert new element at the back. Returns false if the queue is full.
+	template <typename T>
+	bool SPSCQueue<T>::try_enqueue(const T& newElement) { return try_emplace(newElement); }
+
+	/// Move new element to the back. Returns false (and newElement is not moved) if the queue is full.
+	template <typename T>
+	bool SPSCQueue<T>::try_enqueue(T&& newElement) { return try_emplace(std::move(newElement)); }
+
+	/// Insert new element at the back. If the queue is full, wait (yielding the CPU) until the consumer frees a slot.
+	template <typename T>
+	void SPSCQueue<T>::enqueue(const T& newElement)
+	{
+		while (!try_emplace(newElement))
+			std::this_thread::yield();
 	}
 
-	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
+	/// Move new element to the back. If the queue is full, wait (yielding the CPU) until the consumer frees a slot.
 	template <typename T>
-	T& SinglyLinkedList<T>::operator[](size_t pos) const
+	void SPSCQueue<T>::enqueue(T&& newElement)
 	{
-		if (pos >= count)
-			throw std::out_of_range("No current element");
+		while (!try_emplace(std::move(newElement)))
+			std::this_thread::yield();
+	}
 
-		SNode<T>* nod = head->next;
-		for (size_t i = 0; i < pos; i++)
-			nod = nod->next;
+	/// Insert up to "count" elements from [first, first + count) at the back, in order, and publish them at once. Returns the number of elements inserted (less than count if the queue gets full). If a copy throws, no element is inserted.
+	template <typename T>
+	size_t SPSCQueue<T>::enqueueN(const T* first, size_t count)
+	{
+		size_t t = tail.load(std::memory_order_relaxed);
+		count = freeSlots(t, count);
 
-		return nod->element;
+		size_t i = 0;
+		try
+		{
+			for (; i < count; i++)
+				new (array + ((t + i) & mask)) T(first[i]);
+		}
+		catch (...)
+		{
+			while (i--) array[(t + i) & mask].~T();
+			throw;
+		}
+
+		tail.store(t + count, std::memory_order_release);
+		return count;
 	}
 
-	/// Allocate memory for a node (or take one node's address from freelist, if available), configure the new node, and return a pointer to it.
+	/// Extract the front element into dest (move-assignment). Returns false (and dest is not modified) if the queue is empty.
 	template <typename T>
-	SNode<T>* SinglyLinkedList<T>::newNode(const T& content, SNode<T>* nextNode)
+	bool SPSCQueue<T>::try_dequeue(T& dest)
 	{
-		if (!freelist)
-			return new SNode<T>(content, nextNode);
+		size_t h = head.load(std::memory_order_relaxed);
+		if (!usedSlots(h, 1)) return false;
 
-		SNode<T>* newNode = freelist;
-		freelist = freelist->next;
-		newNode->setNode(content, nextNode);
-		return newNode;
+		T& slot = array[h & mask];
+		dest = std::move(slot);
+		slot.~T();
+		head.store(h + 1, std::memory_order_release);   // Give the slot back to the producer
+		return true;
 	}
 
-	/// Save this node in the freelist (head)
+	/// Extract the front element. If the queue is empty, wait (yielding the CPU) until the producer inserts one.
 	template <typename T>
-	void SinglyLinkedList<T>::deleteNode(SNode<T>* node)
+	T SPSCQueue<T>::dequeue()
 	{
-		node->next = freelist;
-		freelist = node;
+		size_t h = head.load(std::memory_order_relaxed);
+		while (!usedSlots(h, 1))
+			std::this_thread::yield();
+
+		T& slot = array[h & mask];
+		T item = std::move(slot);
+		slot.~T();
+		head.store(h + 1, std::memory_order_release);
+		return item;
 	}
 
-	/// Make the object a copy of another.
+	/// Extract up to "count" elements into [dest, dest + count) (move-assignment), in order, and free their slots at once. Returns the number of elements extracted.
 	template <typename T>
-	void SinglyLinkedList<T>::copyFrom(const SinglyLinkedList& obj)
+	size_t SPSCQueue<T>::dequeueN(T* dest, size_t count)
 	{
-		count = 0;
-		freelist = nullptr;
-		head = tail = curr = new SNode<T>(nullptr);
+		size_t h = head.load(std::memory_order_relaxed);
+		count = usedSlots(h, count);
 
-		for (SNode<T>* node = obj.head->next; node != nullptr; node = node->next)
+		for (size_t i = 0; i < count; i++)
 		{
-			append(node->element);
-			if (obj.curr == node) curr = tail;
+			T& slot = array[(h + i) & mask];
+			dest[i] = std::move(slot);
+			slot.~T();
 		}
 
-		// freelist is not copied
+		head.store(h + count, std::memory_order_release);
+		return count;
 	}
 
-	/// Move all nodes in the list to the freelist, except header node.
+	/// Get number of elements. While the other thread works, the result may be outdated as soon as it's returned.
 	template <typename T>
-	void SinglyLinkedList<T>::clear()
+	size_t SPSCQueue<T>::length() const
 	{
-		if (count == 0) return;
+		size_t h = head.load(std::memory_order_acquire);
+		size_t t = tail.load(std::memory_order_acquire);
+		return (t > h ? t - h : 0);   // head may be newer than tail (the consumer moved it after tail was read)
+	}
 
-		tail->next = freelist;
-		freelist = head->next;
-		head->next = nullptr;
+	/// Check whether the queue has no elements (see length()).
+	template <typename T>
+	bool SPSCQueue<T>::empty() const { return length() == 0; }
 
-		curr = tail = head;
-		count = 0;
-	}
+	/// Get the maximum number of elements.
+	template <typename T>
+	size_t SPSCQueue<T>::getCapacity() const { return capacity; }
 
-	/// Store a new node in the list just before the current position.
+
+	// -- MPMCQueue --------------------------------------
+
+	/// Constructor. Capacity is rounded up to a power of two (at least 2). Cell i starts free for the enqueue at position i.
 	template <typename T>
-	void SinglyLinkedList<T>::insert(const T &content)
+	MPMCQueue<T>::MPMCQueue(size_t capacity)
+		: Queue<T>(), cells(nullptr), capacity(ceilPowerOfTwo(capacity < 2 ? 2 : capacity)), mask(0), enqueuePos(0), dequeuePos(0)
 	{
-		curr->next = newNode(content, curr->next);   // New node inserted after curr (to insert in the head, we use header node)
-		if (tail == curr) tail = curr->next;
-		count++;
+		mask = this->capacity - 1;
+		cells = new Cell[this->capacity];
+
+		for (size_t i = 0; i < this->capacity; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
 	}
-	
-	/// Store a new node at the end of the list (tail).
+
+	/// Destructor. No thread may be using the queue.
 	template <typename T>
-	void SinglyLinkedList<T>::append(const T& content)
+	MPMCQueue<T>::~MPMCQueue()
 	{
-		tail = tail->next = newNode(content, nullptr);
-		count++;
+		size_t end = enqueuePos.load(std::memory_order_relaxed);
+		for (size_t pos = dequeuePos.load(std::memory_order_relaxed); pos != end; pos++)
+			cells[pos & mask].item()->~T();
+
+		delete[] cells;
 	}
 
-	/// Remove the current node from the list and save it in the freelist.
+	/// Claim the cell for the next enqueue position. Returns nullptr if the queue is full. The caller must construct the element and publish it (sequence = pos + 1).
 	template <typename T>
-	T SinglyLinkedList<T>::remove()
-	{	
-		if (curr == tail) throw std::out_of_range("No current element");
-		if (curr->next == tail) tail = curr;
-		
-		SNode<T>* extract = curr->next;
-		T content = extract->element;
+	typename MPMCQueue<T>::Cell* MPMCQueue<T>::claimEnqueue()
+	{
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell* cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
 
-		curr->next = curr->next->next;
-		deleteNode(extract);
-		count--;
-		return content;
+			if (diff == 0)   // Cell free for this position: try to take it
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					return cell;
+			}
+			else if (diff < 0) return nullptr;   // Cell still holds the element from one lap ago: full
+			else pos = enqueuePos.load(std::memory_order_relaxed);   // Another producer took it
+		}
 	}
 
-	/// Get the number of nodes in the list.
-	template <typename T>
-	size_t SinglyLinkedList<T>::length() const { return count; }
-
-	/// Get the position number of the current node.
+	/// Claim the cell for the next dequeue position (returned in pos). Returns nullptr if the queue is empty. The caller must take the element and release the cell.
 	template <typename T>
-	size_t SinglyLinkedList<T>::currPos() const
+	typename MPMCQueue<T>::Cell* MPMCQueue<T>::claimDequeue(size_t& pos)
 	{
-		SNode<T> *node = head;
-		size_t i;
+		pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell* cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
 
-		for (i = 0; curr != node; i++)
-			node = node->next;
+			if (diff == 0)   // Cell holds the element for this position: try to take it
+			{
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					return cell;
+			}
+			else if (diff < 0) return nullptr;   // Element not published yet: empty
+			else pos = dequeuePos.load(std::memory_order_relaxed);   // Another consumer took it
+		}
+	}
 
-		return i;
+	/// Make the cell free for the enqueue one lap after position pos.
+	template <typename T>
+	void MPMCQueue<T>::release(Cell* cell, size_t pos)
+	{
+		cell->sequence.store(pos + capacity, std::memory_order_release);
 	}
 
-	/// Get the item stored in the current node.
+	/// Construct a new element from args at the back. Returns false if the queue is full. If T can't be constructed from args without exceptions, the element is built before claiming a cell (and moved in).
 	template <typename T>
-	const T& SinglyLinkedList<T>::getValue() const
+	template <typename... Args>
+	bool MPMCQueue<T>::try_emplace(Args&&... args)
 	{
-		if (curr == tail)
-			throw std::out_of_range("No current element");
+		if constexpr (std::is_nothrow_constructible<T, Args&&...>::value)
+		{
+			Cell* cell = claimEnqueue();
+			if (!cell) return false;
 
-		return curr->next->element;
+			size_t pos = cell->sequence.load(std::memory_order_relaxed);
+			new (cell->item()) T(std::forward<Args>(args)...);
+			cell->sequence.store(pos + 1, std::memory_order_release);   // Publish the element
+			return true;
+		}
+		else
+		{
+			T item(std::forward<Args>(args)...);
+			return try_emplace(std::move(item));
+		}
 	}
 
-	/// Move curr to the header node.
+	/// Insert new element at the back. Returns false if the queue is full.
 	template <typename T>
-	void SinglyLinkedList<T>::moveToStart() { curr = head; }
+	bool MPMCQueue<T>::try_enqueue(const T& newElement) { return try_emplace(newElement); }
 
-	/// Move curr to the tail (node one-past-the-end).
+	/// Move new element to the back. Returns false (and newElement is not moved) if the queue is full.
 	template <typename T>
-	void SinglyLinkedList<T>::moveToEnd() { curr = tail; }
+	bool MPMCQueue<T>::try_enqueue(T&& newElement) { return try_emplace(std::move(newElement)); }
 
-	/// Move curr to any position from 0 to one-past-the-end.
+	/// Extract the front element into dest. Returns false (and dest is not modified) if the queue is empty.
 	template <typename T>
-	void SinglyLinkedList<T>::moveToPos(size_t pos)
+	bool MPMCQueue<T>::try_dequeue(T& dest)
 	{
-		if (pos > count)
-			throw std::out_of_range("No current element");
+		size_t pos;
+		Cell* cell = claimDequeue(pos);
+		if (!cell) return false;
 
-		curr = head;
-		for (size_t i = 0; i < pos; i++) 
-			curr = curr->next;
+		T item(std::move(*cell->item()));
+		cell->item()->~T();
+		release(cell, pos);
+
+		dest = std::move(item);   // After releasing the cell, so an exception here doesn't block the queue
+		return true;
 	}
 
-	/// Move curr to the previous node, except when curr==head.
+	/// Remove the elements. Elements enqueued by other threads meanwhile may stay.
 	template <typename T>
-	void SinglyLinkedList<T>::prev()
+	void MPMCQueue<T>::clear()
 	{
-		if (curr != head)
+		size_t pos;
+		while (Cell* cell = claimDequeue(pos))
 		{
-			SNode<T>* node = head;
-			while (node->next != curr) node = node->next;
-			curr = node;
+			cell->item()->~T();
+			release(cell, pos);
 		}
 	}
 
-	/// Move curr to the next node, if it exists (including one-past-the-end).
+	/// Insert new element at the back. If the queue is full, wait (yielding the CPU) until a consumer frees a cell.
 	template <typename T>
-	void SinglyLinkedList<T>::next()
+	void MPMCQueue<T>::enqueue(const T& newElement)
 	{
-		if (curr != tail)
-			curr = curr->next;
+		if constexpr (std::is_nothrow_copy_constructible<T>::value)
+		{
+			while (!try_emplace(newElement))
+				std::this_thread::yield();
+		}
+		else enqueue(T(newElement));   // Copy once, then move it in
 	}
-	
-
-	// -- DoubleLinkedList --------------------------------------
 
-	/// Constructor.
+	/// Move new element to the back. If the queue is full, wait (yielding the CPU) until a consumer frees a cell.
 	template <typename T>
-	DoubleLinkedList<T>::DoubleLinkedList(size_t unusedArg)
-		: count(0), freelist(nullptr)
+	void MPMCQueue<T>::enqueue(T&& newElement)
 	{
-		head = new DNode<T>();
-		tail = new DNode<T>();
-		head->next = tail;
-		tail->prev = head;
-		curr = head;
+		while (!try_emplace(std::move(newElement)))
+			std::this_thread::yield();
 	}
 
-	/// Constructor. It takes an initialization list.
+	/// Extract the front element. If the queue is empty, wait (yielding the CPU) until a producer inserts one.
 	template <typename T>
-	DoubleLinkedList<T>::DoubleLinkedList(const std::initializer_list<T>& il)
-		: count(0), freelist(nullptr)
+	T MPMCQueue<T>::dequeue()
 	{
-		head = new DNode<T>();
-		tail = new DNode<T>();
-		head->next = tail;
-		tail->prev = head;
-		curr = head;
+		size_t pos;
+		Cell* cell;
+		while (!(cell = claimDequeue(pos)))
+			std::this_thread::yield();
 
-		for (const T& item : il)
-			append(item);
+		T item(std::move(*cell->item()));
+		cell->item()->~T();
+		release(cell, pos);
+		return item;
 	}
 
-	/// Copy constructor.
+	/// Not supported: another thread could dequeue (and destroy) the front element while the caller reads it.
 	template <typename T>
-	DoubleLinkedList<T>::DoubleLinkedList(const DoubleLinkedList& obj)
-	{
-		copyFrom(obj);
-	}
+	const T& MPMCQueue<T>::frontValue() const { throw std::logic_error("MPMCQueue doesn't support frontValue()"); }
 
-	/// Destructor. Delete all nodes in the list, including header node.
+	/// Get number of elements (positions claimed for enqueue minus positions claimed for dequeue). While other threads work, the result may be outdated as soon as it's returned.
 	template <typename T>
-	DoubleLinkedList<T>::~DoubleLinkedList()
+	size_t MPMCQueue<T>::length() const
 	{
-		delete head;
-		delete freelist;
+		size_t dequeued = dequeuePos.load(std::memory_order_acquire);
+		size_t enqueued = enqueuePos.load(std::memory_order_acquire);
+		return (enqueued > dequeued ? enqueued - dequeued : 0);
 	}
+
+	/// Check whether the queue has no elements (see length()).
+	template <typename T>
+	bool MPMCQueue<T>::empty() const { return length() == 0; }
+
+	/// Get the maximum number of elements.
+	template <typename T>
+	size_t MPMCQueue<T>::getCapacity() const { return capacity; }
+
+
+	// -- KVpair --------------------------------------
+
+	/// Default constructor.
+	template<typename K, typename E>
+	KVpair<K,E>::KVpair() { }
+
+	/// Constructor.
+	template<typename K, typename E>
+	KVpair<K,E>::KVpair(K key, E element)
+		: key(std::move(key)), element(std::move(element)) { }
+
+	/// Copy constructor.
+	template<typename K, typename E>
+	KVpair<K,E>::KVpair(const KVpair& obj)
+		: key(obj.key), element(obj.element) { }
 	
 	/// Copy-assignment operator overloading.
-	template <typename T>
-	DoubleLinkedList<T>& DoubleLinkedList<T>::operator=(const DoubleLinkedList& obj)
+	template<typename K, typename E>
+	KVpair<K, E>& KVpair<K,E>::operator=(const KVpair& obj)
 	{
 		if (this == &obj) return *this;
-		
-		if(head) delete head;
-		if(freelist) delete freelist;
 
-		copyFrom(obj);
+		key = obj.key;
+		element = obj.element;
 
 		return *this;
 	}
-	
-	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
-	template <typename T>
-	T& DoubleLinkedList<T>::operator[](size_t pos) const
+
+	/// Swap two pairs by moving them. Std algorithms (like std::stable_sort) call swap unqualified, which also finds dss::swap(T&, T&); this overload is more specialized, so the call isn't ambiguous.
+	template<typename K, typename E>
+	void swap(KVpair<K,E>& a, KVpair<K,E>& b) noexcept
 	{
-		if (pos >= count)
-			throw std::out_of_range("No current element");
+		KVpair<K,E> temp = std::move(a);
+		a = std::move(b);
+		b = std::move(temp);
+	}
 
-		DNode<T>* node = head->next;
-		for (size_t i = 0; i < pos; i++)
-			node = node->next;
 
-		return node->element;
-	}
-	
-	/// Allocate memory for a node (or take one node's address from freelist, if available), configure the new node, and return a pointer to it.
-	template <typename T>
-	DNode<T>* DoubleLinkedList<T>::newNode(const T& content, DNode<T>* prevNode, DNode<T>* nextNode)
+	// -- StaticArrayDictionary --------------------------------------
+
+	/// Constructor.
+	template <typename K, typename E>
+	StaticArrayDictionary<K,E>::StaticArrayDictionary(int size)
+		: list(size) { }
+
+	/// Copy-constructor.
+	template <typename K, typename E>
+	StaticArrayDictionary<K,E>::StaticArrayDictionary(const StaticArrayDictionary& obj)
+		: list(obj.list) { }
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	StaticArrayDictionary<K,E>::StaticArrayDictionary(StaticArrayDictionary&& obj) noexcept
+		: list(std::move(obj.list)) { }
+
+	/// Destructor.
+	template <typename K, typename E>
+	StaticArrayDictionary<K,E>::~StaticArrayDictionary() { }
+
+	/// Copy-assignment operator overloading.
+	template <typename K, typename E>
+	StaticArrayDictionary<K, E>& StaticArrayDictionary<K, E>::operator=(const StaticArrayDictionary& obj)
 	{
-		if (!freelist)
-			return new DNode<T>(content, prevNode, nextNode);
+		if (this == &obj) return *this;
 
-		DNode<T>* newNode = freelist;
-		freelist = freelist->next;
-		newNode->setNode(content, prevNode, nextNode);
-		return newNode;
+		list = obj.list;
+
+		return *this;
 	}
 
-	/// Save this node in the freelist (head)
-	template <typename T>
-	void DoubleLinkedList<T>::deleteNode(DNode<T>* node)
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	StaticArrayDictionary<K, E>& StaticArrayDictionary<K, E>::operator=(StaticArrayDictionary&& obj) noexcept
 	{
-		node->next = freelist;
-		freelist = node;
+		list = std::move(obj.list);
+
+		return *this;
 	}
 
-	/// Make the object a copy of another.
-	template <typename T>
-	void DoubleLinkedList<T>::copyFrom(const DoubleLinkedList& obj)
+	/// Sequential search over the contiguous pairs. Lookups don't move the list cursor, so several threads can read the dictionary at the same time.
+	template <typename K, typename E>
+	size_t StaticArrayDictionary<K, E>::indexOf(const K& k) const
 	{
-		head = new DNode<T>();
-		tail = new DNode<T>();
-		head->next = tail;
-		tail->prev = head;
-		curr = head;
-		count = 0;
-		freelist = nullptr;
+		const KVpair<K, E>* first = list.begin();
+		size_t count = list.length();
 
-		for (DNode<T>* node = obj.head->next; node != obj.tail; node = node->next)
-		{
-			append(node->element);
-			if (obj.curr == node) curr = tail->prev;
-		}
+		for (size_t i = 0; i < count; i++)
+			if (k == first[i].key) return i;
 
-		// freelist is not copied
+		return count;
 	}
 
-	/// Move all nodes in the list to the freelist, except header and tail node.
-	template <typename T>
-	void DoubleLinkedList<T>::clear()
+	/// Subscript operator overloading. Get the element of a key (throws if the key isn't in the dictionary).
+	template <typename K, typename E>
+	E& StaticArrayDictionary<K, E>::operator [](K k) const
 	{
-		if (count == 0) return;
+		size_t pos = indexOf(k);
+		if (pos == list.length()) throw std::out_of_range("Non-existent element");
 
-		tail->prev->next = freelist;
-		freelist = head->next;
+		return list[pos].element;
+	}
 
-		head->next = tail;
-		tail->prev = head;
+	/// Reinitialize dictionary.
+	template <typename K, typename E>
+	void StaticArrayDictionary<K, E>::clear() { list.clear(); }
 
-		curr = head;
-		count = 0;
+	/// Insert new element (append it to the list), or replace the element if the key is already in the dictionary.
+	template <typename K, typename E>
+	void StaticArrayDictionary<K, E>::insert(const K& k, const E& e)
+	{
+		size_t pos = indexOf(k);
+		if (pos < list.length())
+			list[pos].element = e;
+		else
+			list.append(KVpair<K, E>(k, e));
 	}
 
-	/// Store a new node in the list just before the current position.
-	template <typename T>
-	void DoubleLinkedList<T>::insert(const T& content)
+	// Find the element to remove using sequential search.
+	template <typename K, typename E>
+	E StaticArrayDictionary<K, E>::remove(const K& k)
 	{
-		curr->next = curr->next->prev = newNode(content, curr, curr->next);
+		size_t pos = indexOf(k);
+		if (pos == list.length()) throw std::out_of_range("Non-existent element");
 
-		count++;
+		list.moveToPos(pos);
+		return list.remove().element;
 	}
 
-	/// Store a new node at the end of the list (tail).
-	template <typename T>
-	void DoubleLinkedList<T>::append(const T& content)
+	/// Remove the last element.
+	template <typename K, typename E>
+	E StaticArrayDictionary<K, E>::removeAny()
 	{
-		tail->prev = tail->prev->next = newNode(content, tail->prev, tail);
-		
-		count++;
+		if(!length()) throw std::out_of_range("Dictionary is empty");
+
+		list.moveToPos(list.length() - 1);
+		return list.remove().element;
 	}
 
-	/// Remove the current node from the list and save it in the freelist.
-	template <typename T>
-	T DoubleLinkedList<T>::remove()
+	/// Find an element using sequential search. Returns nullptr if the key isn't in the dictionary.
+	template <typename K, typename E>
+	const E* StaticArrayDictionary<K, E>::find(const K& k) const
 	{
-		if (curr->next == tail) throw std::out_of_range("No current element");
+		size_t pos = indexOf(k);
+		return (pos < list.length() ? &list.begin()[pos].element : nullptr);
+	}
 
-		DNode<T>* extract = curr->next;
-		T content = extract->element;
+	/// Return list size.
+	template <typename K, typename E>
+	int StaticArrayDictionary<K, E>::length() const { return list.length(); }
 
-		curr->next->next->prev = curr;
-		curr->next = curr->next->next;
-		
-		deleteNode(extract);
-		count--;
-		return content;
+	/// Call visit(key, element) for every pair, in insertion order.
+	template <typename K, typename E>
+	void StaticArrayDictionary<K, E>::forEach(const std::function<void(const K&, const E&)>& visit) const
+	{
+		for (const KVpair<K, E>& pair : list)
+			visit(pair.key, pair.element);
 	}
 
-	/// Get the number of nodes in the list.
-	template <typename T>
-	size_t DoubleLinkedList<T>::length() const { return count; }
 
-	/// Get the position number of the current node.
-	template <typename T>
-	size_t DoubleLinkedList<T>::currPos() const
-	{
-		DNode<T>* node = head;
-		size_t i;
+	// -- SoAArrayDictionary --------------------------------------
 
-		for (i = 0; curr != node; i++)
-			node = node->next;
+	/// Constructor. Room for "size" pairs.
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>::SoAArrayDictionary(int size)
+		: keys(size), elements(size) { }
 
-		return i;
-	}
+	/// Copy constructor.
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>::SoAArrayDictionary(const SoAArrayDictionary& obj)
+		: keys(obj.keys), elements(obj.elements) { }
 
-	/// Get the item stored in the current node.
-	template <typename T>
-	const T& DoubleLinkedList<T>::getValue() const
+	/// Move constructor. The arrays of obj are taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>::SoAArrayDictionary(SoAArrayDictionary&& obj) noexcept
+		: keys(std::move(obj.keys)), elements(std::move(obj.elements)) { }
+
+	/// Destructor.
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>::~SoAArrayDictionary() { }
+
+	/// Copy-assignment operator overloading. If a copy throws, this dictionary is not modified (keys and elements stay paired).
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>& SoAArrayDictionary<K, E>::operator=(const SoAArrayDictionary& obj)
 	{
-		if (curr == tail->prev)
-			throw std::out_of_range("No current element");
-		
-		return curr->next->element;
+		if (this == &obj) return *this;
+
+		SoAArrayDictionary copy(obj);
+		return *this = std::move(copy);
 	}
 
-	/// Move curr to the header node.
-	template <typename T>
-	void DoubleLinkedList<T>::moveToStart() { curr = head; }
+	/// Move-assignment operator overloading. The arrays of obj are taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	SoAArrayDictionary<K, E>& SoAArrayDictionary<K, E>::operator=(SoAArrayDictionary&& obj) noexcept
+	{
+		keys = std::move(obj.keys);
+		elements = std::move(obj.elements);
 
-	/// Move curr to the tail (node one-past-the-end).
-	template <typename T>
-	void DoubleLinkedList<T>::moveToEnd() { curr = tail->prev; }
+		return *this;
+	}
 
-	/// Move curr to any position from 0 to one-past-the-end.
-	template <typename T>
-	void DoubleLinkedList<T>::moveToPos(size_t pos)
+	/// Sequential search over the keys array (SIMD for integer and floating-point keys).
+	template <typename K, typename E>
+	size_t SoAArrayDictionary<K, E>::indexOf(const K& k) const { return findContiguous(keys.begin(), keys.length(), k); }
+
+	/// Subscript operator overloading. Get the element of a key (throws if the key isn't in the dictionary).
+	template <typename K, typename E>
+	E& SoAArrayDictionary<K, E>::operator[](K k) const
 	{
-		if (pos > count)
-			throw std::out_of_range("No current element");
+		size_t pos = indexOf(k);
+		if (pos == keys.length()) throw std::out_of_range("Non-existent element");
 
-		curr = head;
-		for (size_t i = 0; i < pos; i++)
-			curr = curr->next;
+		return elements[pos];
 	}
 
-	/// Move curr to the previous node, except when curr==head.
-	template <typename T>
-	void DoubleLinkedList<T>::prev() { if (curr != head) curr = curr->prev; }
+	/// Reinitialize dictionary.
+	template <typename K, typename E>
+	void SoAArrayDictionary<K, E>::clear()
+	{
+		keys.clear();
+		elements.clear();
+	}
 
-	/// Move curr to the next node, if it exists (including one-past-the-end).
-	template <typename T>
-	void DoubleLinkedList<T>::next()
+	/// Insert new element (append it), or replace the element if the key is already in the dictionary. If copying the element throws, the key is removed again.
+	template <typename K, typename E>
+	void SoAArrayDictionary<K, E>::insert(const K& k, const E& e)
 	{
-		if (curr != tail->prev)
-			curr = curr->next;
+		size_t pos = indexOf(k);
+		if (pos < keys.length())
+		{
+			elements[pos] = e;
+			return;
+		}
+
+		keys.append(k);
+		try
+		{
+			elements.append(e);
+		}
+		catch (...)
+		{
+			keys.moveToPos(pos);
+			keys.remove();
+			throw;
+		}
 	}
 
+	/// Find the element to remove using sequential search, and remove it from both arrays (subsequent pairs are shifted).
+	template <typename K, typename E>
+	E SoAArrayDictionary<K, E>::remove(const K& k)
+	{
+		size_t pos = indexOf(k);
+		if (pos == keys.length()) throw std::out_of_range("Non-existent element");
 
-	// -- XorLinkedList --------------------------------------
+		keys.moveToPos(pos);
+		keys.remove();
+		elements.moveToPos(pos);
+		return elements.remove();
+	}
 
-	/// Constructor.
-	template <typename T>
-	XorLinkedList<T>::XorLinkedList(size_t unusedArg)
-		: count(0), freelist(nullptr)
+	/// Remove the last element.
+	template <typename K, typename E>
+	E SoAArrayDictionary<K, E>::removeAny()
 	{
-		head = new XorNode<T>();
-		tail = new XorNode<T>();
-		head->setNode(nullptr, tail);
-		tail->setNode(head, nullptr);
-		curr = head;
-		currPrev = nullptr;
+		if (!keys.length()) throw std::out_of_range("Dictionary is empty");
+
+		keys.moveToPos(keys.length() - 1);
+		keys.remove();
+		elements.moveToPos(elements.length() - 1);
+		return elements.remove();
 	}
 
-	/// Constructor. It takes an initialization list.
-	template <typename T>
-	XorLinkedList<T>::XorLinkedList(const std::initializer_list<T>& il)
-		: count(0), freelist(nullptr)
+	/// Find an element using sequential search over the keys. Returns nullptr if the key isn't in the dictionary.
+	template <typename K, typename E>
+	const E* SoAArrayDictionary<K, E>::find(const K& k) const
 	{
-		head = new XorNode<T>();
-		tail = new XorNode<T>();
-		head->setNode(nullptr, tail);
-		tail->setNode(head, nullptr);
-		curr = head;
-		currPrev = nullptr;
+		size_t pos = indexOf(k);
+		return (pos < keys.length() ? elements.begin() + pos : nullptr);
+	}
+
+	/// Return number of pairs.
+	template <typename K, typename E>
+	int SoAArrayDictionary<K, E>::length() const { return (int)keys.length(); }
+
+	/// Call visit(key, element) for every pair, in insertion order.
+	template <typename K, typename E>
+	void SoAArrayDictionary<K, E>::forEach(const std::function<void(const K&, const E&)>& visit) const
+	{
+		for (size_t i = 0; i < keys.length(); i++)
+			visit(keys[i], elements[i]);
+	}
+
+
+	// -- HashDictionary --------------------------------------
 
-		for (const T& item : il)
-			append(item);
+	/// Constructor. Reserve room for "size" keys.
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>::HashDictionary(int size)
+		: slots(nullptr), distances(nullptr), capacity(0), size(0), shift(64), maxLoadFactor(0.875f)
+	{
+		if (size > 0) reserve(size);
 	}
 
-	/// Copy constructor.
-	template <typename T>
-	XorLinkedList<T>::XorLinkedList(const XorLinkedList& obj)
+	/// Copy constructor. Pairs keep their slots (no rehashing).
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>::HashDictionary(const HashDictionary& obj)
+		: Dictionary<K, E>(), slots(nullptr), distances(nullptr), capacity(0), size(0), shift(64), maxLoadFactor(obj.maxLoadFactor), hasher(obj.hasher), equal(obj.equal)
 	{
 		copyFrom(obj);
 	}
 
-	/// Destructor. Delete all nodes in the list, including header node.
-	template <typename T>
-	XorLinkedList<T>::~XorLinkedList()
+	/// Move constructor. The table of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>::HashDictionary(HashDictionary&& obj) noexcept
+		: slots(obj.slots), distances(obj.distances), capacity(obj.capacity), size(obj.size), shift(obj.shift), maxLoadFactor(obj.maxLoadFactor), hasher(obj.hasher), equal(obj.equal)
 	{
-		deleteList(head, nullptr);
-		deleteList(freelist, nullptr);
+		obj.slots = nullptr;
+		obj.distances = nullptr;
+		obj.capacity = obj.size = 0;
+		obj.shift = 64;
 	}
 
-	/// Copy-assignment operator overloading.
-	template <typename T>
-	XorLinkedList<T>& XorLinkedList<T>::operator=(const XorLinkedList<T>& obj)
+	/// Destructor.
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>::~HashDictionary()
 	{
-		if (this == &obj) return *this;
-
-		deleteList(head, nullptr);
-		deleteList(freelist, nullptr);
-
-		copyFrom(obj);
+		destroyAll();
+		ArrayStorage<KVpair<K,E>>::deallocate(slots);
+		delete[] distances;
+	}
 
-		return *this;
+	/// Destroy all pairs.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::destroyAll()
+	{
+		if (!std::is_trivially_destructible<KVpair<K,E>>::value)
+			for (size_t i = 0; i < capacity; i++)
+				if (distances[i]) slots[i].~KVpair<K,E>();
 	}
 
-	/// Subscript operator overloading. It returns "const T&" instead of "T&" because node<T>::element returns "const T&". The current node is not changed.
-	template <typename T>
-	T& XorLinkedList<T>::operator[](size_t pos) const
+	/// Make the object (empty, with no table) a copy of another. If a copy throws, the object is left empty.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::copyFrom(const HashDictionary& obj)
 	{
-		if (pos >= count)
-			throw std::out_of_range("No current element");
+		if (!obj.capacity) return;
 
-		XorNode<T>* temp, *prevNode = head, *node = head->next(nullptr);
-		for (size_t i = 0; i < pos; i++)
+		KVpair<K,E>* newSlots = ArrayStorage<KVpair<K,E>>::allocate(obj.capacity);
+		uint16_t* newDistances = new uint16_t[obj.capacity]();
+
+		size_t i = 0;
+		try
 		{
-			temp = node;
-			node = node->next(prevNode);
-			prevNode = temp;
+			for (; i < obj.capacity; i++)
+				if (obj.distances[i])
+				{
+					new (newSlots + i) KVpair<K,E>(obj.slots[i]);
+					newDistances[i] = obj.distances[i];
+				}
 		}
-		
-		return node->element;
+		catch (...)
+		{
+			while (i--)
+				if (newDistances[i]) newSlots[i].~KVpair<K,E>();
+			ArrayStorage<KVpair<K,E>>::deallocate(newSlots);
+			delete[] newDistances;
+			throw;
+		}
+
+		slots = newSlots;
+		distances = newDistances;
+		capacity = obj.capacity;
+		size = obj.size;
+		shift = obj.shift;
 	}
 
-	/// Allocate memory for a node (or take one node's address from freelist, if available), configure the new node, and return a pointer to it.
-	template <typename T>
-	XorNode<T>* XorLinkedList<T>::newNode(const T& content, XorNode<T>* prevNode, XorNode<T>* nextNode)
+	/// Copy-assignment operator overloading. If a copy throws, this dictionary is not modified.
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>& HashDictionary<K, E, Hash, Eq>::operator=(const HashDictionary& obj)
 	{
-		if (!freelist)
-			return new XorNode<T>(content, prevNode, nextNode);
+		if (this == &obj) return *this;
 
-		XorNode<T>* node = freelist;
-		freelist = freelist->next(nullptr);
-		freelist->setNode(nullptr, freelist->next(node));
-		node->setNode(content, prevNode, nextNode);
-		return node;
+		HashDictionary copy(obj);
+		return *this = std::move(copy);
 	}
 
-	/// Save this node in the freelist (head)
-	template <typename T>
-	void XorLinkedList<T>::deleteNode(XorNode<T>* node)
+	/// Move-assignment operator overloading. The table of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E, typename Hash, typename Eq>
+	HashDictionary<K, E, Hash, Eq>& HashDictionary<K, E, Hash, Eq>::operator=(HashDictionary&& obj) noexcept
 	{
-		if(freelist)
-			freelist->setNode(node, freelist->next(nullptr));
+		if (this == &obj) return *this;
+
+		destroyAll();
+		ArrayStorage<KVpair<K,E>>::deallocate(slots);
+		delete[] distances;
 
-		node->setNode(nullptr, freelist);
-		freelist = node;
+		slots = obj.slots;
+		distances = obj.distances;
+		capacity = obj.capacity;
+		size = obj.size;
+		shift = obj.shift;
+		maxLoadFactor = obj.maxLoadFactor;
+		hasher = obj.hasher;
+		equal = obj.equal;
+
+		obj.slots = nullptr;
+		obj.distances = nullptr;
+		obj.capacity = obj.size = 0;
+		obj.shift = 64;
+
+		return *this;
 	}
 
-	/// Delete all nodes in a list. Used in the destructor.
-	template <typename T>
-	void XorLinkedList<T>::deleteList(XorNode<T>* node, XorNode<T>* prevNode)
+	/// Home slot of a key: the top log2(capacity) bits of its hash multiplied by 2^64/phi (Fibonacci hashing spreads consecutive and patterned hashes over the table).
+	template <typename K, typename E, typename Hash, typename Eq>
+	template <typename Q>
+	size_t HashDictionary<K, E, Hash, Eq>::home(const Q& key, unsigned shift) const
 	{
-		XorNode<T>* nextNode;
-		while (node)
-		{
-			nextNode = node->next(prevNode);
-			prevNode = node;
-			delete node;
-			node = nextNode;
-		}
+		return (size_t)(((uint64_t)hasher(key) * 0x9E3779B97F4A7C15ull) >> shift);
 	}
 
-	/// Make the object a copy of another.
-	template <typename T>
-	void XorLinkedList<T>::copyFrom(const XorLinkedList& obj)
+	/// Slot of a key, or npos. The search stops at an empty slot or at a key closer to its home than the searched key would be (Robin Hood invariant).
+	template <typename K, typename E, typename Hash, typename Eq>
+	template <typename Q>
+	size_t HashDictionary<K, E, Hash, Eq>::findIndex(const Q& key) const
 	{
-		count = 0;
-		freelist = nullptr;
-		head = new XorNode<T>();
-		tail = new XorNode<T>();
-		head->setNode(nullptr, tail);
-		tail->setNode(head, nullptr);
-		curr = head;
-		currPrev = nullptr;
+		if (!size) return npos;
 
-		XorNode<T>* temp, * node = obj.head, * prevNode = nullptr;
-		while (node != obj.tail->prev(nullptr))
+		size_t mask = capacity - 1;
+		size_t index = home(key, shift);
+		for (uint16_t distance = 1; distance <= distances[index]; distance++)
 		{
-			temp = node;
-			node = node->next(prevNode);
-			prevNode = temp;
+			if (distances[index] == distance && equal(slots[index].key, key))
+				return index;
 
-			append(node->element);
-			if (obj.curr == node)
-			{
-				curr = tail->prev(nullptr);
-				currPrev = curr->prev(tail);
-			}
+			index = (index + 1) & mask;
 		}
 
-		// freelist is not copied
+		return npos;
 	}
 
-	/// Move all nodes in the list to the freelist, except header and tail node.
-	template <typename T>
-	void XorLinkedList<T>::clear()
+	/// Insert a pair whose key isn't in the table. The pair being placed swaps with any pair that is closer to its home. The pairs between its home and the next empty slot may move one slot further, so that run is checked first: if a distance would reach maxDistance (only with a degenerate hash), it throws before changing the table.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::insertNew(KVpair<K,E>&& pair)
 	{
-		if (count == 0) return;
-
-		XorNode<T>* prevTail = tail->prev(nullptr);
-		XorNode<T>* nextHead = head->next(nullptr);
-		
-		prevTail->setNode(prevTail->prev(tail), freelist);
-		nextHead->setNode(nullptr, nextHead->next(head));
+		size_t mask = capacity - 1;
+		size_t index = home(pair.key, shift);
+		uint16_t distance = 1;
 
-		if(freelist)
-			freelist->setNode(prevTail, freelist->next(nullptr));
-		freelist = nextHead;
-		
-		head->setNode(nullptr, tail);
-		tail->setNode(head, nullptr);
+		for (size_t i = index, run = 1; distances[i]; i = (i + 1) & mask, run++)
+			if (run >= maxDistance || distances[i] >= maxDistance)
+				throw std::length_error("Probe sequence too long (degenerate hash function)");
 
-		curr = head;
-		currPrev = nullptr;
-		count = 0;
-	}
+		while (distances[index])
+		{
+			if (distances[index] < distance)
+			{
+				std::swap(pair, slots[index]);
+				std::swap(distance, distances[index]);
+			}
 
-	/// Store a new node in the list just before the current position.
-	template <typename T>
-	void XorLinkedList<T>::insert(const T& content)
-	{
-		XorNode<T>* nextNode = curr->next(currPrev);
-		XorNode<T>* node = newNode(content, curr, nextNode);
-		
-		nextNode->setNode(node, nextNode->next(curr));
-		curr->setNode(currPrev, node);
+			index = (index + 1) & mask;
+			distance++;
+		}
 
-		count++;
+		new (slots + index) KVpair<K,E>(std::move(pair));
+		distances[index] = distance;
+		size++;
 	}
 
-	/// Store a new node at the end of the list (tail).
-	template <typename T>
-	void XorLinkedList<T>::append(const T& content)
+	/// Destroy the pair at index, and shift back the following pairs that are displaced from their home (backward-shift deletion).
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::removeAt(size_t index)
 	{
-		XorNode<T>* prevNode = tail->prev(nullptr);
-		XorNode<T>* node = newNode(content, prevNode, tail);
+		size_t mask = capacity - 1;
+		size_t next = (index + 1) & mask;
 
-		prevNode->setNode(prevNode->prev(tail), node);
-		tail->setNode(node, nullptr);
+		while (distances[next] > 1)
+		{
+			slots[index] = std::move(slots[next]);
+			distances[index] = distances[next] - 1;
+			index = next;
+			next = (next + 1) & mask;
+		}
 
-		count++;
+		slots[index].~KVpair<K,E>();
+		distances[index] = 0;
+		size--;
 	}
 
-	/// Remove the current node from the list and save it in the freelist.
-	template <typename T>
-	T XorLinkedList<T>::remove()
+	/// Move the pairs to a new table with newCapacity slots (a power of two). The new slot of every pair is found first (Robin Hood placement of the old slot indexes), and the pairs are moved only once all of them have a slot. Pairs whose move may throw are copied. If anything throws (an allocation, a hash, a copy, or a probe sequence that gets too long), the table is unchanged.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::rehash(size_t newCapacity)
 	{
-		if (curr->next(currPrev) == tail) throw std::out_of_range("No current element");
-
-		XorNode<T>* remNode = curr->next(currPrev);
-		T content = remNode->element;
-		XorNode<T>* nextNode = remNode->next(curr);
-		
-		curr->setNode(currPrev, nextNode);
-		nextNode->setNode(curr, nextNode->next(remNode));
+		unsigned newShift = 64;
+		for (size_t c = newCapacity; c > 1; c >>= 1) newShift--;
 
-		deleteNode(remNode);
-		count--;
-		return content;
-	}
-
-	/// Get the number of nodes in the list.
-	template <typename T>
-	size_t XorLinkedList<T>::length() const { return count; }
-
-	/// Get the position number of the current node.
-	template <typename T>
-	size_t XorLinkedList<T>::currPos() const
-	{
-		XorNode<T> *nextNode, *prevNode = nullptr, *node = head;
+		std::vector<size_t> sources(newCapacity);   // Old slot of the pair placed in each new slot
+		uint16_t* newDistances = new uint16_t[newCapacity]();
+		KVpair<K,E>* newSlots = nullptr;
+		size_t mask = newCapacity - 1;
 		size_t i = 0;
-		while (node != curr)
+
+		try
 		{
-			nextNode = node->next(prevNode);
-			prevNode = node;
-			node = nextNode;
-			i++;
+			for (size_t j = 0; j < capacity; j++)
+				if (distances[j])
+				{
+					size_t source = j;
+					size_t index = home(slots[j].key, newShift);
+					uint16_t distance = 1;
+
+					while (newDistances[index])
+					{
+						if (distance >= maxDistance)
+							throw std::length_error("Probe sequence too long (degenerate hash function)");
+
+						if (newDistances[index] < distance)
+						{
+							std::swap(source, sources[index]);
+							std::swap(distance, newDistances[index]);
+						}
+
+						index = (index + 1) & mask;
+						distance++;
+					}
+
+					sources[index] = source;
+					newDistances[index] = distance;
+				}
+
+			newSlots = ArrayStorage<KVpair<K,E>>::allocate(newCapacity);
+			for (; i < newCapacity; i++)
+				if (newDistances[i])
+					new (newSlots + i) KVpair<K,E>(std::move_if_noexcept(slots[sources[i]]));
+		}
+		catch (...)
+		{
+			while (i--)
+				if (newDistances[i]) newSlots[i].~KVpair<K,E>();
+			ArrayStorage<KVpair<K,E>>::deallocate(newSlots);
+			delete[] newDistances;
+			throw;
 		}
 
-		return i;
+		destroyAll();
+		ArrayStorage<KVpair<K,E>>::deallocate(slots);
+		delete[] distances;
+
+		slots = newSlots;
+		distances = newDistances;
+		capacity = newCapacity;
+		shift = newShift;
 	}
 
-	/// Get the item stored in the current node.
-	template <typename T>
-	const T& XorLinkedList<T>::getValue() const
+	/// Subscript operator overloading. Get the element of a key (throws if the key isn't in the dictionary).
+	template <typename K, typename E, typename Hash, typename Eq>
+	E& HashDictionary<K, E, Hash, Eq>::operator[](K k) const
 	{
-		if (curr == tail->prev(nullptr))
-			throw std::out_of_range("No current element");
+		size_t index = findIndex(k);
+		if (index == npos) throw std::out_of_range("Non-existent element");
 
-		return curr->next(currPrev)->element;
+		return slots[index].element;
 	}
 
-	/// Move curr to the header node.
-	template <typename T>
-	void XorLinkedList<T>::moveToStart()
+	/// Remove all pairs. Capacity is kept.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::clear()
 	{
-		curr = head;
-		currPrev = nullptr;
+		destroyAll();
+		if (capacity) std::memset(distances, 0, capacity * sizeof(uint16_t));
+		size = 0;
 	}
 
-	/// Move curr to the tail (node one-past-the-end).
-	template <typename T>
-	void XorLinkedList<T>::moveToEnd()
+	/// Insert a new pair, or replace the element if the key is already in the dictionary. The table doubles if the number of keys would exceed capacity * maxLoadFactor. If a hash throws, or the probe sequence would get too long, the dictionary is unchanged; if assigning the element or moving a pair throws, it stays valid but pairs may be lost.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::insert(const K& k, const E& e)
 	{
-		curr = tail->prev(nullptr);
-		currPrev = curr->prev(tail);
+		size_t index = findIndex(k);
+		if (index != npos)
+		{
+			slots[index].element = e;
+			return;
+		}
+
+		KVpair<K,E> pair(k, e);   // Built before rehashing, so k and e may refer to a pair of this table
+		if (size + 1 > capacity * maxLoadFactor)
+			rehash(capacity ? capacity * 2 : minCapacity);
+
+		insertNew(std::move(pair));
 	}
 
-	/// Move curr to any position from 0 to one-past-the-end.
-	template <typename T>
-	void XorLinkedList<T>::moveToPos(size_t pos)
+	/// Remove a key and return its element.
+	template <typename K, typename E, typename Hash, typename Eq>
+	E HashDictionary<K, E, Hash, Eq>::remove(const K& k)
 	{
-		if (pos > count)
-			throw std::out_of_range("No current element");
+		size_t index = findIndex(k);
+		if (index == npos) throw std::out_of_range("Non-existent element");
 
-		curr = head;
-		currPrev = nullptr;
-		XorNode<T>* temp;
-		for (size_t i = 0; i < pos; i++)
-		{
-			temp = curr;
-			curr = curr->next(currPrev);
-			currPrev = temp;
-		}
+		E element = std::move(slots[index].element);
+		removeAt(index);
+		return element;
 	}
 
-	/// Move curr to the previous node, except when curr==head.
-	template <typename T>
-	void XorLinkedList<T>::prev()
+	/// Remove some key (the first one in the table) and return its element.
+	template <typename K, typename E, typename Hash, typename Eq>
+	E HashDictionary<K, E, Hash, Eq>::removeAny()
 	{
-		if (curr != head)
-		{
-			XorNode<T>* temp = curr;
-			curr = curr->prev(curr->next(currPrev));
-			currPrev = curr->prev(temp);
-		}
+		if (!size) throw std::out_of_range("Dictionary is empty");
+
+		size_t index = 0;
+		while (!distances[index]) index++;
+
+		E element = std::move(slots[index].element);
+		removeAt(index);
+		return element;
 	}
 
-	/// Move curr to the next node, if it exists (including one-past-the-end).
-	template <typename T>
-	void XorLinkedList<T>::next()
+	/// Find the element of a key. Returns nullptr if the key isn't in the dictionary.
+	template <typename K, typename E, typename Hash, typename Eq>
+	const E* HashDictionary<K, E, Hash, Eq>::find(const K& k) const
 	{
-		if (curr != tail->prev(nullptr))
-		{
-			XorNode<T>* temp = curr;
-			curr = curr->next(currPrev);
-			currPrev = temp;
-		}
+		size_t index = findIndex(k);
+		return (index == npos ? nullptr : &slots[index].element);
 	}
 
+	/// Find the element of a key given as another type (requires transparent Hash and Eq, that hash equal keys of both types to the same value). No K is constructed.
+	template <typename K, typename E, typename Hash, typename Eq>
+	template <typename Q, typename H, typename EqQ, typename, typename>
+	const E* HashDictionary<K, E, Hash, Eq>::find(const Q& key) const
+	{
+		size_t index = findIndex(key);
+		return (index == npos ? nullptr : &slots[index].element);
+	}
 
-	// -- SArrayStack --------------------------------------
+	/// Check whether a key is in the dictionary. It may be given as another type if Hash and Eq are transparent.
+	template <typename K, typename E, typename Hash, typename Eq>
+	template <typename Q>
+	bool HashDictionary<K, E, Hash, Eq>::contains(const Q& key) const { return findIndex(key) != npos; }
 
-	/// Constructor.
-	template<typename T>
-	SArrayStack<T>::SArrayStack(size_t size)
-		: Stack(), array(new T[size]), capacity(size), top(0) { }
+	/// Get number of keys.
+	template <typename K, typename E, typename Hash, typename Eq>
+	int HashDictionary<K, E, Hash, Eq>::length() const { return (int)size; }
 
-	/// Copy constructor.
-	template<typename T>
-	SArrayStack<T>::SArrayStack(const SArrayStack& obj)
-		: Stack(obj)
+	/// Call visit(key, element) for every pair, in slot order.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::forEach(const std::function<void(const K&, const E&)>& visit) const
 	{
-		copyFrom(obj);
+		for (size_t i = 0; i < capacity; i++)
+			if (distances[i]) visit(slots[i].key, slots[i].element);
 	}
 
-	/// Destructor.
-	template<typename T>
-	SArrayStack<T>::~SArrayStack() { delete[] array; }
-
-	/// Make the object a copy of another.
-	template<typename T>
-	void SArrayStack<T>::copyFrom(const SArrayStack& obj)
+	/// Make room for "count" keys, so no rehashing happens until there are more.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::reserve(size_t count)
 	{
-		array = new T[obj.capacity];
-		capacity = obj.capacity;
-		top = obj.top;
-		
-		for (size_t i = 0; i < top; i++)
-			array[i] = obj.array[i];
+		size_t newCapacity = capacity ? capacity : minCapacity;
+		while (count > newCapacity * maxLoadFactor) newCapacity *= 2;
+
+		if (newCapacity > capacity)
+			rehash(newCapacity);
 	}
 
-	/// Copy-assignment operator overloading.
-	template <typename T>
-	SArrayStack<T>& SArrayStack<T>::operator=(const SArrayStack& obj)
+	/// Set the maximum fraction of occupied slots, in (0, 1) (default: 0.875). Higher values save memory; lower values shorten probe sequences. The table grows now if it already exceeds it.
+	template <typename K, typename E, typename Hash, typename Eq>
+	void HashDictionary<K, E, Hash, Eq>::setMaxLoadFactor(float loadFactor)
 	{
-		if (this == &obj) return *this;
+		if (!(loadFactor > 0 && loadFactor < 1)) throw std::invalid_argument("Load factor must be in (0, 1)");
 
-		if (array) delete[] array;
+		maxLoadFactor = loadFactor;
+		reserve(size);
+	}
 
-		copyFrom(obj);
+	/// Get the maximum load factor.
+	template <typename K, typename E, typename Hash, typename Eq>
+	float HashDictionary<K, E, Hash, Eq>::getMaxLoadFactor() const { return maxLoadFactor; }
 
-		return *this;
-	}
+	/// Get number of slots.
+	template <typename K, typename E, typename Hash, typename Eq>
+	size_t HashDictionary<K, E, Hash, Eq>::getCapacity() const { return capacity; }
 
-	/// Remove all elements.
-	template<typename T>
-	void SArrayStack<T>::clear() { top = 0; }
 
-	/// Insert new element at the top.
-	template<typename T>
-	void SArrayStack<T>::push(const T& newElement)
-	{
-		if(top == capacity) throw std::out_of_range("Stack is full");
+	// -- SortedStaticArray --------------------------------------
 
-		array[top++] = newElement;
-	}
+	/// Constructor.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::SortedStaticArray(size_t capacity)
+		: StaticArray<KVpair<K,E>>(capacity) { }
 
-	/// Extract top element
-	template<typename T>
-	T SArrayStack<T>::pop()
-	{
-		if(top == 0) throw std::out_of_range("Stack is empty");
-		
-		return array[--top];
-	}
+	/// Constructor. Copy the pairs of the initializer list and sort them.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::SortedStaticArray(const std::initializer_list<KVpair<K,E>>& il)
+		: SortedStaticArray(il.begin(), il.end()) { }
 
-	/// Get top element
-	template<typename T>
-	const T& SArrayStack<T>::topValue() const
+	/// Constructor (bulk load). Copy the pairs [first, last) and sort them once (stable: equal keys keep their order). Capacity is at least the number of pairs.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::SortedStaticArray(const KVpair<K,E>* first, const KVpair<K,E>* last, size_t capacity)
+		: StaticArray<KVpair<K,E>>(std::max(capacity, (size_t)(last - first)))
 	{
-		if(top == 0) throw std::out_of_range("Stack is empty");
-
-		return array[top - 1];
+		this->appendRange(first, last);
+		std::stable_sort(this->array, this->array + this->size, keyLess);
 	}
 
-	/// Get number of active elements.
-	template<typename T>
-	size_t SArrayStack<T>::length() const { return top; }
-
+	/// Copy constructor.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::SortedStaticArray(const SortedStaticArray& obj)
+		: StaticArray<KVpair<K,E>>(obj) { }
 
-	// -- LinkedStack --------------------------------------
+	/// Move constructor. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::SortedStaticArray(SortedStaticArray&& obj) noexcept
+		: StaticArray<KVpair<K,E>>(std::move(obj)) { }
 
-	/// Constructor.
-	template<typename T>
-	LinkedStack<T>::LinkedStack(size_t unusedArg) : top(nullptr), size(0) { }
+	/// Destructor.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>::~SortedStaticArray() { }
 
-	/// Copy constructor
-	template<typename T>
-	LinkedStack<T>::LinkedStack(const LinkedStack& obj)
+	/// Copy-assignment operator overloading.
+	template <typename K, typename E>
+	SortedStaticArray<K,E>& SortedStaticArray<K,E>::operator=(const SortedStaticArray& obj)
 	{
-		copyFrom(obj);
+		StaticArray<KVpair<K,E>>::operator=(obj);
+		return *this;
 	}
 
-	/// Destructor.
-	template<typename T>
-	LinkedStack<T>::~LinkedStack() { clear(); }
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (capacity 0).
+	template <typename K, typename E>
+	SortedStaticArray<K,E>& SortedStaticArray<K,E>::operator=(SortedStaticArray&& obj) noexcept
+	{
+		StaticArray<KVpair<K,E>>::operator=(std::move(obj));
+		return *this;
+	}
 
-	/// Copy assignment operator overloading.
-	template<typename T>
-	LinkedStack<T>& LinkedStack<T>::operator=(const LinkedStack& obj)
+	/// Get the pair at position i (read only: changing a key could break the order).
+	template <typename K, typename E>
+	const KVpair<K,E>& SortedStaticArray<K,E>::at(size_t i) const
 	{
-		if (this == &obj) return *this;
+		if (i >= this->size) throw std::out_of_range("Out of range");
 
-		if (top) delete[] top;
+		return this->array[i];
+	}
 
-		copyFrom(obj);
+	/// Insert a pair after the pairs with smaller or equal keys (binary search). The cursor is left at the new pair.
+	template <typename K, typename E>
+	void SortedStaticArray<K,E>::insert(const KVpair<K,E>& item)
+	{
+		this->moveToPos(upper_bound(item.key));
+		StaticArray<KVpair<K,E>>::insert(item);
+	}
 
-		return *this;
+	/// Move a pair after the pairs with smaller or equal keys (binary search). The cursor is left at the new pair.
+	template <typename K, typename E>
+	void SortedStaticArray<K,E>::insert(KVpair<K,E>&& item)
+	{
+		this->moveToPos(upper_bound(item.key));
+		StaticArray<KVpair<K,E>>::insert(std::move(item));
 	}
 
-	/// Delete current elements and copy the elements stored in another linked list 
-	template<typename T>
-	void LinkedStack<T>::copyFrom(const LinkedStack& obj)
+	/// Insert the pairs [first, last) (in any order). The batch is sorted (stable) and merged with the array in one pass into a new buffer, instead of shifting the array once per pair. Pairs of the batch go after existing pairs with equal keys. If a copy throws, the array is not modified (unless moving pairs may throw too).
+	template <typename K, typename E>
+	void SortedStaticArray<K,E>::insertRange(const KVpair<K,E>* first, const KVpair<K,E>* last)
 	{
-		size = 0;
-		top = nullptr;
+		size_t count = last - first;
+		if (this->size + count > this->capacity)
+			throw std::out_of_range("List capacity exceeded");
+		if (!count) return;
 
-		std::vector<T*> elements;
-		for(SNode<T>* node = obj.top; node; node = node->next)
-			elements.push_back(&(node->element));
+		std::vector<KVpair<K,E>> batch(first, last);   // Copied: [first, last) may be part of this array
+		if (!std::is_sorted(batch.begin(), batch.end(), keyLess))
+			std::stable_sort(batch.begin(), batch.end(), keyLess);
 
-		for (auto it = elements.rbegin(); it != elements.rend(); ++it)
-			push(**it);
+		KVpair<K,E>* merged = ArrayStorage<KVpair<K,E>>::allocate(this->capacity);
+		size_t i = 0, j = 0, out = 0;
+		try
+		{
+			while (i < this->size || j < count)
+			{
+				if (j == count || (i < this->size && !(batch[j].key < this->array[i].key)))
+					new (merged + out++) KVpair<K,E>(std::move_if_noexcept(this->array[i++]));
+				else
+					new (merged + out++) KVpair<K,E>(std::move(batch[j++]));
+			}
+		}
+		catch (...)
+		{
+			ArrayStorage<KVpair<K,E>>::destroy(merged, merged + out);
+			ArrayStorage<KVpair<K,E>>::deallocate(merged);
+			throw;
+		}
+
+		ArrayStorage<KVpair<K,E>>::destroy(this->array, this->array + this->size);
+		ArrayStorage<KVpair<K,E>>::deallocate(this->array);
+		this->array = merged;
+		this->size = out;
 	}
 
-	/// Remove al elements.
-	template<typename T>
-	void LinkedStack<T>::clear()
+	/// Keep only the last pair of each group of equal keys (the most recently inserted one). Returns the number of pairs removed. The cursor goes to the start.
+	template <typename K, typename E>
+	size_t SortedStaticArray<K,E>::removeDuplicateKeys()
 	{
-		delete top;
-		top = nullptr;
-		size = 0;
+		size_t kept = 0;
+		for (size_t i = 0; i < this->size; i++)
+		{
+			if (i + 1 < this->size && !(this->array[i].key < this->array[i + 1].key)) continue;   // The next pair has the same key
+			if (kept != i) this->array[kept] = std::move(this->array[i]);
+			kept++;
+		}
+
+		size_t removed = this->size - kept;
+		ArrayStorage<KVpair<K,E>>::destroy(this->array + kept, this->array + this->size);
+		this->size = kept;
+		this->curr = 0;
+		return removed;
 	}
 
-	/// Insert new node.
-	template<typename T>
-	void LinkedStack<T>::push(const T& newElement)
+	/// Position of the first pair whose key is not less than k (length() if none). Branchless binary search: the range halves on every step, and the comparison only selects the next base (compiled to a conditional move), so there are no mispredicted branches.
+	template <typename K, typename E>
+	size_t SortedStaticArray<K,E>::lower_bound(const K& k) const
 	{
-		top = new SNode<T>(newElement, top);
-		size++;
+		const KVpair<K,E>* base = this->array;
+		size_t n = this->size;
+		if (!n) return 0;
+
+		while (n > 1)
+		{
+			size_t half = n / 2;
+			base = (base[half].key < k ? base + half : base);
+			n -= half;
+		}
+
+		return (base - this->array) + (base->key < k);
 	}
 
-	/// Extract top node.
-	template<typename T>
-	T LinkedStack<T>::pop()
+	/// Position of the first pair whose key is greater than k (length() if none). Branchless binary search (see lower_bound()).
+	template <typename K, typename E>
+	size_t SortedStaticArray<K,E>::upper_bound(const K& k) const
 	{
-		if (!top) throw std::out_of_range("Stack is empty");
+		const KVpair<K,E>* base = this->array;
+		size_t n = this->size;
+		if (!n) return 0;
 
-		T content = top->element;
-		SNode<T>* nextNode = top->next;
-		top->next = nullptr;
-		delete top;
-		top = nextNode;
-		size--;
-		return content;
+		while (n > 1)
+		{
+			size_t half = n / 2;
+			base = (k < base[half].key ? base : base + half);
+			n -= half;
+		}
+
+		return (base - this->array) + !(k < base->key);
 	}
 
-	/// Get element's value from the top node.
-	template<typename T>
-	const T& LinkedStack<T>::topValue() const
+	/// Position of the first pair with key k, or length() if there is none. The cursor is not moved.
+	template <typename K, typename E>
+	size_t SortedStaticArray<K,E>::find(const K& k) const
 	{
-		if (!top) throw std::out_of_range("Stack is empty");
+		size_t pos = lower_bound(k);
+		return (pos < this->size && !(k < this->array[pos].key) ? pos : this->size);
+	}
 
-		return top->element;
+	/// Positions [first, last) of the pairs with keys in [low, high].
+	template <typename K, typename E>
+	std::pair<size_t, size_t> SortedStaticArray<K,E>::range(const K& low, const K& high) const
+	{
+		size_t first = lower_bound(low);
+		return { first, std::max(first, upper_bound(high)) };
 	}
 
-	/// Return the list length.
-	template<typename T>
-	size_t LinkedStack<T>::length() const { return size; }
+	/// Pointer to the first pair (read only).
+	template <typename K, typename E>
+	typename SortedStaticArray<K,E>::const_iterator SortedStaticArray<K,E>::begin() const { return this->array; }
 
+	/// Pointer past the last pair.
+	template <typename K, typename E>
+	typename SortedStaticArray<K,E>::const_iterator SortedStaticArray<K,E>::end() const { return this->array + this->size; }
 
-	// -- SArrayQueue --------------------------------------
+	/// Compare pairs by key.
+	template <typename K, typename E>
+	bool SortedStaticArray<K,E>::keyLess(const KVpair<K,E>& a, const KVpair<K,E>& b) { return a.key < b.key; }
 
-	/// Constructor. Make list array one position larger for empty slot.
-	template<typename T>
-	SArrayQueue<T>::SArrayQueue(size_t size)
-		: capacity(size + 1), rear(0), front(1), array(new T[capacity]) { }
 
-	/// Copy constructor
-	template<typename T>
-	SArrayQueue<T>::SArrayQueue(const SArrayQueue& obj)
-		: capacity(obj.capacity), rear(obj.rear), front(obj.front), array(new T[capacity])
+	// -- SortedStaticArrayDictionary --------------------------------------
+
+	/// Constructor.
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K,E>::SortedStaticArrayDictionary(int size)
+		: list(size) { }
+
+	/// Constructor (bulk load). Copy the pairs [first, last), sort them once and drop repeated keys (the last pair wins). Capacity is at least the number of pairs.
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K,E>::SortedStaticArrayDictionary(const KVpair<K,E>* first, const KVpair<K,E>* last, int size)
+		: list(first, last, size > 0 ? size : 0)
 	{
-		copyFrom(obj);
+		list.removeDuplicateKeys();
 	}
 
+	/// Copy constructor.
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K, E>::SortedStaticArrayDictionary(const SortedStaticArrayDictionary& obj)
+		: list(obj.list) { }
+
+	/// Move constructor. The array of obj is taken, and obj is left empty (capacity 0).
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K, E>::SortedStaticArrayDictionary(SortedStaticArrayDictionary&& obj) noexcept
+		: list(std::move(obj.list)) { }
+
 	/// Destructor
-	template<typename T>
-	SArrayQueue<T>::~SArrayQueue() { if(array) delete[] array; }
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K, E>::~SortedStaticArrayDictionary() { }
 
-	/// Copy-assignment operator overloading
-	template<typename T>
-	SArrayQueue<T>& SArrayQueue<T>::operator=(const SArrayQueue& obj)
+	/// Copy-assignment operator overloading.
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K, E>& SortedStaticArrayDictionary<K, E>::operator=(const SortedStaticArrayDictionary& obj)
 	{
 		if (this == &obj) return *this;
 
-		if (array) delete[] array;
-
-		copyFrom(obj);
+		list = obj.list;
 
 		return *this;
 	}
 
-	/// Make an object a copy of another.
-	template<typename T>
-	void SArrayQueue<T>::copyFrom(const SArrayQueue& obj)
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty (capacity 0).
+	template<typename K, typename E>
+	SortedStaticArrayDictionary<K, E>& SortedStaticArrayDictionary<K, E>::operator=(SortedStaticArrayDictionary&& obj) noexcept
 	{
-		capacity = obj.capacity;
-		rear = obj.rear;
-		front = obj.front;
-		array = new T[capacity];
+		list = std::move(obj.list);
 
-		size_t pos, size = length();
-		for (size_t i = 0; i < size; i++)
-		{
-			pos = (front + i) % capacity;
-			array[pos] = obj.array[pos];
-		}
+		return *this;
 	}
 
-	/// Reinitialize the queue.
-	template<typename T>
-	void SArrayQueue<T>::clear()
+	/// Element of key k, or nullptr (binary search).
+	template<typename K, typename E>
+	E* SortedStaticArrayDictionary<K, E>::findElement(const K& k) const
 	{
-		rear = 0;
-		front = 1;
+		size_t pos = list.find(k);
+		return (pos < list.size ? &list.array[pos].element : nullptr);
 	}
 
-	/// Insert new element at the rear. Queue is full when rear is 2 steps behind front.
-	template<typename T>
-	void SArrayQueue<T>::enqueue(const T& newElement)
+	/// Subscript operator overloading. Get the element of a key (throws if the key isn't in the dictionary).
+	template<typename K, typename E>
+	E& SortedStaticArrayDictionary<K, E>::operator[](K k) const
 	{
-		if ((rear + 2) % capacity == front) throw std::out_of_range("Queue is full");
+		E* element = findElement(k);
+		if (!element) throw std::out_of_range("Non-existent element");
 
-		rear = (rear + 1) % capacity;
-		array[rear] = newElement;
+		return *element;
 	}
 
-	/// Extract element from the front. Queue is empty when rear is right before front.
-	template<typename T>
-	T SArrayQueue<T>::dequeue()
+	/// Reinitialization.
+	template<typename K, typename E>
+	void SortedStaticArrayDictionary<K, E>::clear() { list.clear(); }
+
+	/// Insert an element while keeping elements sorted, or replace the element if the key is already in the dictionary.
+	template<typename K, typename E>
+	void SortedStaticArrayDictionary<K, E>::insert(const K& k, const E& e)
 	{
-		if ((rear + 1) % capacity == front) throw std::out_of_range("Queue is empty");
-		T it = array[front];
-		front = (front + 1) % capacity;
-		return it;
+		size_t pos = list.lower_bound(k);
+		if (pos < list.size && !(k < list.array[pos].key))
+			list.array[pos].element = e;
+		else
+		{
+			list.moveToPos(pos);
+			list.StaticArray<KVpair<K,E>>::insert(KVpair<K, E>(k, e));
+		}
 	}
 
-	/// Get value of front element.
-	template<typename T>
-	const T& SArrayQueue<T>::frontValue() const
+	/// Insert a batch of pairs (in any order). Elements of keys already in the dictionary are replaced, and the new keys are merged in one pass (see SortedStaticArray::insertRange()). For repeated keys in the batch, the last pair wins. If the new keys don't fit, nothing is modified.
+	template<typename K, typename E>
+	void SortedStaticArrayDictionary<K, E>::insertRange(const KVpair<K,E>* first, const KVpair<K,E>* last)
 	{
-		if (length() == 0) throw std::out_of_range("Queue is empty");
-		return array[front];
-	}
+		std::vector<KVpair<K,E>> batch(first, last);
+		std::stable_sort(batch.begin(), batch.end(), SortedStaticArray<K,E>::keyLess);
 
-	/// Return length.
-	template<typename T>
-	size_t SArrayQueue<T>::length() const { return (rear - front + 1 + capacity) % capacity; }
+		std::vector<E*> existing(batch.size(), nullptr);
+		size_t newKeys = 0;
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			if (i + 1 < batch.size() && !(batch[i].key < batch[i + 1].key)) continue;   // A later pair has the same key
+			existing[i] = findElement(batch[i].key);
+			if (!existing[i]) newKeys++;
+		}
 
+		if (list.size + newKeys > list.capacity)
+			throw std::out_of_range("List capacity exceeded");
 
-	// -- LinkedQueue --------------------------------------
+		std::vector<KVpair<K,E>> fresh;
+		fresh.reserve(newKeys);
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			if (i + 1 < batch.size() && !(batch[i].key < batch[i + 1].key)) continue;
+			if (existing[i]) *existing[i] = std::move(batch[i].element);
+			else fresh.push_back(std::move(batch[i]));
+		}
 
-	template<typename T>
-	LinkedQueue<T>::LinkedQueue(size_t unusedArg)
-		: front(new SNode<T>), rear(front), size(0) { }
-	
-	template<typename T>
-	LinkedQueue<T>::LinkedQueue(const LinkedQueue& obj)
-	{
-		copyFrom(obj);
+		list.insertRange(fresh.data(), fresh.data() + fresh.size());
 	}
 
-	template<typename T>
-	LinkedQueue<T>::~LinkedQueue()
+	/// Find the element to remove using binary search, remove it, and shift subsequent elements.
+	template<typename K, typename E>
+	E SortedStaticArrayDictionary<K, E>::remove(const K& k)
 	{
-		delete front;
+		size_t pos = list.find(k);
+		if (pos == list.size) throw std::out_of_range("Non-existent element");
+
+		list.moveToPos(pos);
+		return list.remove().element;
 	}
 
-	template<typename T>
-	LinkedQueue<T>& LinkedQueue<T>::operator=(const LinkedQueue& obj)
+	/// Remove last element (the one with the largest key).
+	template<typename K, typename E>
+	E SortedStaticArrayDictionary<K, E>::removeAny()
 	{
-		if (this == &obj) return *this;
+		if (!list.size) throw std::out_of_range("Dictionary is empty");
 
-		if(front) delete front;
-		copyFrom(obj);
-
-		return *this;
+		list.moveToPos(list.size - 1);
+		return list.remove().element;
 	}
 
-	template<typename T>
-	void LinkedQueue<T>::copyFrom(const LinkedQueue& obj)
-	{
-		size = 0;
-		front = rear = new SNode<T>;
+	/// Find the element of a key using binary search. Returns nullptr if the key isn't in the dictionary.
+	template<typename K, typename E>
+	const E* SortedStaticArrayDictionary<K, E>::find(const K& k) const { return findElement(k); }
 
-		for(SNode<T>* node = obj.front->next; node; node = node->next)
-			enqueue(node->element);
-	}
+	/// Return number of pairs.
+	template<typename K, typename E>
+	int SortedStaticArrayDictionary<K, E>::length() const { return (int)list.length(); }
 
-	/// Reinitialize the queue.
-	template<typename T>
-	void LinkedQueue<T>::clear()
+	/// Call visit(key, element) for every pair, in key order.
+	template<typename K, typename E>
+	void SortedStaticArrayDictionary<K, E>::forEach(const std::function<void(const K&, const E&)>& visit) const
 	{
-		if (front->next) delete front->next;
-		
-		front->next = nullptr;
-		rear = front;
-		size = 0;
+		for (const KVpair<K, E>& pair : list)
+			visit(pair.key, pair.element);
 	}
 
-	/// Insert new element at the rear.
-	template<typename T>
-	void LinkedQueue<T>::enqueue(const T& newElement)
+	/// First pair whose key is not less than k (end() if none).
+	template<typename K, typename E>
+	typename SortedStaticArrayDictionary<K, E>::const_iterator SortedStaticArrayDictionary<K, E>::lower_bound(const K& k) const { return list.begin() + list.lower_bound(k); }
+
+	/// First pair whose key is greater than k (end() if none).
+	template<typename K, typename E>
+	typename SortedStaticArrayDictionary<K, E>::const_iterator SortedStaticArrayDictionary<K, E>::upper_bound(const K& k) const { return list.begin() + list.upper_bound(k); }
+
+	/// Pairs with keys in [low, high], as [first, last).
+	template<typename K, typename E>
+	std::pair<typename SortedStaticArrayDictionary<K, E>::const_iterator, typename SortedStaticArrayDictionary<K, E>::const_iterator> SortedStaticArrayDictionary<K, E>::range(const K& low, const K& high) const
 	{
-		rear = rear->next = new SNode<T>(newElement, nullptr);
-		size++;
+		std::pair<size_t, size_t> positions = list.range(low, high);
+		return { list.begin() + positions.first, list.begin() + positions.second };
 	}
 
-	/// Extract element from the front.
-	template<typename T>
-	T LinkedQueue<T>::dequeue()
-	{
-		if (size == 0) throw std::out_of_range("Queue is empty");
-		if (size == 1) rear = front;
+	/// Pointer to the first pair (smallest key).
+	template<typename K, typename E>
+	typename SortedStaticArrayDictionary<K, E>::const_iterator SortedStaticArrayDictionary<K, E>::begin() const { return list.begin(); }
 
-		SNode<T>* node = front->next;
-		T element = node->element;
+	/// Pointer past the last pair.
+	template<typename K, typename E>
+	typename SortedStaticArrayDictionary<K, E>::const_iterator SortedStaticArrayDictionary<K, E>::end() const { return list.end(); }
 
-		front->next = node->next;
-		node->next = nullptr;
-		delete node;
-		size--;
-		return element;
-	}
 
-	/// Get value of front element.
-	template<typename T>
-	const T& LinkedQueue<T>::frontValue() const
+	// -- FrozenDictionary --------------------------------------
+
+	/// Constructor (empty dictionary).
+	template<typename K, typename E>
+	FrozenDictionary<K, E>::FrozenDictionary()
+		: pairs(nullptr), size(0) { }
+
+	/// Constructor. Copy the pairs of any dictionary, sort them, and lay them out in Eytzinger order.
+	template<typename K, typename E>
+	FrozenDictionary<K, E>::FrozenDictionary(const Dictionary<K, E>& dict)
+		: pairs(nullptr), size(0)
 	{
-		if (!size) throw std::out_of_range("Queue is empty");
+		std::vector<KVpair<K,E>> items;
+		dict.forEach([&items](const K& k, const E& e) { items.push_back(KVpair<K,E>(k, e)); });
 
-		return front->next->element;
+		SortedStaticArray<K, E> sorted(items.data(), items.data() + items.size());
+		build(sorted);
 	}
 
-	/// Return length.
-	template<typename T>
-	size_t LinkedQueue<T>::length() const { return size; }
+	/// Constructor. Copy the pairs [first, last), sort them, and lay them out in Eytzinger order. For repeated keys, the last pair wins.
+	template<typename K, typename E>
+	FrozenDictionary<K, E>::FrozenDictionary(const KVpair<K,E>* first, const KVpair<K,E>* last)
+		: pairs(nullptr), size(0)
+	{
+		SortedStaticArray<K, E> sorted(first, last);
+		sorted.removeDuplicateKeys();
+		build(sorted);
+	}
 
+	/// Copy constructor.
+	template<typename K, typename E>
+	FrozenDictionary<K, E>::FrozenDictionary(const FrozenDictionary& obj)
+		: pairs(nullptr), size(0)
+	{
+		copyFrom(obj);
+	}
 
-	// -- KVpair --------------------------------------
+	/// Move constructor. The array of obj is taken, and obj is left empty.
+	template<typename K, typename E>
+	FrozenDictionary<K, E>::FrozenDictionary(FrozenDictionary&& obj) noexcept
+		: pairs(obj.pairs), size(obj.size)
+	{
+		obj.pairs = nullptr;
+		obj.size = 0;
+	}
 
-	/// Default constructor.
+	/// Destructor.
 	template<typename K, typename E>
-	KVpair<K,E>::KVpair() { }
+	FrozenDictionary<K, E>::~FrozenDictionary() { destroyAll(); }
 
-	/// Constructor.
+	/// Copy-assignment operator overloading. If a copy throws, this dictionary is not modified.
 	template<typename K, typename E>
-	KVpair<K,E>::KVpair(K key, E element)
-		: key(key), element(element) { }
+	FrozenDictionary<K, E>& FrozenDictionary<K, E>::operator=(const FrozenDictionary& obj)
+	{
+		if (this == &obj) return *this;
 
-	/// Copy constructor.
-	template<typename K, typename E>
-	KVpair<K,E>::KVpair(const KVpair& obj)
-		: key(obj.key), element(obj.element) { }
-	
-	/// Copy-assignment operator overloading.
+		FrozenDictionary copy(obj);
+		return *this = std::move(copy);
+	}
+
+	/// Move-assignment operator overloading. The array of obj is taken, and obj is left empty.
 	template<typename K, typename E>
-	KVpair<K, E>& KVpair<K,E>::operator=(const KVpair& obj)
+	FrozenDictionary<K, E>& FrozenDictionary<K, E>::operator=(FrozenDictionary&& obj) noexcept
 	{
 		if (this == &obj) return *this;
 
-		key = obj.key;
-		element = obj.element;
+		destroyAll();
+		pairs = obj.pairs;
+		size = obj.size;
+
+		obj.pairs = nullptr;
+		obj.size = 0;
 
 		return *this;
 	}
 
+	/// Get uninitialized memory for "count" pairs, aligned to a cache line (so that the descendants prefetched together share one line).
+	template<typename K, typename E>
+	KVpair<K,E>* FrozenDictionary<K, E>::allocate(size_t count)
+	{
+		return static_cast<KVpair<K,E>*>(::operator new(count * sizeof(KVpair<K,E>), std::align_val_t(std::max(cacheLineSize, alignof(KVpair<K,E>)))));
+	}
 
-	// -- StaticArrayDictionary --------------------------------------
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::deallocate(KVpair<K,E>* storage)
+	{
+		::operator delete(storage, std::align_val_t(std::max(cacheLineSize, alignof(KVpair<K,E>))));
+	}
 
-	/// Constructor.
-	template <typename K, typename E>
-	StaticArrayDictionary<K,E>::StaticArrayDictionary(int size)
-		: list(new StaticArray<KVpair<K,E>>(size)) { }
+	/// Move the sorted pairs into a new array in Eytzinger order. Pairs are constructed in node order, so "size" counts them if a move throws (then the dictionary is left empty).
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::build(SortedStaticArray<K, E>& sorted)
+	{
+		size_t count = sorted.length();
+		if (!count) return;
 
-	/// Copy-constructor.
-	template <typename K, typename E>
-	StaticArrayDictionary<K,E>::StaticArrayDictionary(const StaticArrayDictionary& obj)
-		: list(new StaticArray<KVpair<K, E>>(*obj.list)) { }
+		std::vector<size_t> ranks(count + 1);
+		size = count;
+		assignRanks(ranks, 0, 1);
+		size = 0;
 
-	/// Destructor.
-	template <typename K, typename E>
-	StaticArrayDictionary<K,E>::~StaticArrayDictionary() { delete list; }
+		pairs = allocate(count + 1);
+		try
+		{
+			for (size_t node = 1; node <= count; node++, size++)
+				new (pairs + node) KVpair<K,E>(std::move(sorted.array[ranks[node]]));
+		}
+		catch (...)
+		{
+			destroyAll();
+			throw;
+		}
+	}
 
-	/// Copy-assignment operator overloading.
-	template <typename K, typename E>
-	StaticArrayDictionary<K, E>& StaticArrayDictionary<K, E>::operator=(const StaticArrayDictionary& obj)
+	/// Assign the sorted positions, starting at "rank", to the subtree of "node" (in-order traversal: left subtree, node, right subtree). Returns the next position.
+	template<typename K, typename E>
+	size_t FrozenDictionary<K, E>::assignRanks(std::vector<size_t>& ranks, size_t rank, size_t node) const
 	{
-		if (this == &obj) return *this;
-
-		if(list) delete list;
+		if (node > size) return rank;
 
-		list = new StaticArray<KVpair<K, E>>(*obj.list);
-
-		return *this;
+		rank = assignRanks(ranks, rank, 2 * node);
+		ranks[node] = rank++;
+		return assignRanks(ranks, rank, 2 * node + 1);
 	}
 
-	/// Subscript operator overloading.
-	template <typename K, typename E>
-	E& StaticArrayDictionary<K, E>::operator [](K k) const
+	/// Copy the array of obj (same layout).
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::copyFrom(const FrozenDictionary& obj)
 	{
-		if(!find(k)) throw std::out_of_range("No current element");
+		if (!obj.size) return;
 
-		for (list->moveToStart(); list->currPos() < list->length(); list->next())
+		pairs = allocate(obj.size + 1);
+		try
+		{
+			for (size_t node = 1; node <= obj.size; node++, size++)
+				new (pairs + node) KVpair<K,E>(obj.pairs[node]);
+		}
+		catch (...)
 		{
-			if (k == list->getValue().key)
-				return (*list)[list->currPos()].element;
+			destroyAll();
+			throw;
 		}
 	}
 
-	/// Reinitialize dictionary.
-	template <typename K, typename E>
-	void StaticArrayDictionary<K, E>::clear() { list->clear(); }
+	/// Destroy the pairs and free the array.
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::destroyAll()
+	{
+		if (!pairs) return;
 
-	/// Insert new element. Append it to the list.
-	template <typename K, typename E>
-	void StaticArrayDictionary<K, E>::insert(const K& k, const E& e)
+		for (size_t node = 1; node <= size; node++)
+			pairs[node].~KVpair<K,E>();
+
+		deallocate(pairs);
+		pairs = nullptr;
+		size = 0;
+	}
+
+	/// Walk down the tree: go right if the key is less than k, left otherwise. The loop has no branch that depends on the keys, and the cache line of the descendants log2(prefetchStride) levels below is prefetched. At the end, node has gone past a leaf. Removing the trailing right turns (trailing ones) and the last left turn leads to the last node where we went left: the first key not less than k.
+	template<typename K, typename E>
+	size_t FrozenDictionary<K, E>::lowerBoundNode(const K& k) const
 	{
-		if (find(k))
-			(*this)[k] = e;
-		else
+		size_t node = 1;
+		while (node <= size)
 		{
-			KVpair<K, E> temp(k, e);
-			list->append(temp);
+			if (node * prefetchStride <= size) prefetch(pairs + node * prefetchStride);
+			node = 2 * node + (pairs[node].key < k);
 		}
-	}
 
-	// Find the element to remove using sequential search.
-	template <typename K, typename E>
-	E StaticArrayDictionary<K, E>::remove(const K& k)
-	{
-		const E* ptr = find(k);
-		if (!ptr) throw std::out_of_range("Non-existent element");
-		E temp = *ptr;
-		list->remove();
-		return temp;
+		return node >> (lowestBit64(~node) + 1);
 	}
 
-	/// Remove the last element.
-	template <typename K, typename E>
-	E StaticArrayDictionary<K, E>::removeAny()
+	/// Like lowerBoundNode(), but going right if the key is not greater than k.
+	template<typename K, typename E>
+	size_t FrozenDictionary<K, E>::upperBoundNode(const K& k) const
 	{
-		if(!length()) throw std::out_of_range("Dictionary is empty");
+		size_t node = 1;
+		while (node <= size)
+		{
+			if (node * prefetchStride <= size) prefetch(pairs + node * prefetchStride);
+			node = 2 * node + !(k < pairs[node].key);
+		}
 
-		list->moveToEnd();
-		list->prev();
-		return list->remove().element;
+		return node >> (lowestBit64(~node) + 1);
 	}
 
-	/// Find an element using sequential search.
-	template <typename K, typename E>
-	const E* StaticArrayDictionary<K, E>::find(const K& k) const
+	/// Move to the in-order successor: the leftmost node of the right subtree, or (if there is no right subtree) the first ancestor whose left subtree contains this node.
+	template<typename K, typename E>
+	typename FrozenDictionary<K, E>::const_iterator& FrozenDictionary<K, E>::const_iterator::operator++()
 	{
-		const KVpair<K, E>* temp;
-
-		for (list->moveToStart(); list->currPos() < list->length(); list->next())
+		if (2 * node + 1 <= size)
 		{
-			temp = &list->getValue();
-			if (k == temp->key)
-				return &temp->element;
+			node = 2 * node + 1;
+			while (2 * node <= size) node = 2 * node;
 		}
+		else
+			node >>= lowestBit64(~node) + 1;
 
-		return nullptr;
+		return *this;
 	}
 
-	/// Return list size.
-	template <typename K, typename E>
-	int StaticArrayDictionary<K, E>::length() { return list->length(); }
-
+	/// Subscript operator overloading. Get the element of a key (throws if the key isn't in the dictionary). Elements can be modified (keys can't).
+	template<typename K, typename E>
+	E& FrozenDictionary<K, E>::operator[](K k) const
+	{
+		const E* element = find(k);
+		if (!element) throw std::out_of_range("Non-existent element");
 
-	// -- SortedStaticArray --------------------------------------
+		return const_cast<E&>(*element);
+	}
 
-	template <typename K, typename E>
-	SortedStaticArray<K,E>::SortedStaticArray(size_t capacity)
-		: StaticArray<KVpair<K,E>>(capacity) { }
+	/// Remove all pairs.
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::clear() { destroyAll(); }
 
-	template <typename K, typename E>
-	SortedStaticArray<K,E>::SortedStaticArray(const std::initializer_list<KVpair<K,E>>& il) { };
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::insert(const K&, const E&) { throw std::logic_error("Frozen dictionary is read-only"); }
 
-	template <typename K, typename E>
-	SortedStaticArray<K,E>::SortedStaticArray(const SortedStaticArray& obj) { };
+	template<typename K, typename E>
+	E FrozenDictionary<K, E>::remove(const K&) { throw std::logic_error("Frozen dictionary is read-only"); }
 
-	template <typename K, typename E>
-	SortedStaticArray<K,E>::~SortedStaticArray() { };
+	template<typename K, typename E>
+	E FrozenDictionary<K, E>::removeAny() { throw std::logic_error("Frozen dictionary is read-only"); }
 
-	template <typename K, typename E>
-	SortedStaticArray<K,E>& SortedStaticArray<K,E>::operator=(const SortedStaticArray& obj)
+	/// Find the element of a key. Returns nullptr if the key isn't in the dictionary. The last node compared is already in cache.
+	template<typename K, typename E>
+	const E* FrozenDictionary<K, E>::find(const K& k) const
 	{
-	
-	};
+		size_t node = lowerBoundNode(k);
+		return (node && !(k < pairs[node].key) ? &pairs[node].element : nullptr);
+	}
 
-	template <typename K, typename E>
-	E& SortedStaticArray<K,E>::operator[](size_t i) const
-	{
-	
-	};
+	/// Return number of pairs.
+	template<typename K, typename E>
+	int FrozenDictionary<K, E>::length() const { return (int)size; }
 
-	template <typename K, typename E>
-	void SortedStaticArray<K,E>::insert(KVpair<K,E>& it)
+	/// Call visit(key, element) for every pair, in key order.
+	template<typename K, typename E>
+	void FrozenDictionary<K, E>::forEach(const std::function<void(const K&, const E&)>& visit) const
 	{
-		KVpair<K,E> curr;
-		for (moveToStart(); currPos() < length(); next())
-		{
-			curr = getValue();
-			if (curr.key() > it.key())
-				break;
-		}
-
-		StaticArray<KVpair<K,E>>::insert(it);
+		for (const KVpair<K, E>& pair : *this)
+			visit(pair.key, pair.element);
 	}
 
+	/// First pair whose key is not less than k (end() if none).
+	template<typename K, typename E>
+	typename FrozenDictionary<K, E>::const_iterator FrozenDictionary<K, E>::lower_bound(const K& k) const { return const_iterator(pairs, size, lowerBoundNode(k)); }
 
-	// -- SortedStaticArrayDictionary --------------------------------------
+	/// First pair whose key is greater than k (end() if none).
+	template<typename K, typename E>
+	typename FrozenDictionary<K, E>::const_iterator FrozenDictionary<K, E>::upper_bound(const K& k) const { return const_iterator(pairs, size, upperBoundNode(k)); }
 
-	/// Constructor.
+	/// Pairs with keys in [low, high], as [first, last).
 	template<typename K, typename E>
-	SortedStaticArrayDictionary<K,E>::SortedStaticArrayDictionary(int size)
+	std::pair<typename FrozenDictionary<K, E>::const_iterator, typename FrozenDictionary<K, E>::const_iterator> FrozenDictionary<K, E>::range(const K& low, const K& high) const
 	{
-		list = new SAList<K, E>(size);
+		if (high < low) return { end(), end() };
+
+		return { lower_bound(low), upper_bound(high) };
 	}
 
-	/// Copy constructor.
+	/// Pair with the smallest key (the leftmost node).
 	template<typename K, typename E>
-	SortedStaticArrayDictionary<K, E>::SortedStaticArrayDictionary(const SortedStaticArrayDictionary& obj)
+	typename FrozenDictionary<K, E>::const_iterator FrozenDictionary<K, E>::begin() const
 	{
+		size_t node = (size ? 1 : 0);
+		while (node && 2 * node <= size) node = 2 * node;
 
+		return const_iterator(pairs, size, node);
 	}
 
-	/// Destructor
+	/// Past the pair with the largest key.
 	template<typename K, typename E>
-	SortedStaticArrayDictionary<K, E>::~SortedStaticArrayDictionary() { delete list; }
+	typename FrozenDictionary<K, E>::const_iterator FrozenDictionary<K, E>::end() const { return const_iterator(pairs, size, 0); }
 
-	/// Copy-assignment operator overloading.
-	template<typename K, typename E>
-	SortedStaticArrayDictionary<K, E>& SortedStaticArrayDictionary<K, E>::operator=(const SortedStaticArrayDictionary& obj)
+
+	// -- RWLockedDictionary --------------------------------------
+
+	/// Constructor. The arguments are forwarded to the constructor of the dictionary.
+	template <typename K, typename E, typename D>
+	template <typename... Args>
+	RWLockedDictionary<K, E, D>::RWLockedDictionary(Args&&... args)
+		: dict(std::forward<Args>(args)...) { }
+
+	/// Copy the element of a key. Returns false if the key isn't in the dictionary.
+	template <typename K, typename E, typename D>
+	bool RWLockedDictionary<K, E, D>::get(const K& k, E& e) const
 	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
 
+		const E* found = dict.find(k);
+		if (!found) return false;
+
+		e = *found;
+		return true;
 	}
 
-	/// Subscript operator overloading.
-	template<typename K, typename E>
-	E& SortedStaticArrayDictionary<K, E>::operator[](size_t i) const
+	template <typename K, typename E, typename D>
+	bool RWLockedDictionary<K, E, D>::contains(const K& k) const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return dict.find(k) != nullptr;
+	}
+
+	/// Call visit(element) with the element of a key, while holding the shared lock (visit mustn't keep a reference to it). Returns false if the key isn't in the dictionary.
+	template <typename K, typename E, typename D>
+	template <typename F>
+	bool RWLockedDictionary<K, E, D>::read(const K& k, F&& visit) const
 	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
 
+		const E* found = dict.find(k);
+		if (!found) return false;
+
+		visit(*found);
+		return true;
 	}
 
-	/// Reinitialization.
-	template<typename K, typename E>
-	void SortedStaticArrayDictionary<K, E>::clear() { list->clear(); }
+	template <typename K, typename E, typename D>
+	int RWLockedDictionary<K, E, D>::length() const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return dict.length();
+	}
 
-	/// Insert an element while keeping elements sorted.
-	template<typename K, typename E>
-	void SortedStaticArrayDictionary<K, E>::insert(const K& k, const E& e)
+	template <typename K, typename E, typename D>
+	void RWLockedDictionary<K, E, D>::clear()
 	{
-		KVpair<K, E> temp(k, e);
-		list->insert(temp);
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		dict.clear();
 	}
 
-	/// Find element to remove using binary search, remove it, and shift subsequent elements.
-	template<typename K, typename E>
-	E SortedStaticArrayDictionary<K, E>::remove(const K& k)
+	template <typename K, typename E, typename D>
+	void RWLockedDictionary<K, E, D>::insert(const K& k, const E& e)
 	{
-		E temp = find(k);
-		if (temp != NULL) list->remove();//<<< uses sequential search
-		return temp;
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		dict.insert(k, e);
 	}
 
-	/// Remove last element.
-	template<typename K, typename E>
-	E SortedStaticArrayDictionary<K, E>::removeAny()
+	template <typename K, typename E, typename D>
+	E RWLockedDictionary<K, E, D>::remove(const K& k)
 	{
-		Assert(size() != 0, "Dictionary is empty");
-		list->moveToEnd();
-		list->prev();
-		KVpair<K, E> e = list->remove();
-		return e.value();
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		return dict.remove(k);
 	}
 
-	// Find key using binary search.
-	template<typename K, typename E>
-	E SortedStaticArrayDictionary<K, E>::find(const K& k) const {
-		int l = -1;
-		int r = list->length();
-		while (l + 1 != r)
-		{ // Stop when l and r meet
-			int i = (l + r) / 2; // Check middle of remaining subarray
-			list->moveToPos(i);
-			KVpair<Key, E> temp = list->getValue();
-			if (k < temp.key()) r = i;
-			// In left
-			if (k == temp.key()) return temp.value(); // Found it
-			if (k > temp.key()) l = i;
-			// In right
-		}
-		return NULL; // "k" does not appear in dictionary
+	template <typename K, typename E, typename D>
+	E RWLockedDictionary<K, E, D>::removeAny()
+	{
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		return dict.removeAny();
 	}
 
-	/// Return list size.
-	template<typename K, typename E>
-	int SortedStaticArrayDictionary<K, E>::size() { return list->length(); }
+	/// Call f(dict) with read-only access, while holding the shared lock. Returns what f returns.
+	template <typename K, typename E, typename D>
+	template <typename F>
+	auto RWLockedDictionary<K, E, D>::withReadLock(F&& f) const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return f(static_cast<const D&>(dict));
+	}
+
+	/// Call f(dict) with full access, while holding the exclusive lock. Returns what f returns.
+	template <typename K, typename E, typename D>
+	template <typename F>
+	auto RWLockedDictionary<K, E, D>::withWriteLock(F&& f)
+	{
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		return f(dict);
+	}
 
 
 	// -- Tests --------------------------------------
@@ -2510,6 +9334,8 @@ namespace dss   // Data Structures namespace
 		if (list2.getValue() != 2) throw std::exception("Failed at getValue()");
 		if (list2[7] != 7) throw std::exception("Failed at operator[]");
 		if (dss::find(&list2, 5) != 5) throw std::exception("Failed at find()");
+		if (dss::find(list2, 5) != 5 || dss::find(list2, 42) != 9) throw std::exception("Failed at find()");
+		if (dss::find(static_cast<List<int>&>(list2), 7) != 7) throw std::exception("Failed at find()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 3
 		T<int> list3({ 0,1,2,3,4,5,6,7,8,9 });
@@ -2575,142 +9401,398 @@ namespace dss   // Data Structures namespace
 		if (list2[7] != 7) throw std::exception("Failed at operator[]");
 		if (dss::find(&list7, 5) != 5) throw std::exception("Failed at find()");
 
+		std::cout << ++testNumber << " " << std::flush;   // 9
+		const int items[] = { 10, 11, 12, 13 };
+		T<int> list9(20);
+		list9.assign(items, items + 4);   // 10 11 12 13
+		list9.moveToPos(2);
+		list9.insertRange(items, items + 3);   // 10 11 10 11 12 12 13
+		list9.appendRange(items + 2, items + 4);   // 10 11 10 11 12 12 13 12 13
+		if (list9.length() != 9) throw std::exception("Failed at insertRange()");
+		if (list9.currPos() != 2 || list9.getValue() != 10) throw std::exception("Failed at insertRange()");
+		if (list9[4] != 12 || list9[5] != 12 || list9[8] != 13) throw std::exception("Failed at insertRange()");
+		list9.removeRange(1, 4);   // 10 12 13 12 13
+		if (list9.length() != 5) throw std::exception("Failed at removeRange()");
+		if (list9.currPos() != 1 || list9.getValue() != 12) throw std::exception("Failed at removeRange()");
+		if (list9[0] != 10 || list9[2] != 13 || list9[4] != 13) throw std::exception("Failed at removeRange()");
+		list9.removeRange(0, 5);
+		if (list9.length() != 0) throw std::exception("Failed at removeRange()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 10
+		T<int> list10(20);
+		list10.assign(items, items + 4);   // 10 11 12 13
+		list10.moveToPos(1);
+		T<int> list11(std::move(list10));
+		if (list11.length() != 4 || list10.length() != 0) throw std::exception("Failed at move constructor");
+		if (list11.currPos() != 1 || list11.getValue() != 11 || list11[3] != 13) throw std::exception("Failed at move constructor");
+		if (!std::is_nothrow_move_constructible<T<int>>::value) throw std::exception("Failed at move constructor (noexcept)");
+		bool thrown = false;
+		try { list10.getValue(); }
+		catch (const std::out_of_range&) { thrown = true; }
+		list10.moveToEnd();
+		list10.moveToPos(0);
+		list10.clear();
+		if (!thrown || list10.length() != 0 || list10.currPos() != 0) throw std::exception("Failed at move constructor (moved-from list)");
+		list10 = list11;   // The moved-from list can be used again
+		if (list10.length() != 4 || list10.currPos() != 1 || list10[3] != 13) throw std::exception("Failed at move constructor (moved-from list)");
+		list10 = std::move(list11);
+		if (list10.length() != 4 || list10.currPos() != 1 || list10[0] != 10) throw std::exception("Failed at move assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 11
+		T<std::string> list12(4);
+		std::string str(100, 'x');
+		const char* buffer = str.data();
+		list12.insert(std::move(str));
+		list12.append(std::string(50, 'y'));
+		std::string removed = list12.remove();
+		if (removed.data() != buffer || list12.length() != 1 || list12.getValue() != std::string(50, 'y')) throw std::exception("Failed at insert(T&&)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 12
+		const int unsorted[] = { 5, 3, 9, 1, 5, 0, 7, 2, 8, 3, 6, 4 };
+		T<int> list13(20);
+		list13.assign(unsorted, unsorted + 12);
+		list13.moveToPos(4);
+		list13.sort();   // 0 1 2 3 3 4 5 5 6 7 8 9
+		if (list13.length() != 12 || list13.currPos() != 0) throw std::exception("Failed at sort()");
+		for (size_t i = 1; i < 12; i++)
+			if (list13[i - 1] > list13[i]) throw std::exception("Failed at sort()");
+		dss::sort(list13, std::greater<int>());   // 9 8 7 6 5 5 4 3 3 2 1 0
+		if (list13[0] != 9 || list13[5] != 5 || list13[11] != 0) throw std::exception("Failed at sort()");
+		List<int>& base13 = list13;
+		dss::sort(base13, [](const int& a, const int& b) { return a < b; });   // Through the List interface
+		list13.append(-1);
+		list13.moveToEnd();
+		list13.prev();
+		if (list13.getValue() != -1 || list13[0] != 0 || list13[11] != 9) throw std::exception("Failed at sort()");
+
 		std::cout << std::endl;
 	}
 
-	/// Tests for sorted lists.
-	template<template<typename, typename> class T>
-	void test_SortedList()
+	/// Element whose copy constructor throws if the source is marked (throwOnCopy), for exception-safety tests. It owns heap memory (std::string), so a lost or doubly destroyed element is visible to leak checkers.
+	struct ThrowingCopy
 	{
-		// <<< std::pair
-		/*
-		SortedStaticArray(size_t capacity = 1);
-		SortedStaticArray(const std::initializer_list<KVpair<K, E>>&il);
-		SortedStaticArray(const SortedStaticArray & obj);
-		~SortedStaticArray() override;
+		std::string value;
+		bool throwOnCopy;
 
-		SortedStaticArray& operator=(const SortedStaticArray & obj);
-		E& operator[](size_t i) const override;
+		ThrowingCopy(const std::string& value = "", bool throwOnCopy = false) : value(value), throwOnCopy(throwOnCopy) { }
+		ThrowingCopy(const ThrowingCopy& obj) : value(obj.value), throwOnCopy(obj.throwOnCopy) { if (throwOnCopy) throw std::runtime_error("Copy failed"); }
+		ThrowingCopy(ThrowingCopy&& obj) noexcept = default;
+		ThrowingCopy& operator=(const ThrowingCopy& obj) { value = obj.value; throwOnCopy = obj.throwOnCopy; return *this; }
+		ThrowingCopy& operator=(ThrowingCopy&& obj) noexcept = default;
+		bool operator==(const ThrowingCopy& obj) const { return value == obj.value; }
+		bool operator<(const ThrowingCopy& obj) const { return value < obj.value; }
+	};
+
+	/// ThrowingCopy whose move constructor isn't noexcept (though it doesn't throw), so operations with the strong guarantee must copy it.
+	struct ThrowingMove : ThrowingCopy
+	{
+		using ThrowingCopy::ThrowingCopy;
+		ThrowingMove(const ThrowingMove& obj) = default;
+		ThrowingMove(ThrowingMove&& obj) : ThrowingCopy(std::move(obj)) { }
+		ThrowingMove& operator=(const ThrowingMove& obj) = default;
+		ThrowingMove& operator=(ThrowingMove&& obj) = default;
+	};
+
+	/// Tests for dynamic arrays (storage management and non-trivial element types).
+	template<template<typename> class T>
+	void test_DynamicArray()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<std::string> list1;
+		list1.reserve(10);
+		list1.append("b");
+		list1.emplace_back(3, 'c');
+		list1.moveToStart();
+		list1.insert(std::string("a"));
+		list1.insert(list1[2]);
+		if (list1.length() != 4) throw std::exception("Failed at length()");
+		if (list1[0] != "ccc" || list1[1] != "a" || list1[3] != "ccc") throw std::exception("Failed at insert()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		T<std::string> list2;
+		for (size_t i = 0; i < 100; i++)
+			list2.emplace_back(std::to_string(i));
+		for (list2.moveToPos(10); list2.length() > 10; )
+			list2.remove();
+		list2.shrink_to_fit();
+		if (list2.length() != 10) throw std::exception("Failed at length()");
+		if (list2[9] != "9") throw std::exception("Failed at remove()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<std::string> list3(list2);
+		list3.clear();
+		list3.append("x");
+		list2 = list3;
+		if (list2.length() != 1 || list2[0] != "x") throw std::exception("Failed at operator=");
 
-		void insert(KVpair<K, E>&it);   // Redefined
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<int> list4;
+		for (int i = 0; i < 1000; i++)
+			list4.append(i);
+		if (list4.reallocations() == 0 || list4.bytesCopied() == 0) throw std::exception("Failed at reallocations()");
+		list4.resetCounters();
+		for (int i = 0; i < 100; i++)   // Oscillate around a capacity boundary
+		{
+			list4.moveToEnd();
+			list4.prev();
+			list4.remove();
+			list4.append(i);
+		}
+		if (list4.reallocations() != 0) throw std::exception("Failed at remove()");
+		list4.setShrinkThreshold(-1);
+		for (list4.moveToStart(); list4.length() > 0; )
+			list4.remove();
+		if (list4.reallocations() != 0 || list4.getCapacity() < 1000) throw std::exception("Failed at setShrinkThreshold()");
+		T<int> list4b;
+		list4b.reserve(1000);
+		for (int round = 0; round < 3; round++)   // Fill and drain: the reserved capacity is kept
+		{
+			for (int i = 0; i < 10; i++)
+				list4b.append(i);
+			list4b.remove();
+			list4b.removeRange(0, list4b.length());
+		}
+		list4b.clear();
+		if (list4b.getCapacity() != 1000 || list4b.reallocations() != 1) throw std::exception("Failed at reserve()");
+		list4b.append(1);
+		list4b.shrink_to_fit();
+		list4b.remove();
+		if (list4b.getCapacity() > T<int>::inlineCapacity + 1) throw std::exception("Failed at shrink_to_fit()");
 
-		StaticArray<KVpair<K, E>>::clear;
-		//StaticArray<KVpair<K,E>>::insert;   // Made inaccessible
-		//StaticArray<KVpair<K,E>>::append;   // Made inaccessible
-		StaticArray<KVpair<K, E>>::remove;
+		std::cout << ++testNumber << " " << std::flush;   // 5
+		T<int> list5 = { 3, 1, 2 };
+		std::sort(list5.begin(), list5.end());
+		std::transform(list5.begin(), list5.end(), list5.begin(), [](int x) { return x * 10; });
+		int sum = 0;
+		for (int x : list5) sum += x;
+		const T<int>& clist5 = list5;
+		if (sum != 60 || clist5.end() - clist5.begin() != 3 || list5.data() != &list5[0]) throw std::exception("Failed at begin()/end()");
+		if (list5[0] != 10 || list5[2] != 30) throw std::exception("Failed at std::sort()");
 
-		StaticArray<KVpair<K, E>>::length;
-		StaticArray<KVpair<K, E>>::currPos;
-		StaticArray<KVpair<K, E>>::getValue;
+		std::cout << ++testNumber << " " << std::flush;   // 6
+		const size_t inlineCapacity = T<std::string>::inlineCapacity;
+		T<std::string> list6;
+		for (size_t i = 0; i < inlineCapacity; i++)
+			list6.append(std::to_string(i));
+		T<std::string> list7(list6);
+		list7.clear();
+		list7 = list6;
+		if (list6.reallocations() != 0 || list7.reallocations() != 0 || list6.getCapacity() != inlineCapacity) throw std::exception("Failed at inline storage");
+		list6.append("x");   // Goes to the heap
+		list6.moveToStart();
+		list6.remove();
+		list6.shrink_to_fit();   // Back to the inline buffer
+		if (list6.length() != inlineCapacity || (inlineCapacity && !std::equal(list6.begin(), list6.end() - 1, list7.begin() + 1))) throw std::exception("Failed at shrink_to_fit()");
+		if (list6.getCapacity() != inlineCapacity) throw std::exception("Failed at shrink_to_fit()");
 
-		StaticArray<KVpair<K, E>>::moveToStart;
-		StaticArray<KVpair<K, E>>::moveToEnd;
-		StaticArray<KVpair<K, E>>::moveToPos;
-		StaticArray<KVpair<K, E>>::prev;
-		StaticArray<KVpair<K, E>>::next;
-		*/
+		std::cout << ++testNumber << " " << std::flush;   // 7
+		T<int> list8;
+		uint32_t seed = 1;
+		for (int i = 0; i < 100000; i++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			list8.append(int(seed >> 8) % 1000);
+		}
+		list8.parallelSort(std::less<int>(), 4);
+		if (list8.length() != 100000 || !std::is_sorted(list8.begin(), list8.end())) throw std::exception("Failed at parallelSort()");
+		T<std::string> list9;
+		for (int i = 0; i < 1000; i++)
+			list9.append(std::to_string(i * 7919 % 1000));
+		list9.parallelSort();
+		if (list9.length() != 1000 || !std::is_sorted(list9.begin(), list9.end()) || list9[0] != "0") throw std::exception("Failed at parallelSort()");
 
+		std::cout << ++testNumber << " " << std::flush;   // 8
+		T<int> list10;
+		for (int i = 0; i < 100; i++)
+			list10.append(i % 50);
+		List<int>* ptr10 = &list10;
+		if (find(ptr10, 0) != 0 || find(ptr10, 17) != 17 || find(ptr10, 49) != 49) throw std::exception("Failed at find()");
+		if (find(ptr10, 50) != 100 || list10.currPos() != 100) throw std::exception("Failed at find()");
+		T<double> list11;
+		for (int i = 0; i < 37; i++)
+			list11.append(i * 0.5);
+		if (find(list11, 18.0) != 36 || find(list11, -0.0) != 0 || find(list11, 0.25) != 37) throw std::exception("Failed at find()");
+		T<int64_t> list12;
+		for (int64_t i = 0; i < 20; i++)
+			list12.append(i << 32);   // The lower halves are all 0
+		if (find(list12, int64_t(5) << 32) != 5 || find(list12, int64_t(5)) != 20) throw std::exception("Failed at find()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 9
+		T<ThrowingCopy> list13;
+		list13.reserve(20);
+		for (int i = 0; i < 5; i++)
+			list13.append(ThrowingCopy(std::to_string(i)));
+		ThrowingCopy items[] = { ThrowingCopy("a"), ThrowingCopy("b"), ThrowingCopy("c", true) };
+		for (size_t count : { 3, 12 })   // Room in the array (the tail is shifted first), or not (reallocation)
+		{
+			if (count == 12) list13.shrink_to_fit();
+			std::vector<ThrowingCopy> range(count, ThrowingCopy("x"));
+			range[count - 1] = items[2];
+			bool thrown = false;
+			list13.moveToPos(1);
+			try { list13.insertRange(range.data(), range.data() + count); }
+			catch (const std::runtime_error&) { thrown = true; }
+			if (!thrown || list13.length() != 5) throw std::exception("Failed at insertRange() (throwing copy)");
+			for (int i = 0; i < 5; i++)
+				if (list13[i].value != std::to_string(i)) throw std::exception("Failed at insertRange() (throwing copy)");
+		}
+		list13.moveToPos(2);
+		list13.insertRange(items, items + 2);
+		if (list13.length() != 7 || list13[2].value != "a" || list13[4].value != "2") throw std::exception("Failed at insertRange()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 10
+		T<std::string> list14 = { "a", "b" }, list15 = { "c" };   // Assignments through the StaticArray base mustn't free an inline buffer
+		StaticArray<std::string> list16 = { "d", "e", "f" };
+		StaticArray<std::string>& base14 = list14;
+		StaticArray<std::string>& base15 = list15;
+		base14 = list16;
+		if (list14.length() != 3 || list14[2] != "f") throw std::exception("Failed at operator= (StaticArray)");
+		list16 = std::move(base15);
+		if (list16.length() != 1 || list16[0] != "c" || list15.length() != 0) throw std::exception("Failed at operator= (StaticArray, move)");
+		base14 = std::move(list16);
+		list15.append("g");
+		StaticArray<std::string> list17(std::move(base15));
+		if (list14.length() != 1 || list14[0] != "c" || list17[0] != "g" || list15.length() != 0) throw std::exception("Failed at move constructor (StaticArray)");
 
+		std::cout << std::endl;
+	}
 
+	/// Tests for linked lists (positional index).
+	template<template<typename> class T>
+	void test_LinkedList()
+	{
 		size_t testNumber = 0;
 		std::cout << typeid(T).name() << ": " << std::flush;
 
 		std::cout << ++testNumber << " " << std::flush;   // 1
-		T<int> list1(0);
-		list1.clear();
-		list1.moveToEnd();
-		if (list1.length() != 0) throw std::exception("Failed at length()");
-		if (list1.currPos() != 0) throw std::exception("Failed at currPos()");
+		T<int> list1;
+		for (int i = 0; i < 100; i++)
+			list1.append(i);
+		list1.enableIndex(true);
+		if (!list1.indexed()) throw std::exception("Failed at enableIndex()");
+		for (size_t i = 0; i < 100; i += 7)
+			if (list1[i] != (int)i) throw std::exception("Failed at operator[]");
+		list1.moveToPos(60);
+		list1.moveToPos(40);
+		if (list1.currPos() != 40 || list1.getValue() != 40) throw std::exception("Failed at moveToPos()");
+		list1.prev();
+		if (list1.currPos() != 39 || list1.getValue() != 39) throw std::exception("Failed at prev()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 2
-		T<int> list2(10);
-		list2.append(0);
-		list2.append(1);
-		list2.append(3);
-		list2.append(4);
-		list2.moveToEnd();
-		list2.prev();
-		list2.prev();
-		list2.insert(2);
-		list2.insert(3);
-		list2.append(5);
-		list2.append(6);
-		list2.append(8);
-		list2.moveToPos(8);
-		list2.insert(7);
-		list2.moveToStart();
-		list2.next();
-		list2.next();
-		list2.remove();
-		if (list2.length() != 9) throw std::exception("Failed at length()");
-		if (list2.currPos() != 2) throw std::exception("Failed at currPos()");
-		if (list2.getValue() != 2) throw std::exception("Failed at getValue()");
-		if (list2[7] != 7) throw std::exception("Failed at operator[]");
-		if (dss::find(&list2, 5) != 5) throw std::exception("Failed at find()");
+		list1.moveToPos(50);
+		list1.insert(-1);
+		list1.moveToStart();
+		list1.insert(-2);
+		list1.append(-3);
+		list1.moveToPos(11);
+		list1.remove();
+		if (list1.length() != 102) throw std::exception("Failed at length()");
+		if (list1[0] != -2 || list1[10] != 9 || list1[11] != 11 || list1[50] != -1 || list1[101] != -3) throw std::exception("Failed at insert()/remove()");
+		list1.moveToEnd();
+		list1.prev();
+		if (list1.getValue() != -3) throw std::exception("Failed at moveToEnd()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 3
-		T<int> list3({ 0,1,2,3,4,5,6,7,8,9 });
-		list3.moveToPos(3);
-		if (list3.length() != 10) throw std::exception("Failed at length()");
-		if (list3.currPos() != 3) throw std::exception("Failed at currPos()");
-		if (list3.getValue() != 3) throw std::exception("Failed at getValue()");
-		if (list3[6] != 6) throw std::exception("Failed at operator[]");
-		if (dss::find(&list3, 9) != 9) throw std::exception("Failed at find()");
-		list3.moveToPos(3);
+		T<int> list2(list1);
+		if (!list2.indexed() || list2.length() != 102 || list2[50] != -1) throw std::exception("Failed at copy constructor");
+		list2.removeRange(10, 80);
+		if (list2.length() != 22 || list2[9] != 8 || list2[10] != 89) throw std::exception("Failed at removeRange()");
+		list2.clear();
+		list2.append(5);
+		if (list2[0] != 5) throw std::exception("Failed at clear()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 4
-		T<int> list4(list3);
-		if (list4.length() != 10) throw std::exception("Failed at length()");
-		if (list4.currPos() != 3) throw std::exception("Failed at currPos()");
-		if (list4.getValue() != 3) throw std::exception("Failed at getValue()");
-		if (list4[6] != 6) throw std::exception("Failed at operator[]");
-		if (dss::find(&list4, 9) != 9) throw std::exception("Failed at find()");
-		list4.moveToPos(3);
+		list1.enableIndex(false);
+		if (list1.indexed() || list1[50] != -1 || list1[101] != -3) throw std::exception("Failed at enableIndex(false)");
 
 		std::cout << ++testNumber << " " << std::flush;   // 5
-		T<int> list5 = list4;
-		if (list5.length() != 10) throw std::exception("Failed at length()");
-		if (list5.currPos() != 3) throw std::exception("Failed at currPos()");
-		if (list5.getValue() != 3) throw std::exception("Failed at getValue()");
-		if (list5[6] != 6) throw std::exception("Failed at operator[]");
-		if (dss::find(&list5, 9) != 9) throw std::exception("Failed at find()");
+		list1.enableIndex(true);
+		list1.moveToPos(50);
+		T<int> list3(std::move(list1));
+		if (!list3.indexed() || list3.currPos() != 50 || list3.getValue() != -1 || list3[101] != -3) throw std::exception("Failed at move constructor");
+		if (list1.indexed() || list1.length() != 0) throw std::exception("Failed at move constructor");
+		list1.append(7);
+		list2 = std::move(list3);
+		list2.emplace(8);
+		if (list2.length() != 103 || list2[50] != 8 || list2[51] != -1 || list1[0] != 7) throw std::exception("Failed at move assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 6
+		T<int> list4, list5;
+		for (int i = 0; i < 10; i++)
+			(i % 2 ? list5 : list4).append(i);   // 0 2 4 6 8 | 1 3 5 7 9
+		list4.mergeSorted(list5);   // 0 1 2 3 4 5 6 7 8 9
+		if (list4.length() != 10 || list5.length() != 0 || list4[3] != 3 || list4[9] != 9) throw std::exception("Failed at mergeSorted()");
+		T<int> list6 = list4.splitAt(4);   // 0 1 2 3 | 4 5 6 7 8 9
+		if (list4.length() != 4 || list4.currPos() != 4 || list4[3] != 3) throw std::exception("Failed at splitAt()");
+		if (list6.length() != 6 || list6.getValue() != 4 || list6[5] != 9) throw std::exception("Failed at splitAt()");
+		list6.spliceAt(2, list4);   // 4 5 0 1 2 3 6 7 8 9
+		if (list6.length() != 10 || list4.length() != 0 || list6.currPos() != 2 || list6.getValue() != 0) throw std::exception("Failed at spliceAt()");
+		if (list6[1] != 5 || list6[5] != 3 || list6[6] != 6 || list6[9] != 9) throw std::exception("Failed at spliceAt()");
+		list4.append(1);
+		list6.removeRange(0, 10);
+		if (list4[0] != 1 || list6.length() != 0) throw std::exception("Failed at spliceAt()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 7
+		T<int> list7;
+		for (int i = 0; i < 100; i++)
+			list7.append(i);
+		for (int round = 0; round < 100; round++)   // Rotate by 50 each round (the shared memory must not grow)
+		{
+			T<int> rest = list7.splitAt(50);
+			list7.spliceAt(0, rest);
+		}
+		if (list7.length() != 100 || list7[0] != 0 || list7[49] != 49 || list7[50] != 50 || list7[99] != 99) throw std::exception("Failed at splitAt() + spliceAt()");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for sorted lists of key-value pairs.
+	template<template<typename, typename> class T>
+	void test_SortedList()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
 
-		std::cout << ++testNumber << " " << std::flush;   // 6
-		T<int> list6 = list5;
-		list6.clear();
-		if (list6.length() != 0) throw std::exception("Failed at length()");
-		if (list6.currPos() != 0) throw std::exception("Failed at currPos()");
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int, std::string> list1(10);
+		list1.clear();
+		if (list1.length() != 0 || list1.lower_bound(5) != 0 || list1.find(5) != 0) throw std::exception("Failed at length()");
+		const int keys[] = { 5, 2, 8, 2, 9, 1 };
+		for (int i = 0; i < 6; i++)
+			list1.insert(KVpair<int, std::string>(keys[i], std::to_string(i)));
+		list1.insert(KVpair<int, std::string>(5, "new"));   // After the other 5
+		if (list1.length() != 7 || list1.at(0).key != 1 || list1.at(1).element != "1" || list1.at(2).element != "3" || list1.at(4).element != "new" || list1.at(6).key != 9) throw std::exception("Failed at insert()");
+		if (list1.getValue().element != "new" || list1.currPos() != 4) throw std::exception("Failed at getValue()");
 
-		std::cout << ++testNumber << " " << std::flush;   // 7
-		T<int> list7(15);
-		list7.clear();
-		list7.moveToEnd();
-		list7.append(0);
-		list7.append(1);
-		list7.append(2);
-		list7.append(3);
-		list7.append(4);
-		list7.append(5);
-		list7.append(6);
-		list7.append(7);
-		list7.append(8);
-		list7.append(9);
-		list7.append(10);
-		if (list7.length() != 11) throw std::exception("Failed at length()");
-		if (list7.currPos() != 0) throw std::exception("Failed at currPos()");
-		if (list7.getValue() != 0) throw std::exception("Failed at getValue()");
-		if (list7[7] != 7) throw std::exception("Failed at operator[]");
-		if (dss::find(&list7, 5) != 5) throw std::exception("Failed at find()");
-		list7.moveToPos(0);
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		if (list1.lower_bound(2) != 1 || list1.upper_bound(2) != 3 || list1.lower_bound(0) != 0 || list1.upper_bound(9) != 7 || list1.lower_bound(6) != 5) throw std::exception("Failed at lower_bound()/upper_bound()");
+		if (list1.find(8) != 5 || list1.find(3) != 7 || list1.find(10) != 7) throw std::exception("Failed at find()");
+		if (list1.range(2, 5) != std::make_pair<size_t, size_t>(1, 5) || list1.range(6, 7).first != list1.range(6, 7).second) throw std::exception("Failed at range()");
 
-		std::cout << ++testNumber << " " << std::flush;   // 8
-		list2 = list7;
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<int, std::string> list3({ { 3, "c" }, { 1, "a" }, { 2, "b" } });
+		const KVpair<int, std::string> batch[] = { { 10, "x" }, { 0, "y" }, { 2, "z" }, { 2, "w" } };
+		T<int, std::string> list4(batch, batch + 4, 10);
+		if (list3.at(0).element != "a" || list3.at(2).element != "c" || list4.at(0).key != 0 || list4.at(1).element != "z" || list4.at(3).key != 10) throw std::exception("Failed at constructor (bulk load)");
+		list4.insertRange(list3.begin(), list3.end());
+		if (list4.length() != 7 || list4.at(1).key != 1 || list4.at(4).element != "b" || list4.at(5).key != 3) throw std::exception("Failed at insertRange()");
+		if (list4.removeDuplicateKeys() != 2 || list4.length() != 5 || list4.at(2).element != "b") throw std::exception("Failed at removeDuplicateKeys()");
+		bool thrown = false;
+		try { list3.insertRange(batch, batch + 1); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (!thrown || list3.length() != 3) throw std::exception("Failed at insertRange() (full)");
 
-		if (list2.length() != 11) throw std::exception("Failed at length()");
-		if (list2.currPos() != 0) throw std::exception("Failed at currPos()");
-		if (list2.getValue() != 0) throw std::exception("Failed at getValue()");
-		if (list2[7] != 7) throw std::exception("Failed at operator[]");
-		if (dss::find(&list7, 5) != 5) throw std::exception("Failed at find()");
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<int, std::string> list5(list4);
+		T<int, std::string> list6(1);
+		list6 = list4;
+		list5.moveToPos(1);
+		if (list5.remove().key != 1 || list5.length() != 4 || list6.length() != 5) throw std::exception("Failed at copy");
+		T<int, std::string> list7(std::move(list6));
+		if (list7.length() != 5 || list6.length() != 0 || list7.at(4).key != 10) throw std::exception("Failed at move constructor");
 
 		std::cout << std::endl;
 	}
@@ -2776,6 +9858,182 @@ namespace dss   // Data Structures namespace
 		if (stack4.length() != 4) throw std::exception("Failed at length()");
 		if (stack4.topValue() != 6) throw std::exception("Failed at topValue()");
 
+		std::cout << ++testNumber << " " << std::flush;   // 9
+		T<int> stack8(std::move(stack5));
+		if (stack8.length() != 4 || stack5.length() != 0) throw std::exception("Failed at move constructor");
+		stack5 = std::move(stack8);
+		if (stack5.length() != 4 || stack5.topValue() != 6) throw std::exception("Failed at move assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 10
+		T<std::string> stack9(2);
+		std::string str(100, 'x');
+		const char* buffer = str.data();
+		stack9.push(std::move(str));
+		stack9.emplace(50, 'y');
+		if (stack9.pop() != std::string(50, 'y') || stack9.pop().data() != buffer) throw std::exception("Failed at push(T&&)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for dynamic-array stacks (growth, batch operations and shrink policy).
+	template<template<typename> class T>
+	void test_DArrayStack()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> stack1;
+		for (int i = 0; i < 1000; i++)
+			stack1.push(i);
+		if (stack1.length() != 1000 || stack1.topValue() != 999 || stack1.getCapacity() < 1000) throw std::exception("Failed at push()");
+		for (int i = 999; i >= 0; i--)
+			if (stack1.pop() != i) throw std::exception("Failed at pop()");
+		if (stack1.getCapacity() > 16) throw std::exception("Failed at pop()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		const int items[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[10] = { };
+		T<int> stack2;
+		stack2.pushN(items, 10);
+		if (stack2.length() != 10 || stack2.topValue() != 9) throw std::exception("Failed at pushN()");
+		if (stack2.popN(out, 3) != 3 || out[0] != 9 || out[2] != 7 || stack2.topValue() != 6) throw std::exception("Failed at popN()");
+		if (stack2.popN(out, 20) != 7 || out[0] != 6 || out[6] != 0 || stack2.length() != 0) throw std::exception("Failed at popN()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<int> stack3(100);
+		stack3.setShrinkThreshold(-1);
+		stack3.push(1);
+		stack3.pop();
+		if (stack3.getCapacity() != 100) throw std::exception("Failed at setShrinkThreshold()");
+		stack3.push(2);
+		stack3.shrink_to_fit();
+		if (stack3.getCapacity() != 1 || stack3.topValue() != 2) throw std::exception("Failed at shrink_to_fit()");
+		T<int> stack3b, stack3c(1024);
+		stack3b.reserve(1000);
+		for (int round = 0; round < 3; round++)   // Fill and drain: the reserved capacity is kept
+		{
+			stack3b.pushN(items, 10);
+			stack3b.pop();
+			stack3b.popN(out, 10);
+			stack3c.push(round);
+			stack3c.pop();
+		}
+		if (stack3b.getCapacity() != 1000 || stack3c.getCapacity() != 1024) throw std::exception("Failed at reserve()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<std::string> stack4;
+		stack4.push(std::string(40, 'a'));
+		stack4.push(stack4.topValue());   // The argument lives in the array being reallocated
+		if (stack4.length() != 2 || stack4.pop() != std::string(40, 'a') || stack4.pop() != std::string(40, 'a')) throw std::exception("Failed at push()");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for linked stacks (node freelist, reserve() and shrink()).
+	template<template<typename> class T>
+	void test_LinkedStack()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> stack1;
+		stack1.reserve(100);
+		if (stack1.freeNodes() != 100) throw std::exception("Failed at reserve()");
+		for (int i = 0; i < 100; i++)
+			stack1.push(i);
+		if (stack1.freeNodes() != 0) throw std::exception("Failed at push()");
+		stack1.setFreelistCap(10);
+		for (int i = 0; i < 97; i++)
+			stack1.pop();
+		if (stack1.freeNodes() != 10) throw std::exception("Failed at setFreelistCap()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		stack1.shrink();
+		if (stack1.freeNodes() != 0 || stack1.length() != 3 || stack1.topValue() != 2) throw std::exception("Failed at shrink()");
+		for (int i = 0; i < 20; i++)
+			stack1.push(i);
+		for (int i = 0; i < 20; i++)
+			stack1.pop();
+		if (stack1.freeNodes() != 10) throw std::exception("Failed at shrink()");   // The freelist cap is kept
+		if (stack1.pop() != 2 || stack1.pop() != 1 || stack1.pop() != 0) throw std::exception("Failed at shrink()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<ThrowingMove> stack3;
+		stack3.push(ThrowingMove("a"));
+		stack3.push(ThrowingMove("b", true));
+		stack3.push(ThrowingMove("c"));
+		bool thrown = false;
+		try { stack3.shrink(); }
+		catch (const std::runtime_error&) { thrown = true; }
+		if (!thrown || stack3.length() != 3) throw std::exception("Failed at shrink() (throwing copy)");
+		if (stack3.pop().value != "c" || stack3.pop().value != "b" || stack3.pop().value != "a") throw std::exception("Failed at shrink() (throwing copy)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for double static-array stacks (two stacks sharing one array).
+	template<template<typename> class T>
+	void test_DoubleSArrayStack()
+	{
+		const Side LEFT = Side::LEFT, RIGHT = Side::RIGHT;
+
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> stack1(10);
+		stack1.push(LEFT, 1);
+		stack1.push(LEFT, 2);
+		stack1.push(RIGHT, 10);
+		stack1.push(RIGHT, 20);
+		stack1.push(RIGHT, 30);
+		if (stack1.length(LEFT) != 2 || stack1.length(RIGHT) != 3 || stack1.length() != 5) throw std::exception("Failed at length()");
+		if (stack1.topValue(LEFT) != 2 || stack1.topValue(RIGHT) != 30) throw std::exception("Failed at topValue()");
+		if (stack1.pop(RIGHT) != 30 || stack1.pop(LEFT) != 2 || stack1.pop(RIGHT) != 20 || stack1.topValue(LEFT) != 1) throw std::exception("Failed at pop()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		T<int> stack2(6);
+		for (int i = 0; i < 5; i++)
+			stack2.push(LEFT, i);
+		stack2.push(RIGHT, 100);
+		bool thrown = false;
+		try { stack2.push(LEFT, 5); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (!thrown || stack2.length() != 6) throw std::exception("Failed at push() (full)");
+		stack2.pop(RIGHT);
+		stack2.push(LEFT, 5);   // Free slot taken by the other stack
+		if (stack2.length(LEFT) != 6 || stack2.length(RIGHT) != 0 || stack2.topValue(LEFT) != 5) throw std::exception("Failed at push()");
+		thrown = false;
+		try { stack2.pop(RIGHT); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (!thrown) throw std::exception("Failed at pop() (empty)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<int> stack3(8);
+		Stack<int>& undo = stack3.stack(LEFT);
+		Stack<int>& redo = stack3.stack(RIGHT);
+		undo.push(1);
+		undo.push(2);
+		redo.push(undo.pop());
+		if (undo.length() != 1 || redo.topValue() != 2 || stack3.topValue(RIGHT) != 2) throw std::exception("Failed at stack()");
+		stack3.clear(RIGHT);
+		if (redo.length() != 0 || undo.length() != 1) throw std::exception("Failed at clear(Side)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<std::string> stack4(4);
+		stack4.push(LEFT, std::string(40, 'a'));
+		stack4.emplace(RIGHT, 40, 'b');
+		T<std::string> stack5(stack4);
+		T<std::string> stack6(1);
+		stack6 = stack4;
+		T<std::string> stack7(std::move(stack4));
+		if (stack4.length() != 0 || stack4.getCapacity() != 0) throw std::exception("Failed at move constructor");
+		if (stack5.pop(RIGHT) != std::string(40, 'b') || stack6.pop(LEFT) != std::string(40, 'a') || stack7.length() != 2) throw std::exception("Failed at copy");
+		stack7.stack(LEFT).push(std::string(40, 'c'));   // Views belong to the new object
+		if (stack7.length(LEFT) != 2 || stack7.getCapacity() != 4) throw std::exception("Failed at move constructor");
+
 		std::cout << std::endl;
 	}
 
@@ -2840,6 +10098,262 @@ namespace dss   // Data Structures namespace
 		if (queue5.length() != 1) throw std::exception("Failed at length()");
 		if (queue5.frontValue() != 4) throw std::exception("Failed at frontValue()");
 
+		std::cout << ++testNumber << " " << std::flush;   // 9
+		T<int> queue8(std::move(queue6));
+		if (queue8.length() != 4 || queue6.length() != 0) throw std::exception("Failed at move constructor");
+		queue6 = std::move(queue8);
+		if (queue6.length() != 4 || queue6.frontValue() != 4) throw std::exception("Failed at move assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 10
+		T<std::string> queue9(2);
+		std::string str(100, 'x');
+		const char* buffer = str.data();
+		queue9.enqueue(std::move(str));
+		queue9.emplace(50, 'y');
+		if (queue9.dequeue().data() != buffer || queue9.dequeue() != std::string(50, 'y')) throw std::exception("Failed at enqueue(T&&)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for dynamic-array queues (growth, batch operations and shrinking).
+	template<template<typename> class T>
+	void test_DArrayQueue()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> queue1(5);
+		if (queue1.getCapacity() != 8) throw std::exception("Failed at constructor");
+		int next = 0;
+		for (int i = 0; i < 1000; i++)   // The buffer wraps and grows several times
+		{
+			queue1.enqueue(i);
+			queue1.enqueue(i);
+			if (queue1.dequeue() != next++ / 2) throw std::exception("Failed at dequeue()");
+		}
+		if (queue1.length() != 1000 || queue1.frontValue() != 500) throw std::exception("Failed at enqueue()");
+		if (queue1.getCapacity() != 1024) throw std::exception("Failed at getCapacity()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		const int items[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[20] = { };
+		T<int> queue2(8);
+		queue2.enqueueN(items, 6);
+		if (queue2.dequeueN(out, 4) != 4 || out[3] != 3) throw std::exception("Failed at dequeueN()");
+		queue2.enqueueN(items, 5);   // Wraps: 4 5 0 1 2 3 4
+		if (queue2.length() != 7 || queue2.getCapacity() != 8) throw std::exception("Failed at enqueueN()");
+		queue2.enqueueN(items + 5, 5);   // Grows: 4 5 0 1 2 3 4 5 6 7 8 9
+		if (queue2.length() != 12 || queue2.getCapacity() != 16) throw std::exception("Failed at enqueueN()");
+		if (queue2.dequeueN(out, 20) != 12 || out[0] != 4 || out[1] != 5 || out[2] != 0 || out[11] != 9) throw std::exception("Failed at dequeueN()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<std::string> queue3(2);
+		queue3.enqueue(std::string(40, 'a'));
+		queue3.enqueue(std::string(40, 'b'));
+		queue3.enqueue(queue3.frontValue());   // Full: the argument lives in the old buffer
+		if (queue3.length() != 3 || queue3.dequeue() != std::string(40, 'a') || queue3.dequeue() != std::string(40, 'b') || queue3.dequeue() != std::string(40, 'a')) throw std::exception("Failed at enqueue()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<int> queue4;
+		for (int i = 0; i < 10000; i++)
+			queue4.enqueue(i);
+		while (queue4.length() > 0)
+			queue4.dequeue();
+		if (queue4.getCapacity() > 16) throw std::exception("Failed at dequeue()");
+		queue4.enqueue(1);
+		queue4.shrink_to_fit();
+		if (queue4.getCapacity() != 1 || queue4.frontValue() != 1) throw std::exception("Failed at shrink_to_fit()");
+		T<int> queue5(1024), queue6;
+		queue6.reserve(1000);
+		for (int round = 0; round < 3; round++)   // Fill and drain: the reserved capacity is kept
+		{
+			queue5.enqueue(round);
+			queue5.dequeue();
+			queue6.enqueueN(items, 10);
+			queue6.dequeue();
+			queue6.dequeueN(out, 10);
+		}
+		if (queue5.getCapacity() != 1024 || queue6.getCapacity() != 1024) throw std::exception("Failed at reserve()");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for linked queues (node freelist, reserve() and shrink()).
+	template<template<typename> class T>
+	void test_LinkedQueue()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> queue1;
+		queue1.reserve(100);
+		if (queue1.freeNodes() != 100) throw std::exception("Failed at reserve()");
+		for (int i = 0; i < 100; i++)
+			queue1.enqueue(i);
+		if (queue1.freeNodes() != 0) throw std::exception("Failed at enqueue()");
+		queue1.setFreelistCap(10);
+		for (int i = 0; i < 97; i++)
+			queue1.dequeue();
+		if (queue1.freeNodes() != 10) throw std::exception("Failed at setFreelistCap()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		queue1.shrink();
+		if (queue1.freeNodes() != 0 || queue1.length() != 3 || queue1.frontValue() != 97) throw std::exception("Failed at shrink()");
+		for (int i = 0; i < 20; i++)
+			queue1.enqueue(i);
+		if (queue1.dequeue() != 97 || queue1.dequeue() != 98 || queue1.dequeue() != 99) throw std::exception("Failed at shrink()");
+		for (int i = 0; i < 20; i++)
+			queue1.dequeue();
+		if (queue1.freeNodes() != 10) throw std::exception("Failed at shrink()");   // The freelist cap is kept
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<ThrowingMove> queue3;
+		queue3.enqueue(ThrowingMove("a"));
+		queue3.enqueue(ThrowingMove("b", true));
+		queue3.enqueue(ThrowingMove("c"));
+		bool thrown = false;
+		try { queue3.shrink(); }
+		catch (const std::runtime_error&) { thrown = true; }
+		if (!thrown || queue3.length() != 3) throw std::exception("Failed at shrink() (throwing copy)");
+		if (queue3.dequeue().value != "a" || queue3.dequeue().value != "b" || queue3.dequeue().value != "c") throw std::exception("Failed at shrink() (throwing copy)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for single-producer/single-consumer queues (try_ operations, batches, and a producer and a consumer thread).
+	template<template<typename> class T>
+	void test_SPSCQueue()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> queue1(3);
+		int item = -1;
+		if (queue1.getCapacity() != 4 || queue1.try_dequeue(item) || item != -1) throw std::exception("Failed at try_dequeue() (empty)");
+		for (int i = 0; i < 4; i++)
+			if (!queue1.try_enqueue(i)) throw std::exception("Failed at try_enqueue()");
+		if (queue1.try_enqueue(4) || queue1.length() != 4) throw std::exception("Failed at try_enqueue() (full)");
+		if (!queue1.try_dequeue(item) || item != 0 || !queue1.try_enqueue(4)) throw std::exception("Failed at try_dequeue()");
+		for (int i = 1; i < 5; i++)
+			if (queue1.dequeue() != i) throw std::exception("Failed at dequeue()");
+		if (!queue1.empty()) throw std::exception("Failed at empty()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		const int items[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		int out[10] = { };
+		T<int> queue2(8);
+		if (queue2.enqueueN(items, 6) != 6 || queue2.dequeueN(out, 4) != 4 || out[3] != 3) throw std::exception("Failed at enqueueN()/dequeueN()");
+		if (queue2.enqueueN(items, 10) != 6 || queue2.length() != 8) throw std::exception("Failed at enqueueN() (full)");   // Wraps: 4 5 0 1 2 3 4 5
+		if (queue2.dequeueN(out, 10) != 8 || out[0] != 4 || out[2] != 0 || out[7] != 5 || queue2.dequeueN(out, 1) != 0) throw std::exception("Failed at dequeueN()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<std::string> queue3(4);
+		std::string str(100, 'x');
+		const char* buffer = str.data();
+		queue3.try_emplace(40, 'a');
+		queue3.enqueue(std::move(str));
+		queue3.enqueue(std::string(40, 'c'));   // Left in the queue: destroyed by the destructor
+		if (queue3.dequeue() != std::string(40, 'a') || queue3.dequeue().data() != buffer) throw std::exception("Failed at enqueue(T&&)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		const size_t count = 200000;
+		T<size_t> queue4(64);
+		std::thread producer([&]() {
+			size_t batch[16];
+			for (size_t i = 0; i < count; )
+			{
+				if (i % 3 == 0)
+					queue4.enqueue(i++);
+				else
+				{
+					size_t n = std::min<size_t>(16, count - i);
+					for (size_t j = 0; j < n; j++) batch[j] = i + j;
+					i += queue4.enqueueN(batch, n);
+				}
+			}
+		});
+		bool ordered = true;
+		size_t batch[16];
+		for (size_t next = 0; next < count; )
+		{
+			size_t n = (next % 2 ? queue4.dequeueN(batch, 16) : (queue4.try_dequeue(batch[0]) ? 1 : 0));
+			for (size_t j = 0; j < n; j++)
+				if (batch[j] != next++) ordered = false;
+			if (!n) std::this_thread::yield();
+		}
+		producer.join();
+		if (!ordered || !queue4.empty()) throw std::exception("Failed at concurrent enqueue/dequeue");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for multi-producer/multi-consumer queues (try_ operations, and stress with 2 to 64 threads: half producers, half consumers).
+	template<template<typename> class T>
+	void test_MPMCQueue()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int> queue1(3);
+		int item = -1;
+		if (queue1.getCapacity() != 4 || queue1.try_dequeue(item) || item != -1) throw std::exception("Failed at try_dequeue() (empty)");
+		for (int i = 0; i < 4; i++)
+			if (!queue1.try_enqueue(i)) throw std::exception("Failed at try_enqueue()");
+		if (queue1.try_enqueue(4) || queue1.length() != 4) throw std::exception("Failed at try_enqueue() (full)");
+		for (int lap = 0; lap < 10; lap++)   // Cells are reused lap after lap
+		{
+			if (!queue1.try_dequeue(item) || item != lap || !queue1.try_enqueue(lap + 4)) throw std::exception("Failed at try_dequeue()");
+		}
+		queue1.clear();
+		if (!queue1.empty() || !queue1.try_enqueue(1) || queue1.dequeue() != 1) throw std::exception("Failed at clear()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		T<std::string> queue2(4);
+		queue2.try_emplace(40, 'a');
+		queue2.enqueue(std::string(40, 'b'));
+		queue2.enqueue(std::string(40, 'c'));   // Left in the queue: destroyed by the destructor
+		Queue<std::string>& base = queue2;
+		bool thrown = false;
+		try { base.frontValue(); }
+		catch (const std::logic_error&) { thrown = true; }
+		if (!thrown || base.dequeue() != std::string(40, 'a') || base.dequeue() != std::string(40, 'b') || base.length() != 1) throw std::exception("Failed at Queue<T> interface");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		for (size_t threads = 2; threads <= 64; threads *= 2)
+		{
+			const size_t producers = threads / 2, consumers = threads - producers, perProducer = 2000;
+			T<size_t> queue3(16);
+			std::atomic<size_t> received(0), failures(0);
+			std::vector<std::thread> pool;
+
+			for (size_t p = 0; p < producers; p++)
+				pool.emplace_back([&, p]() {
+					for (size_t i = 0; i < perProducer; i++)
+						queue3.enqueue(p * perProducer + i);
+				});
+
+			for (size_t c = 0; c < consumers; c++)
+				pool.emplace_back([&]() {
+					std::vector<size_t> last(producers, 0);   // Next index expected from each producer (FIFO per producer)
+					size_t value;
+					while (received.load() < producers * perProducer)
+					{
+						if (!queue3.try_dequeue(value)) { std::this_thread::yield(); continue; }
+						received++;
+						size_t p = value / perProducer, i = value % perProducer;
+						if (p >= producers || i < last[p]) failures++;
+						else last[p] = i + 1;
+					}
+				});
+
+			for (std::thread& thread : pool) thread.join();
+			if (failures.load() || received.load() != producers * perProducer || !queue3.empty()) throw std::exception("Failed at concurrent enqueue/dequeue");
+		}
+
 		std::cout << std::endl;
 	}
 
@@ -2850,66 +10364,384 @@ namespace dss   // Data Structures namespace
 		size_t testNumber = 0;
 		std::cout << typeid(T).name() << ": " << std::flush;
 
+		auto matches = [](const T<int, std::string>& dict, const std::map<int, std::string>& model)   // Same pairs as the model
+		{
+			if ((size_t)dict.length() != model.size()) return false;
+			for (auto& pair : model)
+				if (!dict.find(pair.first) || *dict.find(pair.first) != pair.second || dict[pair.first] != pair.second) return false;
+			return true;
+		};
+		auto removeAny = [](T<int, std::string>& dict, std::map<int, std::string>& model)   // Any pair may be removed (the order depends on the dictionary): remove it from the model too
+		{
+			std::string element = dict.removeAny();
+			for (auto it = model.begin(); it != model.end(); ++it)
+				if (it->second == element) { model.erase(it); return true; }
+			return false;
+		};
+
 		std::cout << ++testNumber << " " << std::flush;   // 1
-		StaticArrayDictionary<int, std::string> dict1(0);
+		T<int, std::string> dict1(0);
 		dict1.clear();
 		if (dict1.length() != 0) throw std::exception("Failed at length()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 2
-		StaticArrayDictionary<int, std::string> dict2(10);
+		T<int, std::string> dict2(10);
 		dict2.insert(1, "pos 1");
 		dict2.insert(2, "pos 2");
 		dict2.insert(3, "pos 3");
 		dict2.remove(2);
 		dict2.insert(4, "pos 4");
 		dict2.insert(5, "pos 5");
-		dict2.removeAny();
+		std::map<int, std::string> model2 = { { 1, "pos 1" }, { 3, "pos 3" }, { 4, "pos 4" }, { 5, "pos 5" } };
+		if (!matches(dict2, model2)) throw std::exception("Failed at insert()/remove()");
+		if (!removeAny(dict2, model2)) throw std::exception("Failed at removeAny()");
 		if (dict2.length() != 3) throw std::exception("Failed at length()");
-		if (*dict2.find(4) != "pos 4") throw std::exception("Failed at find()");
-		if (dict2[3] != "pos 3") throw std::exception("Failed at operator []");
+		if (!matches(dict2, model2)) throw std::exception("Failed at find()/operator []");
 		
 		std::cout << ++testNumber << " " << std::flush;   // 3
-		StaticArrayDictionary<int, std::string> dict3(dict2);
+		T<int, std::string> dict3(dict2);
 		dict3.insert(2, "pos 2");
 		dict3.insert(5, "pos 5");
 		dict3.insert(6, "pos 6");
 		dict3.remove(2);
 		dict3.insert(2, "pos 2 new");
 		dict3.insert(7, "pos 7");
-		dict3.removeAny();
-		if (dict3.length() != 6) throw std::exception("Failed at length()");
-		if (*dict3.find(2) != std::string("pos 2 new")) throw std::exception("Failed at find()");
-		if (*dict3.find(3) != std::string("pos 3")) throw std::exception("Failed at find()");
-		if (dict3[5] != "pos 5") throw std::exception("Failed at operator []");
+		std::map<int, std::string> model3 = model2;
+		model3[2] = "pos 2 new";
+		model3[5] = "pos 5";
+		model3[6] = "pos 6";
+		model3[7] = "pos 7";
+		if (!matches(dict3, model3)) throw std::exception("Failed at insert()/remove()");
+		if (!removeAny(dict3, model3) || !matches(dict3, model3)) throw std::exception("Failed at removeAny()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 4
-		StaticArrayDictionary<int, std::string> dict4 = dict3;
+		T<int, std::string> dict4 = dict3;
 		dict4.insert(9, "pos 9");
 		dict4.insert(7, "pos 7");
 		dict4.insert(7, "pos 7 new");
 		dict4.remove(9);
 		dict4.insert(9, "pos 9 again");
 		dict4.insert(8, "pos 8");
-		dict4.removeAny();
-		if (dict4.length() != 8) throw std::exception("Failed at length()");
-		if (*dict4.find(7) != std::string("pos 7 new")) throw std::exception("Failed at find()");
-		if (*dict4.find(3) != std::string("pos 3")) throw std::exception("Failed at find()");
-		if (*dict4.find(9) != std::string("pos 9 again")) throw std::exception("Failed at find()");
-		if (dict4[5] != "pos 5") throw std::exception("Failed at operator []");
+		std::map<int, std::string> model4 = model3;
+		model4[7] = "pos 7 new";
+		model4[8] = "pos 8";
+		model4[9] = "pos 9 again";
+		if (!matches(dict4, model4)) throw std::exception("Failed at insert()/remove()");
+		if (!removeAny(dict4, model4) || !matches(dict4, model4)) throw std::exception("Failed at removeAny()");
 
 		std::cout << ++testNumber << " " << std::flush;   // 5
 		dict3 = dict4;
-		if (dict3.length() != 8) throw std::exception("Failed at length()");
-		if (*dict3.find(7) != std::string("pos 7 new")) throw std::exception("Failed at find()");
-		if (*dict3.find(3) != std::string("pos 3")) throw std::exception("Failed at find()");
-		if (*dict3.find(9) != std::string("pos 9 again")) throw std::exception("Failed at find()");
-		if (dict3[5] != "pos 5") throw std::exception("Failed at operator []");
+		if (!matches(dict3, model4)) throw std::exception("Failed at operator=");
 
 		std::cout << ++testNumber << " " << std::flush;   // 6
-		StaticArrayDictionary<int, std::string> dict5 = dict4;
+		T<int, std::string> dict5 = dict4;
 		dict5.clear();
 		if (dict5.length() != 0) throw std::exception("Failed at length()");
 
+		std::cout << ++testNumber << " " << std::flush;   // 7
+		T<int, std::string> dict6(std::move(dict4));
+		if (!matches(dict6, model4) || dict4.length() != 0) throw std::exception("Failed at move constructor");
+		dict4 = std::move(dict6);
+		if (!matches(dict4, model4)) throw std::exception("Failed at move assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 8
+		const T<int, std::string>& shared = dict4;   // Concurrent readers (const lookups mustn't modify the dictionary)
+		std::atomic<int> errors(0);
+		std::vector<std::thread> readers;
+		for (int t = 0; t < 4; t++)
+			readers.emplace_back([&shared, &model4, &errors]() {
+				for (int i = 0; i < 1000; i++)
+					for (int k = 1; k <= 10; k++)
+					{
+						const std::string* element = shared.find(k);
+						if ((element != nullptr) != (model4.count(k) != 0) || (element && (*element != shared[k] || *element != model4.at(k)))) errors++;
+					}
+			});
+		for (std::thread& reader : readers) reader.join();
+		if (errors) throw std::exception("Failed at find() (concurrent readers)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 9
+		T<int, ThrowingCopy> dict7(4), dict8(4);
+		dict7.insert(1, ThrowingCopy("a"));
+		dict7.insert(2, ThrowingCopy("b"));
+		dict8.insert(3, ThrowingCopy("c"));
+		dict8.insert(4, ThrowingCopy("d"));
+		dict8[4].throwOnCopy = true;
+		bool thrown = false;
+		try { dict7 = dict8; }
+		catch (const std::runtime_error&) { thrown = true; }
+		if (!thrown || dict7.length() != 2 || dict7[1].value != "a" || dict7[2].value != "b" || dict7.find(3)) throw std::exception("Failed at operator= (throwing copy)");
+
+		std::cout << std::endl;
+	}
+
+	/// Transparent string hash (hashes std::string, const char* and std::string_view alike), for heterogeneous lookup in test_HashDictionary.
+	struct StringHash
+	{
+		typedef void is_transparent;
+		size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+	};
+
+	/// Tests for hash dictionaries (growth, backward-shift removal, load factor and heterogeneous lookup).
+	template<template<typename, typename> class T>
+	void test_HashDictionary()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int, int> dict1;
+		for (int i = 0; i < 100000; i++)
+			dict1.insert(i * 7, i);
+		if (dict1.length() != 100000 || dict1.getCapacity() * dict1.getMaxLoadFactor() < 100000) throw std::exception("Failed at insert()");
+		for (int i = 0; i < 100000; i++)
+			if (!dict1.find(i * 7) || *dict1.find(i * 7) != i || dict1.find(i * 7 + 1)) throw std::exception("Failed at find()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		size_t capacity = dict1.getCapacity();
+		for (int i = 0; i < 100000; i += 2)
+			if (dict1.remove(i * 7) != i) throw std::exception("Failed at remove()");
+		for (int i = 0; i < 100000; i++)
+			if ((dict1.find(i * 7) != nullptr) != (i % 2 == 1)) throw std::exception("Failed at remove()");
+		for (int i = 0; i < 100000; i += 2)
+			dict1.insert(i * 7, -i);   // Reuses the freed slots (no tombstones)
+		if (dict1.length() != 100000 || dict1.getCapacity() != capacity || dict1[14] != -2) throw std::exception("Failed at insert() after remove()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		T<int, int> dict3(1000);
+		capacity = dict3.getCapacity();
+		for (int i = 0; i < 1000; i++)
+			dict3.insert(i, i);
+		if (dict3.getCapacity() != capacity) throw std::exception("Failed at reserve()");
+		dict3.setMaxLoadFactor(0.5f);
+		if (dict3.getCapacity() < 2000 || dict3.length() != 1000 || dict3[999] != 999) throw std::exception("Failed at setMaxLoadFactor()");
+		while (dict3.length()) dict3.removeAny();
+		if (dict3.find(0)) throw std::exception("Failed at removeAny()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		HashDictionary<std::string, int, StringHash, std::equal_to<>> dict4;
+		dict4.insert(std::string(40, 'a'), 1);
+		dict4.insert("key", 2);
+		const char* key = "key";
+		if (!dict4.find(key) || *dict4.find(key) != 2 || !dict4.contains(std::string_view(std::string(40, 'a'))) || dict4.find("none")) throw std::exception("Failed at find() (heterogeneous)");
+		HashDictionary<std::string, int, StringHash, std::equal_to<>> dict5(dict4);
+		dict4.clear();
+		if (dict4.length() || dict5.length() != 2 || dict5["key"] != 2) throw std::exception("Failed at copy constructor");
+
+		std::cout << ++testNumber << " " << std::flush;   // 5
+		T<int, std::string> dict6(4);
+		dict6.insert(1, std::string(40, 'a'));
+		dict6.insert(2, "b");
+		dict6.insert(1, dict6[2]);   // Replaces the element
+		T<int, std::string> dict7(std::move(dict6));
+		if (dict6.length() != 0 || dict6.find(1) || dict7.length() != 2 || dict7[1] != "b") throw std::exception("Failed at move constructor");
+		dict6 = std::move(dict7);
+		dict7 = dict6;
+		if (dict6.length() != 2 || dict7.remove(2) != "b" || dict7.length() != 1 || dict6[2] != "b") throw std::exception("Failed at assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 6
+		T<int, ThrowingMove> dict8;   // Pairs are copied when rehashing, because their move may throw
+		dict8.insert(0, ThrowingMove("0"));
+		capacity = dict8.getCapacity();
+		for (int i = 1; i + 1 <= capacity * dict8.getMaxLoadFactor(); i++)
+			dict8.insert(i, ThrowingMove(std::to_string(i)));
+		int count = dict8.length();
+		dict8[count / 2].throwOnCopy = true;
+		bool thrown = false;
+		try { dict8.insert(count, ThrowingMove("new")); }
+		catch (const std::runtime_error&) { thrown = true; }
+		if (!thrown || dict8.length() != count || dict8.getCapacity() != capacity || dict8.find(count)) throw std::exception("Failed at insert() (throwing copy while rehashing)");
+		for (int i = 0; i < count; i++)
+			if (!dict8.find(i) || dict8[i].value != std::to_string(i)) throw std::exception("Failed at insert() (throwing copy while rehashing)");
+		dict8[count / 2].throwOnCopy = false;
+		dict8.insert(count, ThrowingMove("new"));
+		if (dict8.length() != count + 1 || dict8.getCapacity() != capacity * 2 || dict8[count].value != "new" || dict8[0].value != "0") throw std::exception("Failed at insert() (rehash)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for sorted dictionaries (ordered queries, bulk load and batch insertion).
+	template<template<typename, typename> class T>
+	void test_SortedDictionary()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int, std::string> dict1(10);
+		dict1.insert(5, "5");
+		dict1.insert(1, "1");
+		dict1.insert(3, "3");
+		dict1.insert(5, "5 new");
+		if (dict1.length() != 3 || *dict1.find(5) != "5 new" || dict1.find(2) || dict1[1] != "1") throw std::exception("Failed at insert()");
+		if (dict1.removeAny() != "5 new" || dict1.remove(1) != "1" || dict1.length() != 1 || dict1.begin()->key != 3) throw std::exception("Failed at remove()");
+		bool thrown = false;
+		try { dict1.remove(7); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (!thrown) throw std::exception("Failed at remove() (non-existent)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		std::vector<KVpair<int, int>> pairs;
+		for (int i = 0; i < 1000; i++)
+			pairs.push_back(KVpair<int, int>((i * 7919) % 1000 * 2, i));   // Even keys 0..1998, shuffled
+		pairs.push_back(KVpair<int, int>(0, -1));   // Repeated key: the last pair wins
+		T<int, int> dict2(pairs.data(), pairs.data() + pairs.size(), 2000);
+		if (dict2.length() != 1000 || dict2[0] != -1) throw std::exception("Failed at constructor (bulk load)");
+		for (int i = 1; i < 1000; i++)
+			if (dict2[pairs[i].key] != i) throw std::exception("Failed at constructor (bulk load)");
+		for (int k = 0; k < 2000; k++)
+			if ((dict2.find(k) != nullptr) != (k % 2 == 0)) throw std::exception("Failed at find()");
+		auto range = dict2.range(10, 20);   // 10 12 14 16 18 20
+		if (range.second - range.first != 6 || range.first->key != 10 || dict2.lower_bound(11)->key != 12 || dict2.upper_bound(1998) != dict2.end()) throw std::exception("Failed at range()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		const KVpair<int, int> batch[] = { { 1, 1 }, { 4, 40 }, { 3, 3 }, { 1, 10 }, { 2001, 0 } };
+		dict2.insertRange(batch, batch + 5);   // New keys 1, 3, 2001; 4 replaced
+		if (dict2.length() != 1003 || dict2[1] != 10 || dict2[4] != 40 || (dict2.end() - 1)->key != 2001) throw std::exception("Failed at insertRange()");
+		for (auto it = dict2.begin() + 1; it != dict2.end(); it++)
+			if (!((it - 1)->key < it->key)) throw std::exception("Failed at insertRange() (order)");
+		thrown = false;
+		T<int, int> dict3(dict2);
+		try { dict3.insertRange(pairs.data(), pairs.data() + pairs.size()); dict3.insertRange(batch, batch + 1); dict3.insertRange(batch + 4, batch + 5); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (thrown || dict3.length() != 1003) throw std::exception("Failed at insertRange() (existing keys)");
+		T<int, int> dict4(2);
+		dict4.insert(1, 1);
+		try { dict4.insertRange(batch, batch + 5); }
+		catch (const std::out_of_range&) { thrown = true; }
+		if (!thrown || dict4.length() != 1 || dict4[1] != 1) throw std::exception("Failed at insertRange() (full)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<int, int> dict5(std::move(dict3));
+		dict4 = dict5;
+		if (dict5.length() != 1003 || dict3.length() != 0 || dict4.length() != 1003 || dict4[3] != 3) throw std::exception("Failed at copy/move");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for frozen dictionaries (built from other dictionaries or from pairs; ordered queries).
+	template<template<typename, typename> class T>
+	void test_FrozenDictionary()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int, std::string> dict1;
+		if (dict1.length() != 0 || dict1.find(1) || dict1.begin() != dict1.end() || dict1.lower_bound(1) != dict1.end()) throw std::exception("Failed at length()");
+		bool thrown = false;
+		try { dict1.insert(1, "1"); }
+		catch (const std::logic_error&) { thrown = true; }
+		if (!thrown || dict1.length() != 0) throw std::exception("Failed at insert() (read-only)");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		for (int count = 0; count < 200; count++)   // Every tree shape up to 200 keys
+		{
+			HashDictionary<int, int> source;
+			StaticArrayDictionary<int, int> source2(count);
+			for (int i = 0; i < count; i++)
+			{
+				source.insert((i * 211) % count * 2, i);   // Even keys 0..2*count-2
+				source2.insert((i * 211) % count * 2, i);
+			}
+			T<int, int> dict2(source);
+			T<int, int> dict3(source2);
+			if (dict2.length() != count || dict3.length() != count) throw std::exception("Failed at constructor (from dictionary)");
+			for (int k = -1; k <= 2 * count; k++)
+			{
+				const int* element = dict2.find(k);
+				if ((element != nullptr) != (k >= 0 && k % 2 == 0 && k < 2 * count) || (element && *element != *source.find(k))) throw std::exception("Failed at find()");
+				int lower = (k < 0 ? 0 : (k + 1) / 2);   // Position of the first key >= k
+				int upper = (k < 0 ? 0 : k / 2 + 1);   // Position of the first key > k
+				if (std::distance(dict2.lower_bound(k), dict2.end()) != count - std::min(lower, count) || std::distance(dict3.upper_bound(k), dict3.end()) != count - std::min(upper, count)) throw std::exception("Failed at lower_bound()/upper_bound()");
+			}
+		}
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		const KVpair<std::string, int> pairs[] = { { "pear", 1 }, { "apple", 2 }, { "fig", 3 }, { "kiwi", 4 }, { "apple", 5 }, { "lime", 6 } };
+		T<std::string, int> dict4(pairs, pairs + 6);   // The last "apple" wins
+		auto range = dict4.range("b", "kiwi");
+		if (dict4.length() != 5 || dict4["apple"] != 5 || dict4.find("grape") || std::distance(range.first, range.second) != 2 || range.first->key != "fig") throw std::exception("Failed at constructor (from pairs)");
+		dict4["fig"] = 30;
+		std::string visited;
+		dict4.forEach([&visited](const std::string& k, const int& e) { visited += k + std::to_string(e) + " "; });
+		if (visited != "apple5 fig30 kiwi4 lime6 pear1 ") throw std::exception("Failed at forEach()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 4
+		T<std::string, int> dict5(dict4);
+		T<std::string, int> dict6;
+		dict6 = dict5;
+		T<std::string, int> dict7(std::move(dict5));
+		dict4.clear();
+		if (dict4.length() != 0 || dict5.length() != 0 || dict6["pear"] != 1 || dict7["kiwi"] != 4 || dict7.length() != 5 || dict7.begin()->key != "apple") throw std::exception("Failed at copy/move");
+		dict6 = std::move(dict7);
+		if (dict6.length() != 5 || !dict6.find("lime") || dict7.find("lime")) throw std::exception("Failed at move-assignment");
+
+		std::cout << ++testNumber << " " << std::flush;   // 5
+		const KVpair<int, ThrowingCopy> pairs2[] = { { 1, ThrowingCopy("a") }, { 2, ThrowingCopy("b") } };
+		const KVpair<int, ThrowingCopy> pairs3[] = { { 3, ThrowingCopy("c") }, { 4, ThrowingCopy("d") }, { 5, ThrowingCopy("e") } };
+		T<int, ThrowingCopy> dict8(pairs2, pairs2 + 2), dict9(pairs3, pairs3 + 3);
+		dict9[5].throwOnCopy = true;
+		thrown = false;
+		try { dict8 = dict9; }
+		catch (const std::runtime_error&) { thrown = true; }
+		if (!thrown || dict8.length() != 2 || dict8[1].value != "a" || dict8[2].value != "b" || dict8.find(3)) throw std::exception("Failed at operator= (throwing copy)");
+
+		std::cout << std::endl;
+	}
+
+	/// Tests for dictionaries shared by threads (reader/writer lock).
+	template<template<typename, typename> class T>
+	void test_RWLockedDictionary()
+	{
+		size_t testNumber = 0;
+		std::cout << typeid(T).name() << ": " << std::flush;
+
+		std::cout << ++testNumber << " " << std::flush;   // 1
+		T<int, std::string> dict1(4);
+		dict1.insert(1, "1");
+		dict1.insert(2, "2");
+		std::string element;
+		if (!dict1.get(1, element) || element != "1" || dict1.get(3, element) || !dict1.contains(2) || dict1.length() != 2) throw std::exception("Failed at get()");
+		if (!dict1.read(2, [](const std::string& e) { if (e != "2") throw std::exception("Failed at read()"); }) || dict1.read(3, [](const std::string&) { })) throw std::exception("Failed at read()");
+		if (dict1.remove(1) != "1" || dict1.removeAny() != "2" || dict1.length() != 0) throw std::exception("Failed at remove()");
+		dict1.withWriteLock([](auto& dict) { dict.insert(5, "5"); dict.insert(6, "6"); });
+		if (dict1.withReadLock([](const auto& dict) { return dict.length(); }) != 2) throw std::exception("Failed at withReadLock()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 2
+		T<int, int> dict2;   // Writers keep element == 2 * key for every key present
+		for (int k = 0; k < 100; k++) dict2.insert(k, 2 * k);
+		std::atomic<int> errors(0);
+		std::atomic<bool> stop(false);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 3; t++)
+			threads.emplace_back([&dict2, &errors, &stop, t]() {
+				int element;
+				for (int i = 0; !stop || i < 1000; i++)
+				{
+					int k = (i * 7 + t) % 200;
+					if (dict2.get(k, element) && element != 2 * k) errors++;
+					if (i % 64 == 0) std::this_thread::yield();
+				}
+			});
+		for (int round = 0; round < 200; round++)
+		{
+			int k = 100 + round % 100;
+			if (round < 100) dict2.insert(k, 2 * k);
+			else dict2.remove(k);
+			if (round % 8 == 0) std::this_thread::yield();
+		}
+		stop = true;
+		for (std::thread& thread : threads) thread.join();
+		if (errors || dict2.length() != 100) throw std::exception("Failed at concurrent get()/insert()/remove()");
+
+		std::cout << ++testNumber << " " << std::flush;   // 3
+		RWLockedDictionary<int, int, FrozenDictionary<int, int>> frozen;
+		bool thrown = false;
+		try { frozen.insert(1, 1); }
+		catch (const std::logic_error&) { thrown = true; }
+		if (!thrown || frozen.length() != 0) throw std::exception("Failed at insert() (exception)");   // length() would block if the exception hadn't released the lock
+
 		std::cout << std::endl;
 	}
 }
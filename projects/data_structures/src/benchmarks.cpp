@@ -0,0 +1,1235 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <list>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include "benchmarks.hpp"
+
+namespace dss
+{
+	// -- Helpers --------------------------------------
+
+	volatile size_t benchSink;   // Results are written here so the compiler cannot discard the benchmarked work.
+
+	/// Run a function several times and return the best time (milliseconds).
+	template <typename F>
+	double bestTime(F function, unsigned repetitions = 5)
+	{
+		double best = 0;
+		for (unsigned i = 0; i < repetitions; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if (i == 0 || elapsed.count() < best) best = elapsed.count();
+		}
+
+		return best;
+	}
+
+	/// Like bestTime(), but "setup" runs before each repetition and is not timed (for operations that consume their input).
+	template <typename S, typename F>
+	double bestTimeWithSetup(S setup, F function, unsigned repetitions = 5)
+	{
+		double best = 0;
+		for (unsigned i = 0; i < repetitions; i++)
+		{
+			setup();
+			auto start = std::chrono::steady_clock::now();
+			function();
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if (i == 0 || elapsed.count() < best) best = elapsed.count();
+		}
+
+		return best;
+	}
+
+	/// Print one benchmark result: name, time and throughput.
+	void printResult(const std::string& name, size_t operations, double ms)
+	{
+		std::cout << "    " << std::left << std::setw(40) << name << std::right
+			<< std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms"
+			<< std::setw(12) << std::setprecision(1) << (ms > 0 ? operations / (ms * 1000) : 0) << " ops/us" << std::endl;
+	}
+
+	/// Former DynamicArray growth path, kept here as a baseline: the new array is default-constructed (new T[]) and every element is copy-assigned.
+	template <typename T>
+	class LegacyGrowthArray
+	{
+		T* array;
+		size_t capacity;
+		size_t size;
+
+	public:
+		LegacyGrowthArray() : array(new T[0]), capacity(0), size(0) { }
+		~LegacyGrowthArray() { delete[] array; }
+
+		void append(const T& item)
+		{
+			if (size == capacity)
+			{
+				capacity = capacity ? capacity * 2 : 1;
+				T* newArray = new T[capacity];
+
+				for (size_t i = 0; i < size; i++)
+					newArray[i] = array[i];
+
+				delete[] array;
+				array = newArray;
+			}
+
+			array[size++] = item;
+		}
+
+		size_t length() const { return size; }
+	};
+
+	/// Append "count" copies of "item" to each container type.
+	template <typename T>
+	void benchAppend(const std::string& typeName, size_t count, const T& item)
+	{
+		printResult("LegacyGrowthArray<" + typeName + ">::append", count, bestTime([&]() {
+			LegacyGrowthArray<T> list;
+			for (size_t i = 0; i < count; i++) list.append(item);
+			benchSink = list.length();
+		}));
+
+		printResult("DynamicArray<" + typeName + ">::append", count, bestTime([&]() {
+			DynamicArray<T> list;
+			for (size_t i = 0; i < count; i++) list.append(item);
+			benchSink = list.length();
+		}));
+
+		printResult("DynamicArray<" + typeName + ">::emplace_back", count, bestTime([&]() {
+			DynamicArray<T> list;
+			for (size_t i = 0; i < count; i++) list.emplace_back(item);
+			benchSink = list.length();
+		}));
+
+		printResult("DynamicArray<" + typeName + "> + reserve", count, bestTime([&]() {
+			DynamicArray<T> list;
+			list.reserve(count);
+			for (size_t i = 0; i < count; i++) list.append(item);
+			benchSink = list.length();
+		}));
+
+		printResult("std::vector<" + typeName + ">::push_back", count, bestTime([&]() {
+			std::vector<T> list;
+			for (size_t i = 0; i < count; i++) list.push_back(item);
+			benchSink = list.size();
+		}));
+	}
+
+	/// Append "count" elements, then oscillate (remove 3/4, append them back) around the capacity boundary. Print time, reallocations, bytes copied and unused capacity.
+	template <typename Growth>
+	void benchGrowthPolicy(const std::string& policyName, size_t count, float shrinkThreshold)
+	{
+		size_t reallocations = 0, bytesCopied = 0, wasted = 0;
+
+		double ms = bestTime([&]() {
+			DynamicArray<int, Growth> list;
+			list.setShrinkThreshold(shrinkThreshold);
+			for (size_t i = 0; i < count; i++) list.append((int)i);
+			wasted = list.getCapacity() - list.length();
+
+			for (size_t round = 0; round < 4; round++)
+			{
+				for (size_t i = 0; i < count * 3 / 4; i++)
+				{
+					list.moveToEnd();
+					list.prev();
+					list.remove();
+				}
+				for (size_t i = 0; i < count * 3 / 4; i++) list.append((int)i);
+			}
+
+			reallocations = list.reallocations();
+			bytesCopied = list.bytesCopied();
+			benchSink = list.length();
+		}, 1);
+
+		std::cout << "    " << std::left << std::setw(14) << policyName << " shrink " << std::setw(5) << std::fixed << std::setprecision(2) << shrinkThreshold << std::right
+			<< std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms"
+			<< std::setw(8) << reallocations << " reallocs"
+			<< std::setw(10) << std::setprecision(1) << bytesCopied / 1048576.0 << " MB copied"
+			<< std::setw(8) << std::setprecision(1) << 100.0 * wasted / (wasted + count) << " % unused" << std::endl;
+	}
+
+
+	/// Linked list with each node allocator: append "count" nodes and clear, then traverse a list built interleaved with another one (so heap nodes are not contiguous).
+	template <template <typename, template <typename> class> class L, template <typename> class Alloc>
+	void benchNodeList(const std::string& name, size_t count)
+	{
+		printResult(name + " append + clear", count, bestTime([&]() {
+			L<int, Alloc> list;
+			for (int round = 0; round < 2; round++)
+			{
+				for (size_t i = 0; i < count / 2; i++) list.append((int)i);
+				list.clear();
+			}
+			benchSink = list.length();
+		}));
+
+		L<int, Alloc> list, other;
+		for (size_t i = 0; i < count; i++)
+		{
+			list.append((int)i);
+			other.append((int)i);
+		}
+
+		printResult(name + " traverse", count, bestTime([&]() { benchSink = find(list, -1); }));
+	}
+
+	/// Stack and queue with each node allocator and freelist cap: push/pop (enqueue/dequeue) "count" elements in bursts of 1000.
+	template <template <typename> class Alloc>
+	void benchNodeStackQueue(const std::string& allocName, size_t count, size_t freelistCap)
+	{
+		printResult("LinkedStack<int, " + allocName + "> push/pop", count, bestTime([&]() {
+			LinkedStack<int, Alloc> stack;
+			stack.setFreelistCap(freelistCap);
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i += 1000)
+			{
+				for (size_t j = 0; j < 1000; j++) stack.push((int)j);
+				for (size_t j = 0; j < 1000; j++) sum += stack.pop();
+			}
+			benchSink = sum;
+		}));
+
+		printResult("LinkedQueue<int, " + allocName + "> enqueue/dequeue", count, bestTime([&]() {
+			LinkedQueue<int, Alloc> queue;
+			queue.setFreelistCap(freelistCap);
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i += 1000)
+			{
+				for (size_t j = 0; j < 1000; j++) queue.enqueue((int)j);
+				for (size_t j = 0; j < 1000; j++) sum += queue.dequeue();
+			}
+			benchSink = sum;
+		}));
+	}
+
+
+	/// List with "count" items: append them, traverse the list, and insert/remove a burst of items at the middle.
+	template <typename L>
+	void benchSequence(const std::string& name, size_t count)
+	{
+		printResult(name + " append", count, bestTime([&]() {
+			L list;
+			for (size_t i = 0; i < count; i++) list.append((int)i);
+			benchSink = list.length();
+		}));
+
+		L list;
+		for (size_t i = 0; i < count; i++) list.append((int)i);
+
+		printResult(name + " traverse", count, bestTime([&]() { benchSink = find(list, -1); }));
+
+		size_t burst = 1000;
+		printResult(name + " seek + insert/remove middle", 2 * burst, bestTime([&]() {
+			list.moveToPos(count / 2);
+			for (size_t i = 0; i < burst; i++) list.insert((int)i);
+			for (size_t i = 0; i < burst; i++) list.remove();
+			benchSink = list.length();
+		}));
+	}
+
+	/// Many short-lived lists: construct, append some elements, copy, traverse and destroy.
+	template <typename L>
+	void benchShortLived(const std::string& name, size_t elements, size_t rounds)
+	{
+		printResult(name + ", " + std::to_string(elements) + " elements", rounds * elements, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++)
+			{
+				L list;
+				for (size_t j = 0; j < elements; j++) list.emplace_back((int)(i + j));
+				L copy(list);
+				for (int x : copy) sum += x;
+			}
+			benchSink = sum;
+		}));
+	}
+
+	/// Random access in a linked list, with and without positional index: operator[], moveToPos(), and insert/remove at random positions.
+	template <typename L>
+	void benchIndexedList(const std::string& name, size_t count, size_t operations, bool indexed)
+	{
+		L list;
+		list.enableIndex(indexed);
+		for (size_t i = 0; i < count; i++) list.append((int)i);
+
+		std::vector<size_t> positions(operations);
+		std::mt19937 rng(1);
+		for (size_t& pos : positions) pos = rng() % count;
+
+		printResult(name + " operator[]", operations, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t pos : positions) sum += list[pos];
+			benchSink = sum;
+		}, 3));
+
+		printResult(name + " moveToPos + getValue", operations, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t pos : positions)
+			{
+				list.moveToPos(pos);
+				sum += list.getValue();
+			}
+			benchSink = sum;
+		}, 3));
+
+		printResult(name + " insert/remove at pos", 2 * operations, bestTime([&]() {
+			for (size_t pos : positions)
+			{
+				list.moveToPos(pos);
+				list.insert(-1);
+				list.remove();
+			}
+			benchSink = list.length();
+		}, 3));
+	}
+
+	/// Transfer a list of "count" ints "rounds" times, with the copy constructor and with the move constructor (and move assignment to give it back). Throughput is given in elements transferred.
+	template <typename L>
+	void benchTransfer(const std::string& name, size_t count, size_t rounds)
+	{
+		L list;
+		for (size_t i = 0; i < count; i++) list.append((int)i);
+
+		printResult(name + " copy", count * rounds, bestTime([&]() {
+			for (size_t r = 0; r < rounds; r++)
+			{
+				L other(list);
+				benchSink = other.length();
+			}
+		}));
+		printResult(name + " move", count * rounds, bestTime([&]() {
+			for (size_t r = 0; r < rounds; r++)
+			{
+				L other(std::move(list));
+				benchSink = other.length();
+				list = std::move(other);
+			}
+		}));
+	}
+
+	/// Push and pop "operations" strings (too long for the small string optimization), copying them into the stack or moving them.
+	template <typename S>
+	void benchStringStack(const std::string& name, size_t operations)
+	{
+		std::string item(64, 'x');
+
+		printResult(name + " push copy/pop", operations, bestTime([&]() {
+			S stack(operations);
+			for (size_t i = 0; i < operations; i++)
+			{
+				std::string str(item);
+				stack.push(str);
+			}
+			for (size_t i = 0; i < operations; i++) benchSink = stack.pop().size();
+		}));
+		printResult(name + " push move/pop", operations, bestTime([&]() {
+			S stack(operations);
+			for (size_t i = 0; i < operations; i++)
+			{
+				std::string str(item);
+				stack.push(std::move(str));
+			}
+			for (size_t i = 0; i < operations; i++) benchSink = stack.pop().size();
+		}));
+	}
+
+	/// Rebuild one ordered list of "count" ints from sorted per-shard lists, and split it again: element by element (append) vs relinking nodes (spliceAt(), mergeSorted(), splitAt()).
+	template <typename L>
+	void benchRelink(const std::string& name, size_t count, size_t shards)
+	{
+		std::vector<L> parts(shards);
+		L list, other;
+		size_t perShard = count / shards;
+
+		auto makeShards = [&]() {   // Consecutive ranges
+			list.clear();
+			for (size_t i = 0; i < shards; i++)
+			{
+				parts[i].clear();
+				for (size_t j = 0; j < perShard; j++) parts[i].append(int(i * perShard + j));
+			}
+		};
+		printResult(name + " concat shards, append", count, bestTimeWithSetup(makeShards, [&]() {
+			for (L& part : parts)
+				for (part.moveToStart(); part.currPos() < part.length(); part.next())
+					list.append(part.getValue());
+			benchSink = list.length();
+		}));
+		printResult(name + " concat shards, spliceAt", count, bestTimeWithSetup(makeShards, [&]() {
+			for (L& part : parts)
+				list.spliceAt(list.length(), part);
+			benchSink = list.length();
+		}));
+
+		auto makeHalves = [&]() {   // Interleaved (even and odd numbers)
+			list.clear();
+			other.clear();
+			for (size_t i = 0; i < count; i++) (i % 2 ? other : list).append((int)i);
+		};
+		printResult(name + " merge 2 halves, append", count, bestTimeWithSetup(makeHalves, [&]() {
+			L result;
+			list.moveToStart();
+			other.moveToStart();
+			while (list.currPos() < list.length() || other.currPos() < other.length())
+			{
+				bool fromOther = list.currPos() == list.length() || (other.currPos() < other.length() && other.getValue() < list.getValue());
+				L& from = fromOther ? other : list;
+				result.append(from.getValue());
+				from.next();
+			}
+			benchSink = result.length();
+		}));
+		printResult(name + " merge 2 halves, mergeSorted", count, bestTimeWithSetup(makeHalves, [&]() {
+			list.mergeSorted(other);
+			benchSink = list.length();
+		}));
+
+		auto makeList = [&]() {
+			list.clear();
+			for (size_t i = 0; i < count; i++) list.append((int)i);
+		};
+		printResult(name + " split in 2, append", count, bestTimeWithSetup(makeList, [&]() {
+			L result;
+			for (list.moveToPos(count / 2); list.currPos() < list.length(); list.next())
+				result.append(list.getValue());
+			list.removeRange(count / 2, count - count / 2);
+			benchSink = result.length();
+		}));
+		printResult(name + " split in 2, splitAt", count, bestTimeWithSetup(makeList, [&]() {
+			L result = list.splitAt(count / 2);
+			benchSink = result.length();
+		}));
+	}
+
+	/// Search a missing item in an array of "count" elements of type T: element by element through the List interface and with std::find() vs find(), which scans the buffer with vector instructions.
+	template <typename T>
+	void benchFindContiguous(const std::string& name, size_t count, size_t rounds)
+	{
+		DynamicArray<T> array;
+		for (size_t i = 0; i < count; i++) array.append(T(i % 100));
+		T missing = T(101);
+		List<T>& list = array;
+
+		printResult(name + " List<T> cursor loop", count * rounds, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++)
+			{
+				size_t size = list.length(), pos = 0;
+				for (list.moveToStart(); pos < size && !(list.getValue() == missing); list.next(), pos++);
+				sum += pos;
+			}
+			benchSink = sum;
+		}));
+		printResult(name + " std::find", count * rounds, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++) sum += std::find(array.begin(), array.end(), missing) - array.begin();
+			benchSink = sum;
+		}));
+		printResult(name + " find(List<T>*)", count * rounds, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++) sum += find(&list, missing);
+			benchSink = sum;
+		}));
+	}
+
+	/// Queue throughput: a steady state with "backlog" ints waiting, and a burst of "count" enqueues followed by "count" dequeues. Q is constructed with capacity "count".
+	template <typename Q>
+	void benchQueue(const std::string& name, size_t count, size_t backlog)
+	{
+		Q queue(count);
+		for (size_t i = 0; i < backlog; i++) queue.enqueue((int)i);
+		printResult(name + " steady enqueue/dequeue", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				queue.enqueue((int)i);
+				sum += queue.dequeue();
+			}
+			benchSink = sum;
+		}));
+
+		queue.clear();
+		printResult(name + " burst enqueue, dequeue", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) queue.enqueue((int)i);
+			for (size_t i = 0; i < count; i++) sum += queue.dequeue();
+			benchSink = sum;
+		}));
+	}
+
+	/// SArrayQueue guarded by a mutex: the way of sharing a single-threaded queue between threads (baseline for SPSCQueue and MPMCQueue).
+	template <typename T>
+	class LockedQueue
+	{
+		SArrayQueue<T> queue;
+		size_t capacity;
+		std::mutex mutex;
+
+	public:
+		LockedQueue(size_t capacity) : queue(capacity), capacity(capacity) { }
+
+		bool try_enqueue(const T& item)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (queue.length() == capacity) return false;
+			queue.enqueue(item);
+			return true;
+		}
+
+		bool try_dequeue(T& item)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!queue.length()) return false;
+			item = queue.dequeue();
+			return true;
+		}
+	};
+
+	/// Time (best of several runs) of a producer thread passing "count" ints to a consumer (this thread) through a queue with "capacity" slots, one by one. Threads yield while the queue is full/empty.
+	template <typename Q>
+	void benchHandoff(const std::string& name, size_t count, size_t capacity)
+	{
+		printResult(name + " transfer", count, bestTime([&]() {
+			Q queue(capacity);
+			std::thread producer([&]() {
+				for (size_t i = 0; i < count; i++)
+					while (!queue.try_enqueue((int)i)) std::this_thread::yield();
+			});
+
+			size_t sum = 0;
+			int item;
+			for (size_t i = 0; i < count; i++)
+			{
+				while (!queue.try_dequeue(item)) std::this_thread::yield();
+				sum += item;
+			}
+
+			producer.join();
+			benchSink = sum;
+		}, 3));
+	}
+
+	/// Round-trip latency: this thread sends an int through one queue and waits for another thread to send it back through a second queue, "rounds" times.
+	template <typename Q>
+	void benchPingPong(const std::string& name, size_t rounds)
+	{
+		printResult(name + " round trip", rounds, bestTime([&]() {
+			Q ping(16), pong(16);
+			std::thread echo([&]() {
+				int item;
+				for (size_t i = 0; i < rounds; i++)
+				{
+					while (!ping.try_dequeue(item)) std::this_thread::yield();
+					while (!pong.try_enqueue(item)) std::this_thread::yield();
+				}
+			});
+
+			size_t sum = 0;
+			int item;
+			for (size_t i = 0; i < rounds; i++)
+			{
+				while (!ping.try_enqueue((int)i)) std::this_thread::yield();
+				while (!pong.try_dequeue(item)) std::this_thread::yield();
+				sum += item;
+			}
+
+			echo.join();
+			benchSink = sum;
+		}, 3));
+	}
+
+	/// Worker pool: "threads" threads share a queue with "capacity" slots; each one enqueues an int and then dequeues one, until "count" pairs are done in total. Threads yield while the queue is full/empty.
+	template <typename Q>
+	void benchWorkers(const std::string& name, size_t count, size_t capacity, size_t threads)
+	{
+		printResult(name + ", " + std::to_string(threads) + " threads", count, bestTime([&]() {
+			Q queue(capacity);
+			std::vector<std::thread> pool;
+			std::atomic<size_t> sum(0);
+
+			for (size_t t = 0; t < threads; t++)
+				pool.emplace_back([&, t]() {
+					size_t local = 0;
+					int item;
+					for (size_t i = t; i < count; i += threads)
+					{
+						while (!queue.try_enqueue((int)i)) std::this_thread::yield();
+						while (!queue.try_dequeue(item)) std::this_thread::yield();
+						local += item;
+					}
+					sum += local;
+				});
+
+			for (std::thread& thread : pool) thread.join();
+			benchSink = sum.load();
+		}, 3));
+	}
+
+	/// Dictionary throughput with "count" random int keys: insertion, lookup of present keys and lookup of absent keys. D is constructed with capacity "count".
+	template <typename D>
+	void benchDictionary(const std::string& name, const std::vector<int>& keys, const std::vector<int>& absent)
+	{
+		size_t count = keys.size();
+		D dict((int)count);
+		printResult(name + " insert", count, bestTime([&]() {
+			dict.clear();
+			for (size_t i = 0; i < count; i++) dict.insert(keys[i], (int)i);
+			benchSink = dict.length();
+		}, 3));
+
+		printResult(name + " find (hit)", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) sum += *dict.find(keys[i]);
+			benchSink = sum;
+		}, 3));
+
+		printResult(name + " find (miss)", count, bestTime([&]() {
+			size_t found = 0;
+			for (size_t i = 0; i < count; i++) found += (dict.find(absent[i]) != nullptr);
+			benchSink = found;
+		}, 3));
+	}
+
+	/// Build a SortedStaticArrayDictionary with the bulk-load constructor (one sort), and by merging the keys in batches of 1/16 (insertRange()); then find present and absent keys. Inserting one by one (O(n) each) is only measured if oneByOne.
+	void benchSortedDictionary(const std::string& name, const std::vector<int>& keys, const std::vector<int>& absent, bool oneByOne)
+	{
+		typedef SortedStaticArrayDictionary<int, int> D;
+		size_t count = keys.size();
+		std::vector<KVpair<int, int>> pairs;
+		for (size_t i = 0; i < count; i++) pairs.push_back(KVpair<int, int>(keys[i], (int)i));
+
+		D dict((int)count);
+		if (oneByOne)
+			printResult(name + " insert", count, bestTime([&]() {
+				dict.clear();
+				for (size_t i = 0; i < count; i++) dict.insert(keys[i], (int)i);
+				benchSink = dict.length();
+			}, 3));
+
+		printResult(name + " insertRange (x16)", count, bestTime([&]() {
+			dict.clear();
+			size_t batch = (count + 15) / 16;
+			for (size_t i = 0; i < count; i += batch)
+				dict.insertRange(pairs.data() + i, pairs.data() + std::min(i + batch, count));
+			benchSink = dict.length();
+		}, 3));
+
+		printResult(name + " bulk load", count, bestTime([&]() {
+			D loaded(pairs.data(), pairs.data() + count);
+			benchSink = loaded.length();
+			dict = std::move(loaded);
+		}, 3));
+
+		printResult(name + " find (hit)", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) sum += *dict.find(keys[i]);
+			benchSink = sum;
+		}, 3));
+
+		printResult(name + " find (miss)", count, bestTime([&]() {
+			size_t found = 0;
+			for (size_t i = 0; i < count; i++) found += (dict.find(absent[i]) != nullptr);
+			benchSink = found;
+		}, 3));
+	}
+
+	/// Build a FrozenDictionary (sort + Eytzinger layout) from pairs, then find present and absent keys.
+	void benchFrozenDictionary(const std::string& name, const std::vector<int>& keys, const std::vector<int>& absent)
+	{
+		typedef FrozenDictionary<int, int> D;
+		size_t count = keys.size();
+		std::vector<KVpair<int, int>> pairs;
+		for (size_t i = 0; i < count; i++) pairs.push_back(KVpair<int, int>(keys[i], (int)i));
+
+		D dict;
+		printResult(name + " build", count, bestTime([&]() {
+			D built(pairs.data(), pairs.data() + count);
+			benchSink = built.length();
+			dict = std::move(built);
+		}, 3));
+
+		printResult(name + " find (hit)", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) sum += *dict.find(keys[i]);
+			benchSink = sum;
+		}, 3));
+
+		printResult(name + " find (miss)", count, bestTime([&]() {
+			size_t found = 0;
+			for (size_t i = 0; i < count; i++) found += (dict.find(absent[i]) != nullptr);
+			benchSink = found;
+		}, 3));
+	}
+
+	/// Insert the pairs (keys[i], values[i]), then find present and absent keys. For dictionaries with large elements.
+	template <typename D, typename E>
+	void benchDictionaryLayout(const std::string& name, const std::vector<int>& keys, const std::vector<int>& absent, const std::vector<E>& values)
+	{
+		size_t count = keys.size();
+		D dict((int)count);
+		printResult(name + " insert", count, bestTime([&]() {
+			dict.clear();
+			for (size_t i = 0; i < count; i++) dict.insert(keys[i], values[i]);
+			benchSink = dict.length();
+		}, 3));
+
+		printResult(name + " find (hit)", count, bestTime([&]() {
+			size_t found = 0;
+			for (size_t i = 0; i < count; i++) found += (dict.find(keys[i]) != nullptr);
+			benchSink = found;
+		}, 3));
+
+		printResult(name + " find (miss)", count, bestTime([&]() {
+			size_t found = 0;
+			for (size_t i = 0; i < count; i++) found += (dict.find(absent[i]) != nullptr);
+			benchSink = found;
+		}, 3));
+	}
+
+	/// Dictionary protected by a plain mutex (readers exclude each other too). Baseline for RWLockedDictionary.
+	template <typename D>
+	class MutexDictionary
+	{
+		D dict;
+		mutable std::mutex mutex;
+
+	public:
+		MutexDictionary(int size) : dict(size) { }
+
+		bool get(int k, int& e) const
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			const int* found = dict.find(k);
+			if (!found) return false;
+			e = *found;
+			return true;
+		}
+
+		void insert(int k, int e)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			dict.insert(k, e);
+		}
+	};
+
+	/// Time (best of several runs) of "threads" threads doing "count" operations in total on the same dictionary: lookup(key) for random present keys, and update(key) every "writeEvery" operations (0 = never).
+	template <typename Lookup, typename Update>
+	void benchReaders(const std::string& name, const std::vector<int>& keys, size_t count, size_t threads, size_t writeEvery, Lookup lookup, Update update)
+	{
+		printResult(name + ", " + std::to_string(threads) + " threads", count, bestTime([&]() {
+			std::vector<std::thread> pool;
+			std::atomic<size_t> sum(0);
+
+			for (size_t t = 0; t < threads; t++)
+				pool.emplace_back([&, t]() {
+					size_t local = 0;
+					size_t k = t * 7919;
+					for (size_t i = t; i < count; i += threads)
+					{
+						k = (k + 104729) % keys.size();   // Jump around the keys (104729 is prime)
+						if (writeEvery && i % writeEvery == 0) update(keys[k]);
+						else local += lookup(keys[k]);
+					}
+					sum += local;
+				});
+
+			for (std::thread& thread : pool) thread.join();
+			benchSink = sum.load();
+		}, 3));
+	}
+
+	typedef std::vector<std::pair<std::string, std::vector<int>>> SortInputs;
+
+	/// Inputs for the sort benchmarks: "count" ints that are random, sorted, reversed, or random with many duplicates (16 distinct values).
+	SortInputs makeSortInputs(size_t count)
+	{
+		std::mt19937 rng(42);
+		SortInputs inputs = { { "random", { } }, { "sorted", { } }, { "reversed", { } }, { "duplicates", { } } };
+		for (size_t i = 0; i < count; i++)
+		{
+			inputs[0].second.push_back((int)rng());
+			inputs[1].second.push_back((int)i);
+			inputs[2].second.push_back((int)(count - i));
+			inputs[3].second.push_back((int)(rng() % 16));
+		}
+
+		return inputs;
+	}
+
+	/// Sort each input with L::sort(). The list is refilled before each repetition.
+	template <typename L>
+	void benchListSort(const std::string& name, const SortInputs& inputs)
+	{
+		L list;
+		for (const auto& input : inputs)
+			printResult(name + "::sort, " + input.first, input.second.size(), bestTimeWithSetup([&]() {
+				list.clear();
+				for (int item : input.second) list.append(item);
+			}, [&]() {
+				list.sort();
+				benchSink = list.length();
+			}));
+	}
+
+	// -- Benchmarks --------------------------------------
+
+	void bench_DynamicArray()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		benchAppend<int>("int", 1000000, 7);
+		benchAppend<std::string>("std::string", 200000, std::string(32, 'x'));
+	}
+
+	void bench_GrowthPolicies()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = (1 << 17) + 1;   // Just past a power of two: worst case for DoublingGrowth
+		for (float shrink : { 0.25f, -1.f })
+		{
+			benchGrowthPolicy<DoublingGrowth>("DoublingGrowth", count, shrink);
+			benchGrowthPolicy<HalfGrowth>("HalfGrowth", count, shrink);
+			benchGrowthPolicy<PageGrowth>("PageGrowth", count, shrink);
+		}
+	}
+
+	void bench_Iteration()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000;
+		DynamicArray<int> array;
+		for (size_t i = 0; i < count; i++) array.append((int)((i * 7919) % count));
+		List<int>* list = &array;
+
+		printResult("Cursor (List<int>*) sum", count, bestTime([&]() {
+			size_t sum = 0;
+			for (list->moveToStart(); list->currPos() < list->length(); list->next())
+				sum += list->getValue();
+			benchSink = sum;
+		}));
+
+		printResult("Range-for sum", count, bestTime([&]() {
+			size_t sum = 0;
+			for (int x : array) sum += x;
+			benchSink = sum;
+		}));
+
+		printResult("std::accumulate", count, bestTime([&]() {
+			benchSink = std::accumulate(array.begin(), array.end(), size_t(0));
+		}));
+
+		printResult("std::sort", count, bestTime([&]() {
+			DynamicArray<int> copy(array);
+			std::sort(copy.begin(), copy.end());
+			benchSink = copy[0];
+		}));
+	}
+
+	void bench_Find()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 10000, rounds = 100;   // Searches for a missing item, so the whole list is traversed.
+		DynamicArray<int> array;
+		SinglyLinkedList<int> sll;
+		DoubleLinkedList<int> dll;
+		for (size_t i = 0; i < count; i++)
+		{
+			array.append((int)i);
+			sll.append((int)i);
+			dll.append((int)i);
+		}
+
+		auto search = [&](const std::string& name, auto& list) {
+			printResult(name, count * rounds, bestTime([&]() {
+				size_t sum = 0;
+				for (size_t i = 0; i < rounds; i++) sum += find(list, -1);
+				benchSink = sum;
+			}));
+		};
+
+		List<int>* arrayPtr = &array;
+		printResult("find(List<int>*), DynamicArray", count * rounds, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++) sum += find(arrayPtr, -1);
+			benchSink = sum;
+		}));
+		search("find(List<int>&), DynamicArray", static_cast<List<int>&>(array));
+		search("find(DynamicArray<int>&)", array);
+		List<int>* sllPtr = &sll;   // currPos() is O(1) in linked lists, so this is linear too
+		printResult("find(List<int>*), SinglyLinkedList", count * rounds, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < rounds; i++) sum += find(sllPtr, -1);
+			benchSink = sum;
+		}));
+		search("find(List<int>&), SinglyLinkedList", static_cast<List<int>&>(sll));
+		search("find(SinglyLinkedList<int>&)", sll);
+		search("find(List<int>&), DoubleLinkedList", static_cast<List<int>&>(dll));
+		search("find(DoubleLinkedList<int>&)", dll);
+
+		count = 1000000, rounds = 10;   // Arrays of arithmetic types (vectorized search)
+		benchFindContiguous<int8_t>("int8_t", count, rounds);
+		benchFindContiguous<int>("int", count, rounds);
+		benchFindContiguous<int64_t>("int64_t", count, rounds);
+		benchFindContiguous<double>("double", count, rounds);
+	}
+
+	void bench_NodeAllocators()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000;
+		benchNodeList<SinglyLinkedList, HeapAllocator>("SLL<int, HeapAllocator>", count);
+		benchNodeList<SinglyLinkedList, SlabArena>("SLL<int, SlabArena>", count);
+		benchNodeList<DoubleLinkedList, HeapAllocator>("DLL<int, HeapAllocator>", count);
+		benchNodeList<DoubleLinkedList, SlabArena>("DLL<int, SlabArena>", count);
+		benchNodeList<XorLinkedList, HeapAllocator>("XLL<int, HeapAllocator>", count);
+		benchNodeList<XorLinkedList, SlabArena>("XLL<int, SlabArena>", count);
+		benchNodeStackQueue<HeapAllocator>("Heap, cap 0", count, 0);   // Former behaviour: new/delete on each push/pop
+		benchNodeStackQueue<HeapAllocator>("Heap, cap 1024", count, 1024);
+		benchNodeStackQueue<SlabArena>("SlabArena", count, 1024);
+	}
+
+	void bench_UnrolledList()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000;
+		benchSequence<SinglyLinkedList<int>>("SLL<int>", count);
+		benchSequence<DoubleLinkedList<int>>("DLL<int>", count);
+		benchSequence<XorLinkedList<int>>("XLL<int>", count);
+		benchSequence<UnrolledLinkedList<int, 16>>("ULL<int, 16>", count);
+		benchSequence<UnrolledLinkedList<int, 32>>("ULL<int, 32>", count);
+		benchSequence<UnrolledLinkedList<int, 128>>("ULL<int, 128>", count);
+	}
+
+	void bench_SmallArray()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t rounds = 100000;
+		for (size_t elements : { 4, 16, 64 })
+		{
+			benchShortLived<DynamicArray<int>>("DynamicArray<int>", elements, rounds);
+			benchShortLived<SmallArray<int, 16>>("SmallArray<int, 16>", elements, rounds);
+			benchShortLived<std::vector<int>>("std::vector<int>", elements, rounds);
+		}
+	}
+
+	void bench_PositionIndex()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 100000, operations = 2000;
+		benchIndexedList<SinglyLinkedList<int>>("SLL<int>", count, operations, false);
+		benchIndexedList<SinglyLinkedList<int>>("SLL<int>, indexed", count, operations, true);
+		benchIndexedList<DoubleLinkedList<int>>("DLL<int>", count, operations, false);
+		benchIndexedList<DoubleLinkedList<int>>("DLL<int>, indexed", count, operations, true);
+		benchIndexedList<XorLinkedList<int>>("XLL<int>", count, operations, false);
+		benchIndexedList<XorLinkedList<int>>("XLL<int>, indexed", count, operations, true);
+
+		printResult("SLL<int> append", count, bestTime([&]() {
+			SinglyLinkedList<int> list;
+			for (size_t i = 0; i < count; i++) list.append((int)i);
+			benchSink = list.length();
+		}));
+		printResult("SLL<int>, indexed append", count, bestTime([&]() {
+			SinglyLinkedList<int> list;
+			list.enableIndex(true);
+			for (size_t i = 0; i < count; i++) list.append((int)i);
+			benchSink = list.length();
+		}));
+	}
+
+	void bench_Moves()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000, rounds = 10;
+		benchTransfer<DynamicArray<int>>("DynamicArray<int>", count, rounds);
+		benchTransfer<DoubleLinkedList<int>>("DLL<int>", count, rounds);
+		benchTransfer<UnrolledLinkedList<int>>("ULL<int>", count, rounds);
+
+		size_t operations = 100000;
+		benchStringStack<SArrayStack<std::string>>("SArrayStack<std::string>", operations);
+		benchStringStack<LinkedStack<std::string>>("LinkedStack<std::string>", operations);
+	}
+
+	void bench_Relink()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1 << 20, shards = 16;
+		benchRelink<DoubleLinkedList<int>>("DLL<int>", count, shards);
+		benchRelink<XorLinkedList<int>>("XLL<int>", count, shards);
+	}
+
+	void bench_Queues()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000, backlog = 1000;
+		benchQueue<SArrayQueue<int>>("SArrayQueue<int>", count, backlog);
+		benchQueue<DArrayQueue<int>>("DArrayQueue<int>", count, backlog);
+		benchQueue<LinkedQueue<int>>("LinkedQueue<int>", count, backlog);
+
+		std::deque<int> deque;
+		printResult("std::deque<int> burst push, pop", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) deque.push_back((int)i);
+			for (size_t i = 0; i < count; i++) { sum += deque.front(); deque.pop_front(); }
+			benchSink = sum;
+		}));
+
+		printResult("DArrayQueue<int> burst, no reserve", count, bestTime([&]() {
+			DArrayQueue<int> queue;   // Starts empty: capacity doubles up to 2^20 during the burst
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i++) queue.enqueue((int)i);
+			for (size_t i = 0; i < count; i++) sum += queue.dequeue();
+			benchSink = sum;
+		}));
+
+		const size_t batch = 64;
+		std::vector<int> in(batch), out(batch);
+		std::iota(in.begin(), in.end(), 0);
+		DArrayQueue<int> queue(count);
+		printResult("DArrayQueue<int> burst, enqueueN/dequeueN", count, bestTime([&]() {
+			size_t sum = 0;
+			for (size_t i = 0; i < count; i += batch) queue.enqueueN(in.data(), batch);
+			for (size_t i = 0; i < count; i += batch)
+			{
+				queue.dequeueN(out.data(), batch);
+				sum += out[0];
+			}
+			benchSink = sum;
+		}));
+	}
+
+	void bench_SPSCQueue()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000, capacity = 1024, rounds = 100000;
+		benchHandoff<LockedQueue<int>>("mutex + SArrayQueue<int>", count, capacity);
+		benchHandoff<SPSCQueue<int>>("SPSCQueue<int>", count, capacity);
+
+		const size_t batch = 64;
+		printResult("SPSCQueue<int> batch transfer", count, bestTime([&]() {
+			SPSCQueue<int> queue(capacity);
+			std::thread producer([&]() {
+				std::vector<int> in(batch);
+				for (size_t i = 0; i < count; )
+				{
+					size_t n = std::min(batch, count - i);
+					for (size_t j = 0; j < n; j++) in[j] = (int)(i + j);
+					size_t sent = queue.enqueueN(in.data(), n);
+					if (!sent) std::this_thread::yield();
+					i += sent;
+				}
+			});
+
+			std::vector<int> out(batch);
+			size_t sum = 0;
+			for (size_t i = 0; i < count; )
+			{
+				size_t received = queue.dequeueN(out.data(), batch);
+				if (!received) std::this_thread::yield();
+				for (size_t j = 0; j < received; j++) sum += out[j];
+				i += received;
+			}
+
+			producer.join();
+			benchSink = sum;
+		}, 3));
+
+		benchPingPong<LockedQueue<int>>("mutex + SArrayQueue<int>", rounds);
+		benchPingPong<SPSCQueue<int>>("SPSCQueue<int>", rounds);
+	}
+
+	void bench_MPMCQueue()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		size_t count = 1000000, capacity = 1024;
+		for (size_t threads = 1; threads <= 64; threads *= 2)
+		{
+			benchWorkers<LockedQueue<int>>("mutex + SArrayQueue<int>", count, capacity, threads);
+			benchWorkers<MPMCQueue<int>>("MPMCQueue<int>", count, capacity, threads);
+		}
+	}
+
+	void bench_Dictionaries()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		std::mt19937 rng(42);
+		for (size_t count : { 1000, 10000, 1000000 })
+		{
+			std::vector<int> keys(count), absent(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				keys[i] = (int)(rng() & ~1u);   // Even keys present, odd keys absent
+				absent[i] = (int)(rng() | 1u);
+			}
+			std::sort(keys.begin(), keys.end());
+			keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+			std::shuffle(keys.begin(), keys.end(), rng);
+			absent.resize(keys.size());
+
+			std::string n = (count < 1000000 ? std::to_string(count / 1000) + "k" : std::to_string(count / 1000000) + "M");
+			if (count <= 10000)   // O(n) per operation
+			{
+				benchDictionary<StaticArrayDictionary<int, int>>("StaticArrayDictionary " + n, keys, absent);
+				benchDictionary<SoAArrayDictionary<int, int>>("SoAArrayDictionary " + n, keys, absent);
+			}
+			benchSortedDictionary("SortedDictionary " + n, keys, absent, count <= 10000);
+			benchFrozenDictionary("FrozenDictionary " + n, keys, absent);
+			benchDictionary<HashDictionary<int, int>>("HashDictionary " + n, keys, absent);
+
+			std::unordered_map<int, int> map;
+			printResult("std::unordered_map " + n + " insert", keys.size(), bestTime([&]() {
+				map.clear();
+				for (size_t i = 0; i < keys.size(); i++) map[keys[i]] = (int)i;
+				benchSink = map.size();
+			}, 3));
+			printResult("std::unordered_map " + n + " find (hit)", keys.size(), bestTime([&]() {
+				size_t sum = 0;
+				for (size_t i = 0; i < keys.size(); i++) sum += map.find(keys[i])->second;
+				benchSink = sum;
+			}, 3));
+		}
+	}
+
+	void bench_DictionaryLayouts()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		typedef std::array<char, 60> Record;   // KVpair<int, Record> takes one cache line
+		std::mt19937 rng(42);
+		for (size_t count : { 1000, 4000 })
+		{
+			std::vector<int> keys(count), absent(count);
+			std::vector<std::string> strings(count);
+			std::vector<Record> records(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				keys[i] = (int)(2 * i);   // Even keys present, odd keys absent
+				absent[i] = (int)(2 * i + 1);
+				strings[i] = std::string(40, (char)('a' + i % 26));   // Allocated on the heap
+				records[i].fill((char)i);
+			}
+			std::shuffle(keys.begin(), keys.end(), rng);
+			std::shuffle(absent.begin(), absent.end(), rng);
+
+			std::string n = std::to_string(count / 1000) + "k";
+			benchDictionaryLayout<StaticArrayDictionary<int, std::string>>("AoS <int, string> " + n, keys, absent, strings);
+			benchDictionaryLayout<SoAArrayDictionary<int, std::string>>("SoA <int, string> " + n, keys, absent, strings);
+			benchDictionaryLayout<StaticArrayDictionary<int, Record>>("AoS <int, char[60]> " + n, keys, absent, records);
+			benchDictionaryLayout<SoAArrayDictionary<int, Record>>("SoA <int, char[60]> " + n, keys, absent, records);
+		}
+	}
+
+	void bench_ConcurrentReads()
+	{
+		std::cout << __func__ << " (" << std::thread::hardware_concurrency() << " hardware threads):" << std::endl;
+
+		const size_t count = 1 << 21;
+		std::mt19937 rng(42);
+		std::vector<int> keys(1000000);
+		for (size_t i = 0; i < keys.size(); i++) keys[i] = (int)(2 * i);
+		std::shuffle(keys.begin(), keys.end(), rng);
+
+		HashDictionary<int, int> hash((int)keys.size());
+		RWLockedDictionary<int, int> rwLocked((int)keys.size());
+		MutexDictionary<HashDictionary<int, int>> mutexLocked((int)keys.size());
+		std::vector<KVpair<int, int>> pairs;
+		for (int k : keys)
+		{
+			hash.insert(k, k);
+			rwLocked.insert(k, k);
+			mutexLocked.insert(k, k);
+			pairs.push_back(KVpair<int, int>(k, k));
+		}
+		const FrozenDictionary<int, int> frozen(pairs.data(), pairs.data() + pairs.size());
+		const HashDictionary<int, int>& sharedHash = hash;
+
+		auto noUpdate = [](int) { };
+		auto rwGet = [&rwLocked](int k) { int e = 0; rwLocked.get(k, e); return (size_t)e; };
+		auto rwUpdate = [&rwLocked](int k) { rwLocked.insert(k, k); };
+		auto mutexGet = [&mutexLocked](int k) { int e = 0; mutexLocked.get(k, e); return (size_t)e; };
+		auto mutexUpdate = [&mutexLocked](int k) { mutexLocked.insert(k, k); };
+
+		for (size_t threads : { 1, 2, 4, 8 })
+		{
+			benchReaders("HashDictionary, no lock", keys, count, threads, 0, [&sharedHash](int k) { return (size_t)*sharedHash.find(k); }, noUpdate);
+			benchReaders("FrozenDictionary, no lock", keys, count, threads, 0, [&frozen](int k) { return (size_t)*frozen.find(k); }, noUpdate);
+			benchReaders("RWLockedDictionary", keys, count, threads, 0, rwGet, rwUpdate);
+			benchReaders("MutexDictionary", keys, count, threads, 0, mutexGet, mutexUpdate);
+			benchReaders("RWLockedDictionary, 5% writes", keys, count, threads, 20, rwGet, rwUpdate);
+			benchReaders("MutexDictionary, 5% writes", keys, count, threads, 20, mutexGet, mutexUpdate);
+		}
+	}
+
+	void bench_Sort()
+	{
+		std::cout << __func__ << ":" << std::endl;
+
+		SortInputs inputs = makeSortInputs(1 << 20);
+		std::vector<int> vector;
+		DynamicArray<int> array;
+
+		for (const auto& input : inputs)
+		{
+			size_t count = input.second.size();
+			auto fillVector = [&]() { vector = input.second; };
+			auto fillArray = [&]() { array.assign(input.second.data(), input.second.data() + count); };
+
+			printResult("std::sort(std::vector), " + input.first, count, bestTimeWithSetup(fillVector, [&]() {
+				std::sort(vector.begin(), vector.end());
+				benchSink = vector[0];
+			}));
+			printResult("DA<int>::sort, " + input.first, count, bestTimeWithSetup(fillArray, [&]() {
+				array.sort();
+				benchSink = array[0];
+			}));
+			printResult("DA<int>::parallelSort, " + input.first, count, bestTimeWithSetup(fillArray, [&]() {
+				array.parallelSort();
+				benchSink = array[0];
+			}));
+		}
+
+		std::list<int> stdList;
+		for (const auto& input : inputs)
+			printResult("std::list::sort, " + input.first, input.second.size(), bestTimeWithSetup([&]() {
+				stdList.assign(input.second.begin(), input.second.end());
+			}, [&]() {
+				stdList.sort();
+				benchSink = stdList.size();
+			}));
+
+		benchListSort<SinglyLinkedList<int>>("SLL<int>", inputs);
+		benchListSort<DoubleLinkedList<int>>("DLL<int>", inputs);
+		benchListSort<XorLinkedList<int>>("XLL<int>", inputs);
+		benchListSort<UnrolledLinkedList<int>>("ULL<int>", inputs);
+	}
+}
@@ -1,13 +1,19 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include <string>
 
 #include "lists.hpp"
+#include "benchmarks.hpp"
 
 using namespace dss;
 
-int main()
+int main(int argc, char* argv[])
 {
+	bool benchmarks = false;   // Benchmarks take a while: run them only with --bench
+	for (int i = 1; i < argc; i++)
+		if (std::string(argv[i]) == "--bench") benchmarks = true;
+
 	try
 	{
 		std::cout << "Tests: Data structures" << std::endl;
@@ -15,15 +21,38 @@ int main()
 		std::cout << "  - Sequences" << std::endl;
 		test_List<StaticArray>();
 		test_List<DynamicArray>();
+		test_List<SmallArray>();
 		test_List<SinglyLinkedList>();
 		test_List<DoubleLinkedList>();
 		test_List<XorLinkedList>();
-		//test_SortedList<SortedStaticArray>();
+		test_List<UnrolledLinkedList>();
+		test_DynamicArray<DynamicArray>();
+		test_DynamicArray<SmallArray>();
+		test_LinkedList<SinglyLinkedList>();
+		test_LinkedList<DoubleLinkedList>();
+		test_LinkedList<XorLinkedList>();
+		test_SortedList<SortedStaticArray>();
 		test_Stack<SArrayStack>();
 		test_Stack<LinkedStack>();
+		test_Stack<DArrayStack>();
+		test_DArrayStack<DArrayStack>();
+		test_LinkedStack<LinkedStack>();
+		test_DoubleSArrayStack<DoubleSArrayStack>();
 		test_Queue<SArrayQueue>();
 		test_Queue<LinkedQueue>();
+		test_Queue<DArrayQueue>();
+		test_DArrayQueue<DArrayQueue>();
+		test_LinkedQueue<LinkedQueue>();
+		test_SPSCQueue<SPSCQueue>();
+		test_MPMCQueue<MPMCQueue>();
 		test_Dictionary<StaticArrayDictionary>();
+		test_Dictionary<SoAArrayDictionary>();
+		test_Dictionary<HashDictionary>();
+		test_HashDictionary<HashDictionary>();
+		test_Dictionary<SortedStaticArrayDictionary>();
+		test_SortedDictionary<SortedStaticArrayDictionary>();
+		test_FrozenDictionary<FrozenDictionary>();
+		test_RWLockedDictionary<RWLockedDictionary>();
 
 		std::cout << "  - Binary trees" << std::endl;
 		std::cout << "  - Non-binary trees" << std::endl;
@@ -33,6 +62,28 @@ int main()
 		std::cout << "  - Searching" << std::endl;
 		std::cout << "  - Indexing" << std::endl;
 		std::cout << "  - Graphs" << std::endl;
+
+		if (benchmarks)
+		{
+			std::cout << "Benchmarks: Data structures" << std::endl;
+			bench_DynamicArray();
+			bench_GrowthPolicies();
+			bench_Iteration();
+			bench_Find();
+			bench_NodeAllocators();
+			bench_UnrolledList();
+			bench_SmallArray();
+			bench_PositionIndex();
+			bench_Moves();
+			bench_Relink();
+			bench_Sort();
+			bench_Queues();
+			bench_SPSCQueue();
+			bench_MPMCQueue();
+			bench_Dictionaries();
+			bench_DictionaryLayouts();
+			bench_ConcurrentReads();
+		}
 	}
 	catch (std::exception& e) {
 		std::cout << "\nError: " << e.what() << std::endl;